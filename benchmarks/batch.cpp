@@ -0,0 +1,237 @@
+#include <vector>
+#include <string>
+#include <sstream>
+#include <benchmark/benchmark.h>
+#include "time/batch.hpp"
+#include "time/calendar.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+
+/// A day of 100 Hz sample times.
+std::vector<int64_t> createSampleTimes()
+{
+    std::vector<int64_t> epochs(8640000);
+    for (size_t i = 0; i < epochs.size(); ++i)
+    {
+        epochs[i] = 1577836800000000000 + static_cast<int64_t> (i)*10000000;
+    }
+    return epochs;
+}
+
+void batchToCalendar(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    auto n = epochs.size();
+    std::vector<int32_t> year(n), dayOfYear(n), month(n), dayOfMonth(n),
+                         hour(n), minute(n), second(n), nanoSecond(n);
+    Time::Batch::CalendarColumns calendar{year, dayOfYear, month, dayOfMonth,
+                                          hour, minute, second, nanoSecond};
+    for (auto _ : state)
+    {
+        Time::Batch::toCalendar(epochs, calendar);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (n));
+}
+
+void utcToCalendar(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    auto n = epochs.size();
+    std::vector<int32_t> year(n), dayOfYear(n), month(n), dayOfMonth(n),
+                         hour(n), minute(n), second(n), nanoSecond(n);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            Time::UTC time{std::chrono::nanoseconds {epochs[i]}};
+            year[i] = time.getYear();
+            dayOfYear[i] = time.getDayOfYear();
+            month[i] = time.getMonth();
+            dayOfMonth[i] = time.getDayOfMonth();
+            hour[i] = time.getHour();
+            minute[i] = time.getMinute();
+            second[i] = time.getSecond();
+            nanoSecond[i] = time.getNanoSecond();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (n));
+}
+
+void batchFromMonthAndDay(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    auto n = epochs.size();
+    std::vector<int32_t> year(n), dayOfYear(n), month(n), dayOfMonth(n),
+                         hour(n), minute(n), second(n), nanoSecond(n);
+    Time::Batch::toCalendar(epochs, Time::Batch::CalendarColumns{
+                            year, dayOfYear, month, dayOfMonth,
+                            hour, minute, second, nanoSecond});
+    Time::Batch::ConstCalendarColumns calendar{year, dayOfYear, month,
+                                               dayOfMonth, hour, minute,
+                                               second, {}, nanoSecond};
+    std::vector<uint8_t> invalid(n);
+    for (auto _ : state)
+    {
+        auto nInvalid = Time::Batch::fromMonthAndDay(calendar, epochs, invalid);
+        benchmark::DoNotOptimize(nInvalid);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (n));
+}
+
+void utcFromMonthAndDay(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    auto n = epochs.size();
+    std::vector<int32_t> year(n), dayOfYear(n), month(n), dayOfMonth(n),
+                         hour(n), minute(n), second(n), nanoSecond(n);
+    Time::Batch::toCalendar(epochs, Time::Batch::CalendarColumns{
+                            year, dayOfYear, month, dayOfMonth,
+                            hour, minute, second, nanoSecond});
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            Time::UTC time;
+            time.setYear(year[i]);
+            time.setMonthAndDay(std::pair(month[i], dayOfMonth[i]));
+            time.setHour(hour[i]);
+            time.setMinute(minute[i]);
+            time.setSecond(second[i]);
+            time.setNanoSecond(nanoSecond[i]);
+            epochs[i] = time.getEpochInNanoSeconds().count();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (n));
+}
+
+void batchFromStrings(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    epochs.resize(100000);
+    auto n = epochs.size();
+    std::vector<std::string> strings(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::ostringstream stream;
+        stream << Time::UTC{std::chrono::nanoseconds {epochs[i]}};
+        strings[i] = stream.str();
+    }
+    std::vector<std::string_view> times(strings.begin(), strings.end());
+    std::vector<uint8_t> invalid(n);
+    for (auto _ : state)
+    {
+        auto nInvalid = Time::Batch::fromStrings(times, epochs, invalid);
+        benchmark::DoNotOptimize(nInvalid);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (n));
+}
+
+void batchToColumn(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    epochs.resize(100000);
+    std::vector<char> buffer(27*epochs.size());
+    for (auto _ : state)
+    {
+        auto nWritten = Time::Batch::toColumn(epochs, '\n', buffer);
+        benchmark::DoNotOptimize(nWritten);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (epochs.size()));
+}
+
+void batchFloorToMinute(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    std::vector<int64_t> result(epochs.size());
+    for (auto _ : state)
+    {
+        Time::Batch::floor(epochs, std::chrono::minutes {1}, result);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (epochs.size()));
+}
+
+void scalarFloorToMinute(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    std::vector<int64_t> result(epochs.size());
+    constexpr int64_t period{60000000000};
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < epochs.size(); ++i)
+        {
+            result[i] = Time::Calendar::floorDivide(epochs[i], period)*period;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (epochs.size()));
+}
+
+void batchFloorToMonth(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    std::vector<int64_t> result(epochs.size());
+    for (auto _ : state)
+    {
+        Time::Batch::floor(epochs, Time::Batch::CalendarPeriod::Month, result);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (epochs.size()));
+}
+
+void utcFloorToMonth(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    std::vector<int64_t> result(epochs.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < epochs.size(); ++i)
+        {
+            Time::UTC time{std::chrono::nanoseconds {epochs[i]}};
+            result[i] = Time::Calendar::toEpoch(time.getYear(),
+                                                time.getMonth(),
+                                                1, 0, 0, 0, 0);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (epochs.size()));
+}
+
+void batchGroupByMinute(benchmark::State &state)
+{
+    auto epochs = createSampleTimes();
+    for (auto _ : state)
+    {
+        auto groups = Time::Batch::groupBy(epochs, std::chrono::minutes {1});
+        benchmark::DoNotOptimize(groups.data());
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (epochs.size()));
+}
+
+}
+
+BENCHMARK(batchToCalendar)->Unit(benchmark::kMillisecond);
+BENCHMARK(utcToCalendar)->Unit(benchmark::kMillisecond);
+BENCHMARK(batchFromMonthAndDay)->Unit(benchmark::kMillisecond);
+BENCHMARK(utcFromMonthAndDay)->Unit(benchmark::kMillisecond);
+BENCHMARK(batchFromStrings)->Unit(benchmark::kMicrosecond);
+BENCHMARK(batchToColumn)->Unit(benchmark::kMicrosecond);
+BENCHMARK(batchFloorToMinute)->Unit(benchmark::kMillisecond);
+BENCHMARK(scalarFloorToMinute)->Unit(benchmark::kMillisecond);
+BENCHMARK(batchFloorToMonth)->Unit(benchmark::kMillisecond);
+BENCHMARK(utcFloorToMonth)->Unit(benchmark::kMillisecond);
+BENCHMARK(batchGroupByMinute)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,86 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <benchmark/benchmark.h>
+#include "time/boundaries.hpp"
+#include "time/calendar.hpp"
+#include "time/sds.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+
+const int64_t startTime{Time::Calendar::toEpoch(2000, 1, 1, 12, 0, 0, 0)};
+const int64_t endTime{Time::Calendar::toEpoch(2025, 1, 1, 12, 0, 0, 0)};
+
+/// The SDS day files spanned by 25 years.
+void boundaryRangeSDSPaths(benchmark::State &state)
+{
+    std::array<char, Time::SDS::MAXIMUM_PATH_LENGTH> path;
+    int64_t nDays{0};
+    for (auto _ : state)
+    {
+        nDays = 0;
+        for (const auto &day : Time::BoundaryRange(startTime, endTime,
+                                                   Time::BoundaryPeriod::Day))
+        {
+            auto length = Time::SDS::formatPath("UU", "CTU", "01", "HHZ",
+                                                day, path);
+            benchmark::DoNotOptimize(length);
+            benchmark::ClobberMemory();
+            nDays = nDays + 1;
+        }
+    }
+    state.SetItemsProcessed(state.iterations()*nDays);
+}
+
+/// The same paths by stepping a UTC a day at a time.
+void utcSDSPaths(benchmark::State &state)
+{
+    Time::UTC end{std::chrono::nanoseconds {endTime}};
+    int64_t nDays{0};
+    for (auto _ : state)
+    {
+        nDays = 0;
+        Time::UTC day{std::chrono::nanoseconds {startTime}};
+        day.setHour(0);
+        day.setMinute(0);
+        day.setSecond(0);
+        day.setNanoSecond(0);
+        for ( ; day < end; day += std::chrono::days {1})
+        {
+            auto year = std::to_string(day.getYear());
+            char dayOfYear[4];
+            std::snprintf(dayOfYear, sizeof(dayOfYear), "%03d",
+                          day.getDayOfYear());
+            auto path = year + "/UU/CTU/HHZ.D/UU.CTU.01.HHZ.D." + year
+                      + "." + dayOfYear;
+            benchmark::DoNotOptimize(path.data());
+            nDays = nDays + 1;
+        }
+    }
+    state.SetItemsProcessed(state.iterations()*nDays);
+}
+
+/// Where a 1 s, 100 Hz packet crosses midnight.
+void findBoundarySample(benchmark::State &state)
+{
+    Time::SamplingPeriod period{10000000};
+    auto midnight = Time::Calendar::toEpoch(2023, 6, 1, 0, 0, 0, 0);
+    int64_t offset{0};
+    for (auto _ : state)
+    {
+        auto index = Time::findBoundarySample(midnight - offset, period, 100,
+                                              Time::BoundaryPeriod::Day);
+        benchmark::DoNotOptimize(index);
+        offset = (offset + 1234567)%1000000000;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+BENCHMARK(boundaryRangeSDSPaths)->Unit(benchmark::kMicrosecond);
+BENCHMARK(utcSDSPaths)->Unit(benchmark::kMicrosecond);
+BENCHMARK(findBoundarySample);
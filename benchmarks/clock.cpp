@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include "time/clock.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+
+/// @result False indicates the source is not available.
+bool setSource(benchmark::State &state)
+{
+    auto source = static_cast<Time::Clock::Source> (state.range(0));
+    if (source == Time::Clock::Source::TSC && !Time::Clock::isTSCAvailable())
+    {
+        state.SkipWithError("An invariant TSC is not available");
+        return false;
+    }
+    Time::Clock::setSource(source);
+    switch (source)
+    {
+        case Time::Clock::Source::CoarseRealtime:
+            state.SetLabel("coarse realtime");
+            break;
+        case Time::Clock::Source::TSC:
+            state.SetLabel("tsc");
+            break;
+        default:
+            state.SetLabel("realtime");
+    }
+    return true;
+}
+
+/// Time stamps without creating a UTC.
+void nowEpoch(benchmark::State &state)
+{
+    if (!setSource(state)){return;}
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Time::UTC::nowEpoch());
+    }
+    Time::Clock::setSource(Time::Clock::Source::Realtime);
+}
+
+void now(benchmark::State &state)
+{
+    if (!setSource(state)){return;}
+    Time::UTC time;
+    for (auto _ : state)
+    {
+        time.now();
+        benchmark::DoNotOptimize(time);
+    }
+    Time::Clock::setSource(Time::Clock::Source::Realtime);
+}
+
+}
+
+BENCHMARK(nowEpoch)->ArgName("source")->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(now)->ArgName("source")->Arg(0)->Arg(1)->Arg(2);
@@ -0,0 +1,58 @@
+#include <filesystem>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "time/epochFile.hpp"
+
+namespace
+{
+
+/// A day of 1 s packet times from 100 stations, i.e., 8.64M times.
+std::filesystem::path createFile()
+{
+    auto fileName = std::filesystem::temp_directory_path()
+                  / "timeBenchmarksEpochFile.bin";
+    Time::EpochFileWriter writer(fileName);
+    std::vector<int64_t> epochs(100);
+    for (int64_t second = 0; second < 86400; ++second)
+    {
+        for (int64_t i = 0; i < 100; ++i)
+        {
+            epochs[static_cast<size_t> (i)]
+                = 1577836800000000000 + second*1000000000 + i*10000;
+        }
+        writer.append(epochs);
+    }
+    writer.close();
+    return fileName;
+}
+
+/// Finds the packets in a random minute of the day.
+void findMinute(benchmark::State &state)
+{
+    // The mapping outlives the removed file
+    static const auto reader = []()
+    {
+        auto fileName = createFile();
+        Time::EpochFileReader result(fileName);
+        std::filesystem::remove(fileName);
+        return result;
+    }();
+    std::mt19937 generator(2);
+    std::uniform_int_distribution<int64_t> minutes(0, 1439);
+    int64_t nTimes{0};
+    for (auto _ : state)
+    {
+        auto t0 = 1577836800000000000 + minutes(generator)*60000000000;
+        auto result = reader.find(t0, t0 + 60000000000);
+        benchmark::DoNotOptimize(result.data());
+        nTimes = nTimes + static_cast<int64_t> (result.size());
+    }
+    state.counters["times/query"]
+        = benchmark::Counter(static_cast<double> (nTimes)
+                            /static_cast<double> (state.iterations()));
+}
+
+}
+
+BENCHMARK(findMinute);
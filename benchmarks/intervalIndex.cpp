@@ -0,0 +1,106 @@
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "time/intervalIndex.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+
+constexpr int64_t START_TIME{1577836800000000000};
+constexpr int64_t DAY{86400000000000};
+constexpr int N_EPOCHS{1000};
+
+/// Consecutive day-long channel epochs.
+std::vector<Time::IntervalIndex::Interval> createEpochs()
+{
+    std::vector<Time::IntervalIndex::Interval> epochs(N_EPOCHS);
+    for (int i = 0; i < N_EPOCHS; ++i)
+    {
+        epochs[i].start = START_TIME + i*DAY;
+        epochs[i].end = START_TIME + (i + 1)*DAY;
+    }
+    return epochs;
+}
+
+/// Sorted packet times, about one a second.
+std::vector<int64_t> createPacketTimes()
+{
+    std::vector<int64_t> times(1000000);
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        times[i] = START_TIME + static_cast<int64_t> (i)*N_EPOCHS*(DAY/1000000);
+    }
+    return times;
+}
+
+/// The active epoch by a linear scan over UTC windows.
+void linearScan(benchmark::State &state)
+{
+    auto epochs = createEpochs();
+    std::vector<std::pair<Time::UTC, Time::UTC>> windows;
+    for (const auto &epoch : epochs)
+    {
+        windows.emplace_back(Time::UTC {std::chrono::nanoseconds {epoch.start}},
+                             Time::UTC {std::chrono::nanoseconds {epoch.end}});
+    }
+    // The scan is slow so use every 100'th packet
+    std::vector<int64_t> times;
+    auto packetTimes = createPacketTimes();
+    for (size_t i = 0; i < packetTimes.size(); i = i + 100)
+    {
+        times.push_back(packetTimes[i]);
+    }
+    for (auto _ : state)
+    {
+        for (const auto &t : times)
+        {
+            Time::UTC time{std::chrono::nanoseconds {t}};
+            int64_t active{-1};
+            for (size_t i = 0; i < windows.size(); ++i)
+            {
+                if (!(time < windows[i].first) && time < windows[i].second)
+                {
+                    active = static_cast<int64_t> (i);
+                    break;
+                }
+            }
+            benchmark::DoNotOptimize(active);
+        }
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (times.size()));
+}
+
+void stab(benchmark::State &state)
+{
+    auto epochs = createEpochs();
+    Time::IntervalIndex index{epochs};
+    auto times = createPacketTimes();
+    for (auto _ : state)
+    {
+        for (const auto &time : times)
+        {
+            benchmark::DoNotOptimize(index.stab(time));
+        }
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (times.size()));
+}
+
+void batchStab(benchmark::State &state)
+{
+    auto epochs = createEpochs();
+    Time::IntervalIndex index{epochs};
+    auto times = createPacketTimes();
+    std::vector<int64_t> identifiers(times.size());
+    for (auto _ : state)
+    {
+        index.stab(times, identifiers);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (times.size()));
+}
+
+}
+
+BENCHMARK(linearScan);
+BENCHMARK(stab);
+BENCHMARK(batchStab);
@@ -0,0 +1,63 @@
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "time/leapSeconds.hpp"
+
+namespace
+{
+
+/// A day of 100 Hz GPS sample times.
+std::vector<int64_t> createGPSTimes()
+{
+    std::vector<int64_t> times(8640000);
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        times[i] = 1261872018000000000 + static_cast<int64_t> (i)*10000000;
+    }
+    return times;
+}
+
+void gpsToUTC(benchmark::State &state)
+{
+    auto gps = createGPSTimes();
+    Time::LeapSeconds leapSeconds;
+    for (auto _ : state)
+    {
+        for (const auto &time : gps)
+        {
+            benchmark::DoNotOptimize(leapSeconds.gpsToUTC(time));
+        }
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (gps.size()));
+}
+
+void batchGPSToUTC(benchmark::State &state)
+{
+    auto gps = createGPSTimes();
+    std::vector<int64_t> utc(gps.size());
+    Time::LeapSeconds leapSeconds;
+    for (auto _ : state)
+    {
+        leapSeconds.gpsToUTC(gps, utc);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (gps.size()));
+}
+
+void batchUTCToTAI(benchmark::State &state)
+{
+    auto utc = createGPSTimes();
+    std::vector<int64_t> tai(utc.size());
+    Time::LeapSeconds leapSeconds;
+    for (auto _ : state)
+    {
+        leapSeconds.utcToTAI(utc, tai);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (utc.size()));
+}
+
+}
+
+BENCHMARK(gpsToUTC);
+BENCHMARK(batchGPSToUTC);
+BENCHMARK(batchUTCToTAI);
@@ -0,0 +1,130 @@
+#include <bit>
+#include <cstring>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "time/sac.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+
+constexpr size_t N_HEADERS{100000};
+constexpr auto NUMBER_OF_MARKERS = Time::SAC::NUMBER_OF_MARKERS;
+constexpr auto HEADER_LENGTH = Time::SAC::HEADER_LENGTH;
+
+/// Little-endian headers with a reference time, b, e, and t0.
+std::vector<std::byte> createHeaders()
+{
+    std::vector<std::byte> headers(N_HEADERS*HEADER_LENGTH);
+    for (size_t i = 0; i < N_HEADERS; ++i)
+    {
+        auto *header = headers.data() + i*HEADER_LENGTH;
+        auto putFloat = [header](const size_t word, const float value)
+        {
+            std::memcpy(header + 4*word, &value, sizeof(float));
+        };
+        auto putInteger = [header](const size_t word, const int32_t value)
+        {
+            std::memcpy(header + 4*word, &value, sizeof(int32_t));
+        };
+        for (size_t word = 0; word < 70; ++word)
+        {
+            putFloat(word, Time::SAC::UNDEFINED_FLOAT);
+        }
+        putInteger(70, 2000 + static_cast<int32_t> (i%25));
+        putInteger(71, 1 + static_cast<int32_t> (i%365));
+        putInteger(72, static_cast<int32_t> (i%24));
+        putInteger(73, static_cast<int32_t> (i%60));
+        putInteger(74, static_cast<int32_t> ((i/60)%60));
+        putInteger(75, static_cast<int32_t> (i%1000));
+        putFloat(5, -60.0f);
+        putFloat(6, 240.0f);
+        putFloat(10, 12.345f);
+    }
+    return headers;
+}
+
+void sacGetTimes(benchmark::State &state)
+{
+    auto headers = createHeaders();
+    std::vector<int64_t> referenceTimes(N_HEADERS);
+    std::vector<int64_t> markerTimes(N_HEADERS*NUMBER_OF_MARKERS);
+    std::vector<uint8_t> invalid(N_HEADERS);
+    for (auto _ : state)
+    {
+        auto nInvalid = Time::SAC::getTimes(headers, referenceTimes,
+                                            markerTimes, invalid);
+        benchmark::DoNotOptimize(nInvalid);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (N_HEADERS));
+}
+
+/// The same conversion with the UTC setters and double offsets.
+void utcGetTimes(benchmark::State &state)
+{
+    auto headers = createHeaders();
+    std::vector<int64_t> referenceTimes(N_HEADERS);
+    std::vector<int64_t> markerTimes(N_HEADERS*NUMBER_OF_MARKERS);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < N_HEADERS; ++i)
+        {
+            const auto *header = headers.data() + i*HEADER_LENGTH;
+            auto getInteger = [header](const size_t word)
+            {
+                int32_t value;
+                std::memcpy(&value, header + 4*word, sizeof(int32_t));
+                return value;
+            };
+            Time::UTC time;
+            time.setYear(getInteger(70));
+            time.setDayOfYear(getInteger(71));
+            time.setHour(getInteger(72));
+            time.setMinute(getInteger(73));
+            time.setSecond(getInteger(74));
+            time.setMicroSecond(getInteger(75)*1000);
+            referenceTimes[i] = time.getEpochInNanoSeconds().count();
+            for (size_t j = 0; j < NUMBER_OF_MARKERS; ++j)
+            {
+                constexpr size_t words[]{5, 6, 7, 8, 10, 11, 12, 13, 14,
+                                         15, 16, 17, 18, 19, 20};
+                float offset;
+                std::memcpy(&offset, header + 4*words[j], sizeof(float));
+                markerTimes[i*NUMBER_OF_MARKERS + j]
+                    = offset == Time::SAC::UNDEFINED_FLOAT ?
+                      Time::SAC::UNDEFINED_TIME :
+                      (time + static_cast<double> (offset))
+                      .getEpochInNanoSeconds().count();
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (N_HEADERS));
+}
+
+void sacSetTimes(benchmark::State &state)
+{
+    auto headers = createHeaders();
+    std::vector<int64_t> referenceTimes(N_HEADERS);
+    std::vector<int64_t> markerTimes(N_HEADERS*NUMBER_OF_MARKERS);
+    std::vector<uint8_t> invalid(N_HEADERS);
+    Time::SAC::getTimes(headers, referenceTimes, markerTimes, invalid);
+    for (auto _ : state)
+    {
+        auto nInvalid = Time::SAC::setTimes(referenceTimes, markerTimes,
+                                            headers, invalid);
+        benchmark::DoNotOptimize(nInvalid);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()
+                           *static_cast<int64_t> (N_HEADERS));
+}
+
+}
+
+BENCHMARK(sacGetTimes)->Unit(benchmark::kMillisecond);
+BENCHMARK(utcGetTimes)->Unit(benchmark::kMillisecond);
+BENCHMARK(sacSetTimes)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,60 @@
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "time/sampleAxis.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+
+constexpr int64_t START_TIME{1577836800000000000};
+constexpr size_t N_SAMPLES{8640000};
+
+/// A day of 100 Hz sample times.
+void generate(benchmark::State &state)
+{
+    std::vector<int64_t> times(N_SAMPLES);
+    auto period = Time::SamplingPeriod::fromSamplingRate(state.range(0));
+    for (auto _ : state)
+    {
+        Time::SampleAxis::generate(START_TIME, period, times);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (N_SAMPLES));
+}
+
+/// The same day by repeatedly adding the sampling period to a UTC.
+void utcAddition(benchmark::State &state)
+{
+    std::vector<int64_t> times(N_SAMPLES);
+    for (auto _ : state)
+    {
+        Time::UTC time{std::chrono::nanoseconds {START_TIME}};
+        for (auto &t : times)
+        {
+            t = time.getEpochInNanoSeconds().count();
+            time = time + 0.01;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (N_SAMPLES));
+}
+
+void toNearestIndices(benchmark::State &state)
+{
+    std::vector<int64_t> times(N_SAMPLES);
+    std::vector<int64_t> indices(N_SAMPLES);
+    auto period = Time::SamplingPeriod::fromSamplingRate(state.range(0));
+    Time::SampleAxis::generate(START_TIME + 1234, period, times);
+    for (auto _ : state)
+    {
+        Time::SampleAxis::toNearestIndices(START_TIME, period, times, indices);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (N_SAMPLES));
+}
+
+}
+
+BENCHMARK(generate)->ArgName("rate")->Arg(100)->Arg(3);
+BENCHMARK(utcAddition);
+BENCHMARK(toNearestIndices)->ArgName("rate")->Arg(100)->Arg(3);
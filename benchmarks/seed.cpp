@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "time/seed.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+
+constexpr size_t RECORD_LENGTH{512};
+
+uint32_t getUInt16(const std::byte *buffer)
+{
+    return (std::to_integer<uint32_t> (buffer[0]) << 8)
+          | std::to_integer<uint32_t> (buffer[1]);
+}
+
+/// A day of 512 byte records each holding 4 s of data.
+std::vector<std::byte> createRecords()
+{
+    constexpr size_t nRecords{21600};
+    std::vector<std::byte> records(nRecords*RECORD_LENGTH, std::byte {0});
+    for (size_t i = 0; i < nRecords; ++i)
+    {
+        auto *btime = records.data() + i*RECORD_LENGTH
+                    + Time::SEED::START_TIME_OFFSET;
+        auto seconds = static_cast<int> (i*4);
+        btime[0] = std::byte {0x07};  // 2024
+        btime[1] = std::byte {0xE8};
+        btime[2] = std::byte {0x00};
+        btime[3] = std::byte {0x2D};  // Day 45
+        btime[4] = static_cast<std::byte> (seconds/3600);
+        btime[5] = static_cast<std::byte> ((seconds/60)%60);
+        btime[6] = static_cast<std::byte> (seconds%60);
+        btime[8] = static_cast<std::byte> (((i*37)%10000) >> 8);
+        btime[9] = static_cast<std::byte> (((i*37)%10000) & 0xFF);
+    }
+    return records;
+}
+
+void getRecordStartTimes(benchmark::State &state)
+{
+    auto records = createRecords();
+    auto n = records.size()/RECORD_LENGTH;
+    std::vector<int64_t> startTimes(n);
+    std::vector<uint8_t> invalid(n);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            Time::SEED::getRecordStartTimes(records, RECORD_LENGTH,
+                                            startTimes, invalid));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (n));
+}
+
+/// The unpack then set the calendar fields of a UTC approach.
+void utcRecordStartTimes(benchmark::State &state)
+{
+    auto records = createRecords();
+    auto n = records.size()/RECORD_LENGTH;
+    std::vector<int64_t> startTimes(n);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const auto *btime = records.data() + i*RECORD_LENGTH
+                              + Time::SEED::START_TIME_OFFSET;
+            Time::UTC time;
+            time.setYear(static_cast<int> (getUInt16(btime)));
+            time.setDayOfYear(static_cast<int> (getUInt16(btime + 2)));
+            time.setHour(std::to_integer<int> (btime[4]));
+            time.setMinute(std::to_integer<int> (btime[5]));
+            time.setSecond(std::to_integer<int> (btime[6]));
+            time.setMicroSecond(static_cast<int> (getUInt16(btime + 8))*100);
+            startTimes[i] = time.getEpochInNanoSeconds().count();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations()*static_cast<int64_t> (n));
+}
+
+}
+
+BENCHMARK(getRecordStartTimes);
+BENCHMARK(utcRecordStartTimes);
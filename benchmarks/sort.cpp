@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "time/sort.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+
+/// The size of a pick table.
+constexpr size_t N_PICKS{4000000};
+
+/// Pick times from a decade of a network shuffled as they would be after,
+/// e.g., merging the tables of several stations.
+std::vector<std::pair<int64_t, int64_t>> createPicks()
+{
+    std::mt19937_64 generator{5150};
+    std::uniform_int_distribution<int64_t>
+        distribution{1577836800000000000,
+                     1577836800000000000 + 10LL*365*86400000000000};
+    std::vector<std::pair<int64_t, int64_t>> picks(N_PICKS);
+    for (size_t i = 0; i < picks.size(); ++i)
+    {
+        picks[i] = std::pair{distribution(generator),
+                             static_cast<int64_t> (i)};
+    }
+    return picks;
+}
+
+void stdSortPicks(benchmark::State &state)
+{
+    const auto picks = createPicks();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto work = picks;
+        state.ResumeTiming();
+        std::stable_sort(work.begin(), work.end(),
+                         [](const auto &lhs, const auto &rhs)
+                         {
+                             return lhs.first < rhs.first;
+                         });
+        benchmark::DoNotOptimize(work.data());
+    }
+    state.SetItemsProcessed(state.iterations()*picks.size());
+}
+
+void radixSortPicks(benchmark::State &state)
+{
+    const auto picks = createPicks();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto work = picks;
+        state.ResumeTiming();
+        Time::Sort::sort(std::span {work});
+        benchmark::DoNotOptimize(work.data());
+    }
+    state.SetItemsProcessed(state.iterations()*picks.size());
+}
+
+void stdSortUTC(benchmark::State &state)
+{
+    std::vector<Time::UTC> times;
+    for (const auto &pick : createPicks())
+    {
+        times.push_back(Time::UTC{std::chrono::nanoseconds {pick.first}});
+    }
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto work = times;
+        state.ResumeTiming();
+        std::sort(work.begin(), work.end());
+        benchmark::DoNotOptimize(work.data());
+    }
+    state.SetItemsProcessed(state.iterations()*times.size());
+}
+
+void radixSortUTC(benchmark::State &state)
+{
+    std::vector<Time::UTC> times;
+    for (const auto &pick : createPicks())
+    {
+        times.push_back(Time::UTC{std::chrono::nanoseconds {pick.first}});
+    }
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto work = times;
+        state.ResumeTiming();
+        Time::Sort::sort(work);
+        benchmark::DoNotOptimize(work.data());
+    }
+    state.SetItemsProcessed(state.iterations()*times.size());
+}
+
+}
+
+BENCHMARK(stdSortPicks)->Unit(benchmark::kMillisecond);
+BENCHMARK(radixSortPicks)->Unit(benchmark::kMillisecond);
+BENCHMARK(stdSortUTC)->Unit(benchmark::kMillisecond);
+BENCHMARK(radixSortUTC)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,429 @@
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "time/dayCache.hpp"
+#include "time/utc.hpp"
+
+namespace
+{
+std::atomic<int64_t> nAllocations{0};
+}
+
+/// Count the heap allocations so that each benchmark can report
+/// allocations/op.  The replacements are not inlined so that GCC does not
+/// see the malloc and free through the new and delete of a caller, which
+/// it reports as mismatched.
+[[gnu::noinline]] void *operator new(std::size_t size)
+{
+    nAllocations.fetch_add(1, std::memory_order_relaxed);
+    auto result = std::malloc(size == 0 ? 1 : size);
+    if (result == nullptr){throw std::bad_alloc();}
+    return result;
+}
+
+[[gnu::noinline]] void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete(void *pointer, std::size_t) noexcept
+{
+    ::operator delete(pointer);
+}
+
+namespace
+{
+
+void setAllocationCounter(benchmark::State &state, const int64_t nAllocationsStart)
+{
+    auto nAllocationsEnd = nAllocations.load(std::memory_order_relaxed);
+    state.counters["allocations/op"]
+        = benchmark::Counter(static_cast<double> (nAllocationsEnd - nAllocationsStart),
+                             benchmark::Counter::kAvgIterations);
+}
+
+/// The number of times in a distribution.  This is a power of 2 so the
+/// benchmarks can cycle through the times with a mask.
+constexpr size_t N_TIMES{4096};
+
+/// @result The nanosecond times to benchmark.  If random is false then
+///         these are the start times of consecutive 512 sample packets
+///         at 100 Hz with occasional gaps, i.e., what a waveform archive
+///         sees.  Otherwise, these are uniformly distributed over
+///         [1970, 2040).
+std::vector<int64_t> makeTimes(const bool random)
+{
+    std::mt19937_64 generator{86754309};
+    std::vector<int64_t> times(N_TIMES);
+    if (random)
+    {
+        std::uniform_int_distribution<int64_t>
+            distribution{0, 2208988800LL*1000000000 - 1};
+        for (auto &time : times){time = distribution(generator);}
+        return times;
+    }
+    std::bernoulli_distribution gap{0.01};
+    int64_t time{1577836800000000000};
+    for (auto &t : times)
+    {
+        t = time;
+        time = time + 512*10000000LL;
+        if (gap(generator)){time = time + 3600LL*1000000000;}
+    }
+    return times;
+}
+
+void setDistributionLabel(benchmark::State &state)
+{
+    state.SetLabel(state.range(0) == 1 ? "random" : "packets");
+}
+
+void constructFromEpoch(benchmark::State &state)
+{
+    double epoch = 1336403638.0001;
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        Time::UTC time(epoch);
+        benchmark::DoNotOptimize(time);
+        epoch = epoch + 0.01;
+    }
+    setAllocationCounter(state, nAllocationsStart);
+}
+
+void copy(benchmark::State &state)
+{
+    Time::UTC time(1336403638.0001);
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        Time::UTC copyTime(time);
+        benchmark::DoNotOptimize(copyTime);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+}
+
+void move(benchmark::State &state)
+{
+    Time::UTC time(1336403638.0001);
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        Time::UTC movedTime(std::move(time));
+        benchmark::DoNotOptimize(movedTime);
+        time = std::move(movedTime);
+        benchmark::DoNotOptimize(time);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+}
+
+void setEpoch(benchmark::State &state)
+{
+    const auto times = makeTimes(state.range(0) == 1);
+    Time::UTC time;
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        time.setEpoch(std::chrono::nanoseconds {times[i]});
+        benchmark::DoNotOptimize(time);
+        i = (i + 1) & (N_TIMES - 1);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+void getEpoch(benchmark::State &state)
+{
+    const auto times = makeTimes(state.range(0) == 1);
+    std::vector<Time::UTC> utcs;
+    for (const auto &time : times)
+    {
+        utcs.push_back(Time::UTC{std::chrono::nanoseconds {time}});
+    }
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utcs[i].getEpoch());
+        i = (i + 1) & (N_TIMES - 1);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+/// Reads the calendar fields of times whose fields are already cached.
+void getCalendarCached(benchmark::State &state)
+{
+    const auto times = makeTimes(state.range(0) == 1);
+    std::vector<Time::UTC> utcs;
+    for (const auto &time : times)
+    {
+        utcs.push_back(Time::UTC{std::chrono::nanoseconds {time}});
+        static_cast<void> (utcs.back().getYear());
+    }
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(utcs[i].getYear());
+        benchmark::DoNotOptimize(utcs[i].getDayOfYear());
+        benchmark::DoNotOptimize(utcs[i].getSecond());
+        i = (i + 1) & (N_TIMES - 1);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+/// Reads the calendar fields immediately after setting the epoch so the
+/// fields must be recomputed.
+void getCalendarDirty(benchmark::State &state)
+{
+    const auto times = makeTimes(state.range(0) == 1);
+    Time::UTC time;
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        time.setEpoch(std::chrono::nanoseconds {times[i]});
+        benchmark::DoNotOptimize(time.getYear());
+        benchmark::DoNotOptimize(time.getDayOfYear());
+        benchmark::DoNotOptimize(time.getSecond());
+        i = (i + 1) & (N_TIMES - 1);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+void addTimes(benchmark::State &state)
+{
+    const auto times = makeTimes(state.range(0) == 1);
+    const Time::UTC dt{std::chrono::milliseconds {5120}};
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        auto result = Time::UTC{std::chrono::nanoseconds {times[i]}} + dt;
+        benchmark::DoNotOptimize(result);
+        i = (i + 1) & (N_TIMES - 1);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+void subtractTimes(benchmark::State &state)
+{
+    const auto times = makeTimes(state.range(0) == 1);
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        auto j = (i + 1) & (N_TIMES - 1);
+        auto result = Time::UTC{std::chrono::nanoseconds {times[j]}}
+                    - Time::UTC{std::chrono::nanoseconds {times[i]}};
+        benchmark::DoNotOptimize(result);
+        i = j;
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+void compare(benchmark::State &state)
+{
+    const auto times = makeTimes(state.range(0) == 1);
+    std::vector<Time::UTC> utcs;
+    for (const auto &time : times)
+    {
+        utcs.push_back(Time::UTC{std::chrono::nanoseconds {time}});
+    }
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        auto j = (i + 1) & (N_TIMES - 1);
+        benchmark::DoNotOptimize(utcs[i] < utcs[j]);
+        benchmark::DoNotOptimize(utcs[i] == utcs[j]);
+        i = j;
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+void addSeconds(benchmark::State &state)
+{
+    Time::UTC time(1336403638.0001);
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        time = time + 0.01;
+        benchmark::DoNotOptimize(time);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+}
+
+/// Advances a time by a sample interval and reads its calendar fields,
+/// e.g., a sliding window.
+void advance(benchmark::State &state)
+{
+    using namespace std::chrono_literals;
+    Time::UTC time(1336403638.0001);
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        time += 10ms;
+        benchmark::DoNotOptimize(time.getSecond());
+    }
+    setAllocationCounter(state, nAllocationsStart);
+}
+
+void clear(benchmark::State &state)
+{
+    Time::UTC time(1336403638.0001);
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        time.clear();
+        benchmark::DoNotOptimize(time);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+}
+
+void parseString(benchmark::State &state)
+{
+    std::vector<std::string> strings;
+    for (const auto &time : makeTimes(state.range(0) == 1))
+    {
+        std::string string(Time::UTC::ISO8601_LENGTH, '\0');
+        Time::UTC{std::chrono::nanoseconds {time}}.toChars(string.data());
+        strings.push_back(std::move(string));
+    }
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        Time::UTC utc(strings[i]);
+        benchmark::DoNotOptimize(utc);
+        i = (i + 1) & (N_TIMES - 1);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+/// Rejects corrupt time stamps, e.g., a flipped digit, by catching the
+/// exception or by checking the result of tryParse.
+void parseCorruptString(benchmark::State &state)
+{
+    std::vector<std::string> strings;
+    for (const auto &time : makeTimes(false))
+    {
+        std::string string(Time::UTC::ISO8601_LENGTH, '\0');
+        Time::UTC{std::chrono::nanoseconds {time}}.toChars(string.data());
+        string[5] = '2'; // Month 2x
+        strings.push_back(std::move(string));
+    }
+    auto useTry = state.range(0) == 1;
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        if (useTry)
+        {
+            auto utc = Time::UTC::tryParse(strings[i]);
+            benchmark::DoNotOptimize(utc);
+        }
+        else
+        {
+            try
+            {
+                Time::UTC utc(strings[i]);
+                benchmark::DoNotOptimize(utc);
+            }
+            catch (const std::invalid_argument &)
+            {
+            }
+        }
+        i = (i + 1) & (N_TIMES - 1);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    state.SetLabel(useTry ? "tryParse" : "throw");
+}
+
+void formatStream(benchmark::State &state)
+{
+    const auto times = makeTimes(state.range(0) == 1);
+    std::ostringstream stream;
+    size_t i{0};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        stream.seekp(0);
+        stream << Time::UTC{std::chrono::nanoseconds {times[i]}};
+        benchmark::DoNotOptimize(stream);
+        i = (i + 1) & (N_TIMES - 1);
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    setDistributionLabel(state);
+}
+
+void formatToChars(benchmark::State &state)
+{
+    Time::UTC time(1336403638.0001);
+    char buffer[Time::UTC::ISO8601_LENGTH];
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        time.setEpoch(std::chrono::nanoseconds {1336403638000100000});
+        auto end = time.toChars(buffer);
+        benchmark::DoNotOptimize(end);
+        benchmark::ClobberMemory();
+    }
+    setAllocationCounter(state, nAllocationsStart);
+}
+
+}
+
+/// Decomposes consecutive 100 Hz sample times with and without the
+/// thread-local day cache.
+void calendarFields(benchmark::State &state)
+{
+    if (state.range(0) == 1){Time::DayCache::enable();}
+    int64_t epoch{1577836800000000000};
+    auto nAllocationsStart = nAllocations.load(std::memory_order_relaxed);
+    for (auto _ : state)
+    {
+        Time::UTC time{std::chrono::nanoseconds {epoch}};
+        benchmark::DoNotOptimize(time.getDayOfYear());
+        benchmark::DoNotOptimize(time.getSecond());
+        epoch = epoch + 10000000;
+    }
+    setAllocationCounter(state, nAllocationsStart);
+    Time::DayCache::disable();
+}
+
+BENCHMARK(constructFromEpoch);
+BENCHMARK(copy);
+BENCHMARK(move);
+BENCHMARK(setEpoch)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(getEpoch)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(getCalendarCached)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(getCalendarDirty)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(addTimes)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(subtractTimes)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(compare)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(addSeconds);
+BENCHMARK(advance);
+BENCHMARK(clear);
+BENCHMARK(parseString)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(parseCorruptString)->ArgName("try")->Arg(0)->Arg(1);
+BENCHMARK(formatStream)->ArgName("random")->Arg(0)->Arg(1);
+BENCHMARK(formatToChars);
+BENCHMARK(calendarFields)->ArgName("dayCache")->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
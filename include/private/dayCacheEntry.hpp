@@ -0,0 +1,23 @@
+#ifndef TIME_PRIVATE_DAY_CACHE_ENTRY_HPP
+#define TIME_PRIVATE_DAY_CACHE_ENTRY_HPP
+#include <cstdint>
+#include <limits>
+namespace Time::Internal
+{
+/// The calling thread's memoized day.
+struct DayCacheEntry
+{
+    int64_t day{std::numeric_limits<int64_t>::lowest()};
+    int year{1970};
+    int month{1};
+    int dayOfMonth{1};
+    int dayOfYear{1};
+    uint64_t hits{0};
+    uint64_t misses{0};
+};
+
+/// @result The calling thread's cache entry if the cache is enabled on
+///         this thread and nullptr otherwise.
+[[nodiscard]] DayCacheEntry *getDayCacheEntry() noexcept;
+}
+#endif
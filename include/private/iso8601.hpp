@@ -0,0 +1,185 @@
+#ifndef TIME_PRIVATE_ISO8601_HPP
+#define TIME_PRIVATE_ISO8601_HPP
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "time/calendar.hpp"
+/// An allocation-free parser for ISO-8601 time stamps of the form
+/// YYYY-MM-DDThh:mm:ss[.f][Z] where the fraction has 1 to 9 digits and the
+/// T may be a space.  The fixed-width fields are parsed eight bytes at a
+/// time (SWAR).  Also, an allocation-free formatter for time stamps of the
+/// form YYYY-MM-DDThh:mm:ss.ffffff.
+namespace Time::ISO8601
+{
+/// The length of a formatted time stamp.
+constexpr size_t LENGTH{26};
+
+/// The two-digit strings "00", "01", ..., "99" laid end to end.
+constexpr auto DIGIT_PAIRS = []()
+{
+    std::array<char, 200> pairs{};
+    for (int i = 0; i < 100; ++i)
+    {
+        pairs[2*i]     = static_cast<char> ('0' + i/10);
+        pairs[2*i + 1] = static_cast<char> ('0' + i%10);
+    }
+    return pairs;
+}();
+
+/// @result The 8 bytes starting at x in little-endian order.
+[[nodiscard]] inline uint64_t load8(const char *x) noexcept
+{
+    uint64_t result;
+    std::memcpy(&result, x, sizeof(uint64_t));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    result = __builtin_bswap64(result);
+#endif
+    return result;
+}
+
+/// @result True indicates the bytes selected by the mask (0xFF per byte)
+///         are all ASCII digits.
+[[nodiscard]] constexpr bool areDigits(const uint64_t chunk,
+                                       const uint64_t mask) noexcept
+{
+    constexpr uint64_t high{0xF0F0F0F0F0F0F0F0};
+    constexpr uint64_t three{0x3030303030303030};
+    constexpr uint64_t six{0x0606060606060606};
+    return ((chunk & (high & mask)) == (three & mask))
+        && (((chunk + (six & mask)) & (high & mask)) == (three & mask));
+}
+
+/// @result The two-digit values with the tens digit at byte k and the
+///         ones digit at byte k + 1 are placed in byte k.
+[[nodiscard]] constexpr uint64_t pairDigits(const uint64_t chunk) noexcept
+{
+    auto digits = chunk & 0x0F0F0F0F0F0F0F0F;
+    return digits*10 + (digits >> 8);
+}
+
+/// @result The value of byte k.
+[[nodiscard]] constexpr int byteAt(const uint64_t x, const int k) noexcept
+{
+    return static_cast<int> ((x >> (8*k)) & 0xFF);
+}
+
+/// @result The value of 8 ASCII digits.
+[[nodiscard]] constexpr uint32_t parse8(uint64_t chunk) noexcept
+{
+    chunk = chunk & 0x0F0F0F0F0F0F0F0F;
+    chunk = (chunk*10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FF)*(100 + (1000000ULL << 32)))
+          + (((chunk >> 16) & 0x000000FF000000FF)*(1 + (10000ULL << 32))))
+          >> 32;
+    return static_cast<uint32_t> (chunk);
+}
+
+/// @brief Parses a time stamp.
+/// @param[in] time    The time stamp, e.g., 2020-03-17T08:01:33.009Z.
+/// @param[out] epoch  The nanoseconds since the epoch.
+/// @result True indicates the time stamp was parsed.
+[[nodiscard]] inline bool parse(const std::string_view time,
+                                int64_t &epoch) noexcept
+{
+    if (time.size() < 19){return false;}
+    const char *s = time.data();
+    // YYYY-MM-
+    auto chunk = load8(s);
+    constexpr uint64_t dateDigits{0x00FFFF00FFFFFFFF};
+    constexpr uint64_t dateSeparatorMask{0xFF0000FF00000000};
+    constexpr uint64_t dateSeparators{0x2D00002D00000000}; // '-'
+    if (!areDigits(chunk, dateDigits)){return false;}
+    if ((chunk & dateSeparatorMask) != dateSeparators){return false;}
+    auto pairs = pairDigits(chunk);
+    auto year = byteAt(pairs, 0)*100 + byteAt(pairs, 2);
+    auto month = byteAt(pairs, 5);
+    // hh:mm:ss
+    chunk = load8(s + 11);
+    constexpr uint64_t timeDigits{0xFFFF00FFFF00FFFF};
+    constexpr uint64_t timeSeparatorMask{0x0000FF0000FF0000};
+    constexpr uint64_t timeSeparators{0x00003A00003A0000}; // ':'
+    if (!areDigits(chunk, timeDigits)){return false;}
+    if ((chunk & timeSeparatorMask) != timeSeparators){return false;}
+    pairs = pairDigits(chunk);
+    auto hour = byteAt(pairs, 0);
+    auto minute = byteAt(pairs, 3);
+    auto second = byteAt(pairs, 6);
+    // DDT
+    auto d1 = s[8] - '0';
+    auto d2 = s[9] - '0';
+    if (d1 < 0 || d1 > 9 || d2 < 0 || d2 > 9){return false;}
+    if (s[10] != 'T' && s[10] != ' '){return false;}
+    auto dayOfMonth = d1*10 + d2;
+    // Fraction and suffix
+    int64_t nanoSecond = 0;
+    size_t i = 19;
+    if (i < time.size() && s[i] == '.')
+    {
+        i = i + 1;
+        size_t nDigits = 0;
+        while (i + nDigits < time.size() && nDigits < 10
+            && s[i + nDigits] >= '0' && s[i + nDigits] <= '9')
+        {
+            nDigits = nDigits + 1;
+        }
+        if (nDigits == 0 || nDigits > 9){return false;}
+        // Right-pad with zeros so the value is scaled to 10^-8 s
+        char buffer[8] = {'0', '0', '0', '0', '0', '0', '0', '0'};
+        std::memcpy(buffer, s + i, nDigits < 8 ? nDigits : 8);
+        nanoSecond = static_cast<int64_t> (parse8(load8(buffer)))*10;
+        if (nDigits == 9){nanoSecond = nanoSecond + (s[i + 8] - '0');}
+        i = i + nDigits;
+    }
+    if (i < time.size() && s[i] == 'Z'){i = i + 1;}
+    if (i != time.size()){return false;}
+    // Validate
+    if (year < Calendar::MINIMUM_YEAR || year > Calendar::MAXIMUM_YEAR)
+    {
+        return false;
+    }
+    if (dayOfMonth < 1 || dayOfMonth > Calendar::daysInMonth(year, month))
+    {
+        return false;
+    }
+    if (hour > 23 || minute > 59 || second > 59){return false;}
+    epoch = Calendar::toEpoch(year, month, dayOfMonth,
+                              hour, minute, second, nanoSecond);
+    return true;
+}
+
+/// @brief Writes the two digits of 0 <= value <= 99.
+inline void write2(char *buffer, const int value) noexcept
+{
+    std::memcpy(buffer, DIGIT_PAIRS.data() + 2*value, 2);
+}
+
+/// @brief Writes a time stamp as YYYY-MM-DDThh:mm:ss.ffffff.
+/// @param[out] buffer  The buffer which must have room for LENGTH characters.
+///                     This is not null terminated.
+/// @result A pointer to one past the last written character.
+inline char *format(char *buffer, const int year, const int month,
+                    const int dayOfMonth, const int hour, const int minute,
+                    const int second, const int microSecond) noexcept
+{
+    write2(buffer,      year/100);
+    write2(buffer + 2,  year%100);
+    buffer[4] = '-';
+    write2(buffer + 5,  month);
+    buffer[7] = '-';
+    write2(buffer + 8,  dayOfMonth);
+    buffer[10] = 'T';
+    write2(buffer + 11, hour);
+    buffer[13] = ':';
+    write2(buffer + 14, minute);
+    buffer[16] = ':';
+    write2(buffer + 17, second);
+    buffer[19] = '.';
+    write2(buffer + 20, microSecond/10000);
+    write2(buffer + 22, (microSecond/100)%100);
+    write2(buffer + 24, microSecond%100);
+    return buffer + LENGTH;
+}
+
+}
+#endif
@@ -0,0 +1,153 @@
+#ifndef TIME_PRIVATE_SIMD_HPP
+#define TIME_PRIVATE_SIMD_HPP
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+/// Portable helpers for writing a kernel once and instantiating it for
+/// scalars (the fallback) and for the GCC/Clang vector extension types
+/// (AVX2 and AVX-512).  The vector instantiations must be called from
+/// functions carrying the matching target attribute.
+namespace Time::SIMD
+{
+using Int32x8 = int32_t __attribute__((vector_size(32)));
+using Float32x8 = float __attribute__((vector_size(32)));
+using Int32x16 = int32_t __attribute__((vector_size(64)));
+using Float32x16 = float __attribute__((vector_size(64)));
+using Int64x4 = int64_t __attribute__((vector_size(32)));
+using Float64x4 = double __attribute__((vector_size(32)));
+using Int64x8 = int64_t __attribute__((vector_size(64)));
+using Float64x8 = double __attribute__((vector_size(64)));
+
+/// The instruction sets for which kernels are generated.
+enum class InstructionSet
+{
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+/// @result The best instruction set supported by this CPU.
+[[nodiscard]] inline InstructionSet getInstructionSet() noexcept
+{
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    static const InstructionSet instructionSet = []()
+    {
+        __builtin_cpu_init();
+        // The 64-bit kernels need the multiply and conversions from DQ
+        if (__builtin_cpu_supports("avx512f") &&
+            __builtin_cpu_supports("avx512dq"))
+        {
+            return InstructionSet::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")){return InstructionSet::AVX2;}
+        return InstructionSet::Scalar;
+    }();
+    return instructionSet;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+/// @result The floating point type corresponding to the integer type I.
+template<typename I> struct FloatOf{using type = float;};
+template<> struct FloatOf<int64_t>{using type = double;};
+template<> struct FloatOf<Int32x8>{using type = Float32x8;};
+template<> struct FloatOf<Int32x16>{using type = Float32x16;};
+template<> struct FloatOf<Int64x4>{using type = Float64x4;};
+template<> struct FloatOf<Int64x8>{using type = Float64x8;};
+
+/// @result The number of lanes in I.
+template<typename I>
+constexpr int getLanes() noexcept
+{
+    if constexpr (std::is_arithmetic_v<I>)
+    {
+        return 1;
+    }
+    else
+    {
+        return static_cast<int> (sizeof(I)/sizeof(I{}[0]));
+    }
+}
+template<typename I>
+constexpr int LANES = getLanes<I>();
+
+/// @result x converted lane by lane to the type T.
+template<typename T, typename I>
+[[gnu::always_inline]] inline T convert(const I &x) noexcept
+{
+    if constexpr (std::is_arithmetic_v<I>)
+    {
+        return static_cast<T> (x);
+    }
+    else
+    {
+        return __builtin_convertvector(x, T);
+    }
+}
+
+/// @result x broadcast to all lanes of I.
+template<typename I, typename T = int32_t>
+[[gnu::always_inline]] inline I broadcast(const T x) noexcept
+{
+    if constexpr (std::is_integral_v<I>)
+    {
+        return x;
+    }
+    else
+    {
+        return I{} + x;
+    }
+}
+
+/// @result Loads LANES<I> values from a (possibly unaligned) pointer.
+template<typename I, typename T>
+[[gnu::always_inline]] inline I load(const T *x) noexcept
+{
+    I result;
+    std::memcpy(&result, x, sizeof(I));
+    return result;
+}
+
+/// @brief Stores LANES<I> values to a (possibly unaligned) pointer.
+template<typename I, typename T>
+[[gnu::always_inline]] inline void store(const I &x, T *y) noexcept
+{
+    std::memcpy(y, &x, sizeof(I));
+}
+
+/// @result For each lane, a if the condition holds and b otherwise.
+template<typename I, typename M>
+[[gnu::always_inline]] inline I select(const M &condition,
+                                       const I &a, const I &b) noexcept
+{
+    return condition ? a : b;
+}
+
+/// @result 1 in the lanes where the condition holds and 0 otherwise.
+template<typename I, typename M>
+[[gnu::always_inline]] inline I toOne(const M &condition) noexcept
+{
+    return select<I>(condition, broadcast<I>(1), broadcast<I>(0));
+}
+
+/// @result floor(x/D) for 0 <= x < 2^20.  The vector version multiplies by
+///         the single-precision reciprocal, which is exact in this range,
+///         since there is no SIMD integer division.
+template<int32_t D, typename I>
+[[gnu::always_inline]] inline I divide(const I &x) noexcept
+{
+    if constexpr (std::is_integral_v<I>)
+    {
+        return x/D;
+    }
+    else
+    {
+        using F = typename FloatOf<I>::type;
+        constexpr float inverse = 1.0f/static_cast<float> (D);
+        auto xf = __builtin_convertvector(x, F) + 0.5f;
+        return __builtin_convertvector(xf*inverse, I);
+    }
+}
+}
+#endif
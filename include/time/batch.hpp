@@ -0,0 +1,224 @@
+#ifndef TIME_BATCH_HPP
+#define TIME_BATCH_HPP
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+namespace Time::Batch
+{
+/// @struct CalendarColumns "batch.hpp" "time/batch.hpp"
+/// @brief Struct-of-arrays views of the calendar fields of a set of times.
+///        Element i of each column corresponds to time i.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+struct CalendarColumns
+{
+    std::span<int32_t> year;       ///< The year.
+    std::span<int32_t> dayOfYear;  ///< The day of the year in [1,366].
+    std::span<int32_t> month;      ///< The month in [1,12].
+    std::span<int32_t> dayOfMonth; ///< The day of the month in [1,31].
+    std::span<int32_t> hour;       ///< The hour of the day in [0,23].
+    std::span<int32_t> minute;     ///< The minute of the hour in [0,59].
+    std::span<int32_t> second;     ///< The second of the minute in [0,59].
+    std::span<int32_t> nanoSecond; ///< The nanosecond of the second in [0,999999999].
+};
+
+/// @brief Converts times to their calendar fields.  This is equivalent to,
+///        but much faster than, calling the getters of \c UTC for each time.
+/// @param[in] epochs     The UTC times measured in nanoseconds since the
+///                       epoch (Jan 1 1970).
+/// @param[out] calendar  The calendar fields of each time.  Each column must
+///                       have length at least epochs.size().
+/// @throws std::invalid_argument if a column is too small.
+/// @note The calendar arithmetic is vectorized with AVX-512 or AVX2 when the
+///       CPU supports it and falls back to scalar code otherwise.
+void toCalendar(std::span<const int64_t> epochs,
+                const CalendarColumns &calendar);
+
+/// @struct ConstCalendarColumns "batch.hpp" "time/batch.hpp"
+/// @brief Read-only struct-of-arrays views of the calendar fields of a set
+///        of times.  Element i of each column corresponds to time i.
+/// @note The sub-second may be given as microseconds or nanoseconds.  If
+///       both of these columns are empty then the sub-second is zero.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+struct ConstCalendarColumns
+{
+    std::span<const int32_t> year;        ///< The year in [1678,2261].
+    std::span<const int32_t> dayOfYear;   ///< The day of the year.
+    std::span<const int32_t> month;       ///< The month in [1,12].
+    std::span<const int32_t> dayOfMonth;  ///< The day of the month.
+    std::span<const int32_t> hour;        ///< The hour of the day in [0,23].
+    std::span<const int32_t> minute;      ///< The minute of the hour in [0,59].
+    std::span<const int32_t> second;      ///< The second of the minute in [0,59].
+    std::span<const int32_t> microSecond; ///< The microsecond in [0,999999].
+    std::span<const int32_t> nanoSecond;  ///< The nanosecond in [0,999999999].
+};
+
+/// @brief Converts times given by their year, month, day of month, hour,
+///        minute, second, and sub-second to epochs.  This is equivalent to,
+///        but much faster than, calling the setters of \c UTC for each time.
+/// @param[in] calendar  The calendar fields.  The year, month, dayOfMonth,
+///                      hour, minute, and second columns are required.  The
+///                      dayOfYear column is ignored.
+/// @param[out] epochs   The UTC times measured in nanoseconds since the epoch
+///                      (Jan 1 1970).  Invalid rows are set to 0.
+/// @param[out] invalid  Set to 1 if row i has a field out of range and 0
+///                      otherwise.
+/// @result The number of invalid rows.
+/// @throws std::invalid_argument if a required column or the outputs are
+///         smaller than calendar.year.size() or if both the microSecond and
+///         nanoSecond columns are given.
+/// @note Rows are validated in bulk and never throw.
+size_t fromMonthAndDay(const ConstCalendarColumns &calendar,
+                       std::span<int64_t> epochs,
+                       std::span<uint8_t> invalid);
+/// @brief Converts times given by their year, day of year, hour, minute,
+///        second, and sub-second to epochs.
+/// @param[in] calendar  The calendar fields.  The year, dayOfYear, hour,
+///                      minute, and second columns are required.  The
+///                      month and dayOfMonth columns are ignored.
+/// @param[out] epochs   The UTC times measured in nanoseconds since the epoch
+///                      (Jan 1 1970).  Invalid rows are set to 0.
+/// @param[out] invalid  Set to 1 if row i has a field out of range and 0
+///                      otherwise.
+/// @result The number of invalid rows.
+/// @throws std::invalid_argument if a required column or the outputs are
+///         smaller than calendar.year.size() or if both the microSecond and
+///         nanoSecond columns are given.
+size_t fromDayOfYear(const ConstCalendarColumns &calendar,
+                     std::span<int64_t> epochs,
+                     std::span<uint8_t> invalid);
+
+/// @brief Parses ISO-8601 time stamps of the form YYYY-MM-DDTHH:MM:SS[.f][Z]
+///        where the fraction has 1 to 9 digits and the T may be a space.
+/// @param[in] times     The time stamps.
+/// @param[out] epochs   The UTC times measured in nanoseconds since the epoch
+///                      (Jan 1 1970).  Invalid rows are set to 0.
+/// @param[out] invalid  Set to 1 if row i could not be parsed and 0 otherwise.
+/// @result The number of invalid rows.
+/// @throws std::invalid_argument if the outputs are smaller than times.
+/// @note This does not allocate.
+size_t fromStrings(std::span<const std::string_view> times,
+                   std::span<int64_t> epochs,
+                   std::span<uint8_t> invalid);
+/// @brief Parses a column of delimited ISO-8601 time stamps, e.g., the
+///        lines of a pick file.
+/// @param[in] column     The time stamps separated by the delimiter.  A
+///                       trailing carriage return on each row is ignored as
+///                       is a trailing delimiter.
+/// @param[in] delimiter  The row delimiter, e.g., '\n'.
+/// @param[out] epochs    The UTC times measured in nanoseconds since the epoch
+///                       (Jan 1 1970).  Invalid rows are set to 0.
+/// @param[out] invalid   Set to 1 if row i could not be parsed and 0 otherwise.
+/// @result The number of rows.
+/// @throws std::invalid_argument if the outputs have fewer elements than
+///         the number of rows.
+size_t fromColumn(std::string_view column, char delimiter,
+                  std::span<int64_t> epochs,
+                  std::span<uint8_t> invalid);
+
+/// @brief Formats times as a column of delimited time stamps of the form
+///        YYYY-MM-DDTHH:MM:SS.SSSSSS.  This is the inverse of \c fromColumn().
+/// @param[in] epochs     The UTC times measured in nanoseconds since the
+///                       epoch (Jan 1 1970).
+/// @param[in] delimiter  The delimiter written after each time stamp,
+///                       e.g., '\n'.
+/// @param[out] buffer    The buffer to write to.  This must have space for
+///                       at least 27*epochs.size() characters.  The result
+///                       is not null terminated.
+/// @result The number of characters written.
+/// @throws std::invalid_argument if the buffer is too small.
+/// @note This does not allocate.
+size_t toColumn(std::span<const int64_t> epochs, char delimiter,
+                std::span<char> buffer);
+
+/// @brief The calendar periods to which times can be binned.
+enum class CalendarPeriod
+{
+    Day,   /*!< A UTC day. */
+    Month, /*!< A calendar month. */
+    Year   /*!< A calendar year. */
+};
+
+/// @brief Rounds times down to a multiple of a period, e.g., the start of
+///        their minute.  Periods are measured from the epoch (Jan 1 1970).
+/// @param[in] epochs   The UTC times measured in nanoseconds since the
+///                     epoch (Jan 1 1970).
+/// @param[in] period   The period, e.g., std::chrono::minutes {1}.
+/// @param[out] result  The rounded times.  This must have length at least
+///                     epochs.size() and may be epochs.
+/// @throws std::invalid_argument if the period is not positive or the
+///         result is too small.
+/// @note Every int64 time is valid.  Multiples of the period beyond the
+///       limits of int64 are saturated to INT64_MIN or INT64_MAX.
+/// @note The division is vectorized with AVX-512 when the CPU supports it.
+void floor(std::span<const int64_t> epochs, std::chrono::nanoseconds period,
+           std::span<int64_t> result);
+/// @brief Rounds times up to a multiple of a period.
+/// @copydetails floor(std::span<const int64_t>, std::chrono::nanoseconds, std::span<int64_t>)
+void ceil(std::span<const int64_t> epochs, std::chrono::nanoseconds period,
+          std::span<int64_t> result);
+/// @brief Rounds times to the nearest multiple of a period.  Times half way
+///        between two multiples are rounded up.
+/// @copydetails floor(std::span<const int64_t>, std::chrono::nanoseconds, std::span<int64_t>)
+void round(std::span<const int64_t> epochs, std::chrono::nanoseconds period,
+           std::span<int64_t> result);
+/// @brief Rounds times down to the start of their calendar period, e.g.,
+///        the first of their month.
+/// @param[in] epochs   The UTC times measured in nanoseconds since the
+///                     epoch (Jan 1 1970).
+/// @param[in] period   The calendar period.
+/// @param[out] result  The start of the period containing each time.  This
+///                     must have length at least epochs.size() and may be
+///                     epochs.
+/// @throws std::invalid_argument if the result is too small.
+/// @note The calendar arithmetic is vectorized as in \c toCalendar().
+///       Every int64 time is valid.  The starts of periods beyond the
+///       limits of int64, e.g., 1677-01-01 or 2263-01-01, are saturated to
+///       INT64_MIN or INT64_MAX.
+void floor(std::span<const int64_t> epochs, CalendarPeriod period,
+           std::span<int64_t> result);
+/// @brief Rounds times up to the start of the next calendar period unless
+///        they are at the start of a period.
+/// @copydetails floor(std::span<const int64_t>, CalendarPeriod, std::span<int64_t>)
+void ceil(std::span<const int64_t> epochs, CalendarPeriod period,
+          std::span<int64_t> result);
+/// @brief Rounds times to the nearest start of a calendar period.  Times
+///        half way through a period are rounded up.
+/// @copydetails floor(std::span<const int64_t>, CalendarPeriod, std::span<int64_t>)
+void round(std::span<const int64_t> epochs, CalendarPeriod period,
+           std::span<int64_t> result);
+
+/// @struct Group "batch.hpp" "time/batch.hpp"
+/// @brief A run of times in the same bin.
+struct Group
+{
+    int64_t start{0}; ///< The start of the bin.
+    size_t begin{0};  ///< The index of the first time in the bin.
+    size_t end{0};    ///< One past the index of the last time in the bin.
+};
+/// @brief Splits sorted times into runs that share a bin, e.g., the packets
+///        of each minute.  The end of each run is found with an exponential
+///        then binary search so the cost grows with the number of bins
+///        rather than the number of times.
+/// @param[in] epochs  The UTC times measured in nanoseconds since the epoch
+///                    (Jan 1 1970) sorted in non-decreasing order.
+/// @param[in] period  The bin width measured from the epoch.
+/// @result The non-empty bins in increasing order.  The start of a bin that
+///         begins before INT64_MIN is INT64_MIN.
+/// @throws std::invalid_argument if the period is not positive.
+/// @note If the times are not sorted the groups are unspecified.
+[[nodiscard]] std::vector<Group> groupBy(std::span<const int64_t> epochs,
+                                         std::chrono::nanoseconds period);
+/// @brief Splits sorted times into runs that share a calendar period, e.g.,
+///        the packets of each month.
+/// @param[in] epochs  The UTC times measured in nanoseconds since the epoch
+///                    (Jan 1 1970) sorted in non-decreasing order.
+/// @param[in] period  The calendar period.
+/// @result The non-empty periods in increasing order.  The start of a
+///         period that begins before INT64_MIN is INT64_MIN.
+/// @note If the times are not sorted the groups are unspecified.
+[[nodiscard]] std::vector<Group> groupBy(std::span<const int64_t> epochs,
+                                         CalendarPeriod period);
+}
+#endif
@@ -0,0 +1,166 @@
+#ifndef TIME_BOUNDARIES_HPP
+#define TIME_BOUNDARIES_HPP
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include "time/sampleAxis.hpp"
+/// Enumeration of the hours, days, or months spanned by a time interval,
+/// e.g., to write one archive file per day or to split packets that cross
+/// midnight.  All times are UTC measured in nanoseconds since the epoch
+/// (Jan 1 1970).
+namespace Time
+{
+/// @brief The calendar periods whose boundaries can be enumerated.
+enum class BoundaryPeriod
+{
+    Hour, /*!< A UTC hour. */
+    Day,  /*!< A UTC day. */
+    Month /*!< A calendar month. */
+};
+
+/// @struct Boundary "boundaries.hpp" "time/boundaries.hpp"
+/// @brief An hour, day, or month and its calendar fields.  Fields finer
+///        than the period are at the start of the period, e.g., the hour
+///        of a day is 0.
+struct Boundary
+{
+    int64_t start{0};    ///< The start of the period.
+    int64_t end{0};      ///< The start of the next period.
+    int year{1970};      ///< The year.
+    int month{1};        ///< The month in the range [1,12].
+    int dayOfMonth{1};   ///< The day of the month in the range [1,31].
+    int dayOfYear{1};    ///< The day of the year in the range [1,366].
+    int hour{0};         ///< The hour in the range [0,23].
+};
+
+/// @param[in] time    The time.
+/// @param[in] period  The calendar period.
+/// @result The period containing the time.
+/// @throws std::invalid_argument if the time is not in the years
+///         [1678,2261].
+[[nodiscard]] Boundary getBoundary(int64_t time, BoundaryPeriod period);
+/// @param[in] boundary  A period.
+/// @param[in] period    The calendar period of the boundary.
+/// @result The period after the given one.  The calendar fields are
+///         incremented rather than recomputed from the time.
+[[nodiscard]] Boundary getNextBoundary(const Boundary &boundary,
+                                       BoundaryPeriod period) noexcept;
+
+/// @class BoundaryRange "boundaries.hpp" "time/boundaries.hpp"
+/// @brief A lazy range of the periods that overlap [start, end).  The
+///        first element is the period containing start, e.g.,
+///        \code
+///        for (const auto &day : BoundaryRange(t0, t1, BoundaryPeriod::Day))
+///        {
+///            // Write [max(t0, day.start), min(t1, day.end)) to the file
+///            // for day.year and day.dayOfYear
+///        }
+///        \endcode
+///        Only the first period is computed from a time; each later period
+///        is derived from the previous one.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class BoundaryRange : public std::ranges::view_interface<BoundaryRange>
+{
+public:
+    /// @brief A forward iterator over the periods.
+    class Iterator
+    {
+    public:
+        using value_type = Boundary;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+
+        /// @brief Constructs an exhausted iterator.
+        Iterator() noexcept = default;
+        /// @result The current period.  This is a copy since the period is
+        ///         stored in the iterator.
+        [[nodiscard]] Boundary operator*() const noexcept
+        {
+            return mBoundary;
+        }
+        /// @result The current period.
+        [[nodiscard]] const Boundary *operator->() const noexcept
+        {
+            return &mBoundary;
+        }
+        /// @brief Advances to the next period.
+        Iterator &operator++() noexcept
+        {
+            mBoundary = getNextBoundary(mBoundary, mPeriod);
+            return *this;
+        }
+        /// @brief Advances to the next period.
+        Iterator operator++(int) noexcept
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+        /// @result True indicates the iterators are at the same period.
+        [[nodiscard]] bool operator==(const Iterator &rhs) const noexcept
+        {
+            return mBoundary.start == rhs.mBoundary.start;
+        }
+        /// @result True indicates the iterator is past the last period.
+        [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept
+        {
+            return mBoundary.start >= mEnd;
+        }
+    private:
+        friend class BoundaryRange;
+        Iterator(const Boundary &boundary, const BoundaryPeriod period,
+                 const int64_t end) noexcept :
+            mBoundary(boundary),
+            mEnd(end),
+            mPeriod(period)
+        {
+        }
+        Boundary mBoundary;
+        int64_t mEnd{0};
+        BoundaryPeriod mPeriod{BoundaryPeriod::Day};
+    };
+
+    /// @brief Constructs an empty range.
+    BoundaryRange() noexcept = default;
+    /// @brief Constructs the range of periods that overlap [start, end).
+    /// @param[in] start   The earliest time.
+    /// @param[in] end     One past the latest time.  If this is not after
+    ///                    start then the range is empty.
+    /// @param[in] period  The calendar period.
+    /// @throws std::invalid_argument if start or end is not in the years
+    ///         [1678,2261].
+    BoundaryRange(int64_t start, int64_t end, BoundaryPeriod period);
+    /// @result An iterator to the period containing the start time.
+    [[nodiscard]] Iterator begin() const noexcept
+    {
+        return Iterator{mFirst, mPeriod, mEnd};
+    }
+    /// @result The sentinel marking the end of the range.
+    [[nodiscard]] std::default_sentinel_t end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+private:
+    Boundary mFirst;
+    int64_t mEnd{0};
+    BoundaryPeriod mPeriod{BoundaryPeriod::Day};
+};
+
+/// @brief Finds where a packet of uniformly sampled data must be split,
+///        e.g., at midnight.
+/// @param[in] startTime       The time of sample 0.
+/// @param[in] samplingPeriod  The sampling period.
+/// @param[in] nSamples        The number of samples in the packet.
+/// @param[in] period          The calendar period.
+/// @result The index of the first sample after the period containing
+///         sample 0 or nSamples if every sample is in that period.
+/// @throws std::invalid_argument if nSamples is negative or the start time
+///         is not in the years [1678,2261].
+[[nodiscard]] int64_t findBoundarySample(int64_t startTime,
+                                         const SamplingPeriod &samplingPeriod,
+                                         int64_t nSamples,
+                                         BoundaryPeriod period);
+}
+#endif
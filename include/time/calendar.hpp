@@ -0,0 +1,114 @@
+#ifndef TIME_CALENDAR_HPP
+#define TIME_CALENDAR_HPP
+#include <cstdint>
+/// @brief Proleptic Gregorian calendar arithmetic on nanoseconds since the
+///        epoch (Jan 1 1970).  Everything here is constexpr so fixed
+///        reference times can be computed at compile time.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+namespace Time::Calendar
+{
+constexpr int64_t NANOSECONDS_PER_MICROSECOND{1000};
+constexpr int64_t NANOSECONDS_PER_SECOND{1000000000};
+constexpr int64_t SECONDS_PER_DAY{86400};
+constexpr int64_t NANOSECONDS_PER_DAY{SECONDS_PER_DAY*NANOSECONDS_PER_SECOND};
+/// The range of years whose every instant fits in int64 nanoseconds
+/// since the epoch, i.e., [1677-09-21, 2262-04-11].
+constexpr int MINIMUM_YEAR{1678};
+constexpr int MAXIMUM_YEAR{2261};
+
+/// @brief A calendar date.
+struct CivilDate
+{
+    int year{1970};
+    int month{1};
+    int dayOfMonth{1};
+};
+
+/// @result floor(numerator/denominator) for a positive denominator.
+[[nodiscard]] constexpr int64_t floorDivide(const int64_t numerator,
+                                            const int64_t denominator) noexcept
+{
+    auto quotient = numerator/denominator;
+    return (numerator % denominator < 0) ? quotient - 1 : quotient;
+}
+
+/// @result The non-negative remainder of numerator/denominator for a
+///         positive denominator.
+[[nodiscard]] constexpr int64_t floorModulo(const int64_t numerator,
+                                            const int64_t denominator) noexcept
+{
+    auto remainder = numerator % denominator;
+    return (remainder < 0) ? remainder + denominator : remainder;
+}
+
+/// @result True indicates the year is a leap year.
+[[nodiscard]] constexpr bool isLeapYear(const int year) noexcept
+{
+    return (year % 4 == 0) && (year % 100 != 0 || year % 400 == 0);
+}
+
+/// @result The number of days since 1970-01-01 of the given date.
+/// @note This is H. Hinnant's days_from_civil algorithm.
+[[nodiscard]] constexpr int64_t daysFromCivil(const int year,
+                                              const int month,
+                                              const int dayOfMonth) noexcept
+{
+    const int64_t y = static_cast<int64_t> (year) - (month <= 2 ? 1 : 0);
+    const int64_t era = (y >= 0 ? y : y - 399)/400;
+    const auto yoe = static_cast<int64_t> (y - era*400);     // [0, 399]
+    const int64_t mp = (month + 9) % 12;                     // March = 0
+    const int64_t doy = (153*mp + 2)/5 + dayOfMonth - 1;     // [0, 365]
+    const int64_t doe = yoe*365 + yoe/4 - yoe/100 + doy;     // [0, 146096]
+    return era*146097 + doe - 719468;
+}
+
+/// @result The calendar date corresponding to the days since 1970-01-01.
+/// @note This is H. Hinnant's civil_from_days algorithm.
+[[nodiscard]] constexpr CivilDate civilFromDays(const int64_t days) noexcept
+{
+    const int64_t z = days + 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096)/146097;
+    const auto doe = static_cast<int64_t> (z - era*146097);            // [0, 146096]
+    const int64_t yoe = (doe - doe/1460 + doe/36524 - doe/146096)/365; // [0, 399]
+    const int64_t doy = doe - (365*yoe + yoe/4 - yoe/100);             // [0, 365]
+    const int64_t mp = (5*doy + 2)/153;                                // [0, 11]
+    CivilDate result;
+    result.dayOfMonth = static_cast<int> (doy - (153*mp + 2)/5 + 1);
+    result.month = static_cast<int> (mp < 10 ? mp + 3 : mp - 9);
+    result.year = static_cast<int> (yoe + era*400 + (result.month <= 2 ? 1 : 0));
+    return result;
+}
+
+/// @result The number of days in the month or 0 if the month is not in
+///         the range [1,12].
+[[nodiscard]] constexpr int daysInMonth(const int year,
+                                        const int month) noexcept
+{
+    if (month < 1 || month > 12){return 0;}
+    if (month == 2 && isLeapYear(year)){return 29;}
+    return 28 + ((0x3BBEECC >> (month*2)) & 3);
+}
+
+/// @result The nanoseconds since the epoch of the given date and time.
+/// @note The fields are not validated.
+[[nodiscard]] constexpr int64_t toEpoch(const int year, const int month,
+                                        const int dayOfMonth,
+                                        const int hour, const int minute,
+                                        const int second,
+                                        const int64_t nanoSecond) noexcept
+{
+    return daysFromCivil(year, month, dayOfMonth)*NANOSECONDS_PER_DAY
+         + static_cast<int64_t> (hour*3600 + minute*60 + second)
+          *NANOSECONDS_PER_SECOND
+         + nanoSecond;
+}
+
+/// @result The day of the year in the range [1,366].
+[[nodiscard]] constexpr int dayOfYear(const int year, const int month,
+                                      const int dayOfMonth) noexcept
+{
+    return static_cast<int> (daysFromCivil(year, month, dayOfMonth)
+                           - daysFromCivil(year, 1, 1)) + 1;
+}
+}
+#endif
@@ -0,0 +1,58 @@
+#ifndef TIME_CLOCK_HPP
+#define TIME_CLOCK_HPP
+#include <chrono>
+#include <cstdint>
+namespace Time
+{
+/// @class Clock "clock.hpp" "time/clock.hpp"
+/// @brief Selects the source of the current time used by \c UTC::now() and
+///        \c UTC::nowEpoch().  The source is shared by all threads.
+/// @note The sources trade accuracy for cost:
+///       - Realtime reads the system realtime clock.  This is the default.
+///       - CoarseRealtime reads the kernel's cached realtime clock.  This
+///         is cheaper but only has the resolution of the scheduler tick,
+///         e.g., 1 to 4 ms.  Where unavailable this is Realtime.
+///       - TSC reads the processor's time stamp counter and scales it with
+///         a rate calibrated against the realtime clock.  The counter is
+///         periodically resynchronized to the realtime clock so that the
+///         two do not drift apart.  This requires an invariant TSC on
+///         x86-64.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Clock
+{
+public:
+    /// @brief The clock sources.
+    enum class Source
+    {
+        Realtime,       /*!< The system realtime clock. */
+        CoarseRealtime, /*!< The coarse, i.e., tick resolution, realtime clock. */
+        TSC             /*!< The calibrated time stamp counter. */
+    };
+
+    /// @brief Sets the clock source.
+    /// @param[in] source  The clock source.  Selecting the TSC calibrates
+    ///                    it, which blocks for about 10 ms.
+    /// @throws std::invalid_argument if the TSC is selected but is not
+    ///         available.
+    static void setSource(Source source);
+    /// @result The clock source.
+    [[nodiscard]] static Source getSource() noexcept;
+    /// @result True indicates this processor has an invariant TSC so that
+    ///         it can be the clock source.
+    [[nodiscard]] static bool isTSCAvailable() noexcept;
+
+    /// @brief Sets how often the TSC is resynchronized to the realtime
+    ///        clock.
+    /// @param[in] interval  The resynchronization interval.  The default is
+    ///                      1 second.
+    /// @throws std::invalid_argument if the interval is not positive.
+    static void setResynchronizationInterval(std::chrono::nanoseconds interval);
+    /// @result The TSC resynchronization interval.
+    [[nodiscard]] static std::chrono::nanoseconds getResynchronizationInterval() noexcept;
+
+    /// @result The current time from the selected source measured in
+    ///         nanoseconds since the epoch (Jan 1 1970).
+    [[nodiscard]] static std::chrono::nanoseconds now() noexcept;
+};
+}
+#endif
@@ -0,0 +1,35 @@
+#ifndef TIME_DAY_CACHE_HPP
+#define TIME_DAY_CACHE_HPP
+#include <cstdint>
+namespace Time
+{
+/// @class DayCache "dayCache.hpp" "time/dayCache.hpp"
+/// @brief An opt-in, per-thread memoization of the last UTC day converted
+///        by \c UTC.  Packet and sample times typically arrive nearly in
+///        order so consecutive conversions usually fall on the same day.
+///        When this cache is hit the conversion reduces to seconds-of-day
+///        arithmetic.
+/// @note The cache and its counters are local to the calling thread.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class DayCache
+{
+public:
+    /// @brief Enables the cache on the calling thread.
+    static void enable() noexcept;
+    /// @brief Disables the cache on the calling thread.
+    static void disable() noexcept;
+    /// @result True indicates the cache is enabled on the calling thread.
+    [[nodiscard]] static bool isEnabled() noexcept;
+
+    /// @result The number of conversions on the calling thread that were
+    ///         served by the cache.
+    [[nodiscard]] static uint64_t getHits() noexcept;
+    /// @result The number of conversions on the calling thread that
+    ///         required the full calendar computation while the cache
+    ///         was enabled.
+    [[nodiscard]] static uint64_t getMisses() noexcept;
+    /// @brief Resets the hit and miss counters on the calling thread.
+    static void resetCounters() noexcept;
+};
+}
+#endif
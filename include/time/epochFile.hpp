@@ -0,0 +1,183 @@
+#ifndef TIME_EPOCH_FILE_HPP
+#define TIME_EPOCH_FILE_HPP
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "time/utc.hpp"
+/// A columnar file of UTC times measured in nanoseconds since the epoch,
+/// e.g., packet or pick times.  The file is a 64 byte header, the times as
+/// little-endian int64 values, and an index with the minimum and maximum
+/// time of each fixed-size block of times.  The reader memory maps the file
+/// so queries return spans into the mapping and touch only the blocks that
+/// overlap the query.
+namespace Time
+{
+/// @brief The minimum and maximum time in a block of an epoch file.
+struct EpochFileBlock
+{
+    int64_t minimum{0}; ///< The earliest time in the block.
+    int64_t maximum{0}; ///< The latest time in the block.
+};
+
+/// @class EpochFileWriter "epochFile.hpp" "time/epochFile.hpp"
+/// @brief Streams times to an epoch file.  The file is complete once
+///        \c close() is called.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class EpochFileWriter
+{
+public:
+    /// The default number of times in a block, i.e., 32 KiB of data.
+    static constexpr size_t DEFAULT_BLOCK_SIZE{4096};
+
+    /// @brief Creates the file.  An existing file is overwritten.
+    /// @param[in] fileName   The name of the file.
+    /// @param[in] blockSize  The number of times in a block.  Smaller blocks
+    ///                       make range queries more selective but the
+    ///                       index larger.
+    /// @throws std::invalid_argument if the block size is 0 or the file
+    ///         cannot be created.
+    explicit EpochFileWriter(const std::filesystem::path &fileName,
+                             size_t blockSize = DEFAULT_BLOCK_SIZE);
+    /// @brief Appends a time.
+    /// @param[in] epoch  The time measured in nanoseconds since the epoch.
+    /// @throws std::invalid_argument if the file is closed or the write fails.
+    void append(int64_t epoch);
+    /// @brief Appends times.
+    /// @param[in] epochs  The times measured in nanoseconds since the epoch.
+    /// @throws std::invalid_argument if the file is closed or the write fails.
+    void append(std::span<const int64_t> epochs);
+    /// @result The number of times written.
+    [[nodiscard]] size_t size() const noexcept;
+    /// @brief Writes the index and header and closes the file.  This does
+    ///        nothing if the file is already closed.
+    /// @throws std::invalid_argument if the write fails.
+    void close();
+    /// @brief Destructor.  This closes the file.
+    ~EpochFileWriter();
+
+    EpochFileWriter(const EpochFileWriter &) = delete;
+    EpochFileWriter& operator=(const EpochFileWriter &) = delete;
+private:
+    std::filesystem::path mFileName;
+    std::ofstream mFile;
+    std::vector<EpochFileBlock> mBlocks;
+    size_t mBlockSize{DEFAULT_BLOCK_SIZE};
+    size_t mSize{0};
+    int64_t mLast{0};
+    bool mSorted{true};
+};
+
+/// @class EpochFileReader "epochFile.hpp" "time/epochFile.hpp"
+/// @brief A read-only memory mapping of an epoch file.  Nothing is copied
+///        or parsed; the spans returned by this class point into the mapping
+///        and are valid until the reader is closed or destroyed.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class EpochFileReader
+{
+public:
+    /// @brief Constructs a reader with no file.
+    EpochFileReader() noexcept = default;
+    /// @brief Maps a file.
+    /// @param[in] fileName  The name of the epoch file.
+    /// @throws std::invalid_argument if the file does not exist, cannot be
+    ///         mapped, or is not a valid epoch file.
+    explicit EpochFileReader(const std::filesystem::path &fileName);
+    /// @brief Move constructor.
+    EpochFileReader(EpochFileReader &&reader) noexcept;
+    /// @brief Move assignment operator.
+    EpochFileReader& operator=(EpochFileReader &&reader) noexcept;
+    /// @brief Destructor.  This unmaps the file.
+    ~EpochFileReader();
+
+    EpochFileReader(const EpochFileReader &) = delete;
+    EpochFileReader& operator=(const EpochFileReader &) = delete;
+
+    /// @brief Unmaps the file.
+    void close() noexcept;
+    /// @result True indicates a file is mapped.
+    [[nodiscard]] bool isOpen() const noexcept;
+
+    /// @result The number of times in the file.
+    [[nodiscard]] size_t size() const noexcept;
+    /// @result True indicates there are no times.
+    [[nodiscard]] bool empty() const noexcept;
+    /// @result True indicates the times are in non-decreasing order.
+    [[nodiscard]] bool isSorted() const noexcept;
+    /// @result The number of times in a block.  The last block may be
+    ///         partial.
+    [[nodiscard]] size_t getBlockSize() const noexcept;
+
+    /// @result All the times measured in nanoseconds since the epoch.
+    [[nodiscard]] std::span<const int64_t> getEpochs() const noexcept;
+    /// @result The block index.
+    [[nodiscard]] std::span<const EpochFileBlock> getBlocks() const noexcept;
+    /// @param[in] block  The block.
+    /// @result The times in the block.
+    /// @throws std::out_of_range if the block is out of range.
+    [[nodiscard]] std::span<const int64_t> getBlock(size_t block) const;
+    /// @param[in] index  The index of the time.
+    /// @result The time.  This is only created when requested.
+    /// @throws std::out_of_range if the index is out of range.
+    [[nodiscard]] UTC at(size_t index) const;
+
+    /// @brief Finds the times in a sorted file in [start, end).
+    /// @param[in] start  The earliest time measured in nanoseconds since
+    ///                   the epoch.
+    /// @param[in] end    One past the latest time measured in nanoseconds
+    ///                   since the epoch.
+    /// @result The times in the range.  Only the blocks at the ends of the
+    ///         range are searched.
+    /// @throws std::invalid_argument if the file is not sorted.
+    [[nodiscard]] std::span<const int64_t> find(int64_t start, int64_t end) const;
+    /// @brief Visits the blocks whose [minimum, maximum] overlaps
+    ///        [start, end).  This works for unsorted files, e.g., picks,
+    ///        whose times must still be filtered by the caller.
+    /// @param[in] start     The earliest time measured in nanoseconds since
+    ///                      the epoch.
+    /// @param[in] end       One past the latest time measured in nanoseconds
+    ///                      since the epoch.
+    /// @param[in] function  Called as function(block, epochs) where epochs
+    ///                      are the times in the block.
+    template<typename Function>
+    void forEachBlock(const int64_t start, const int64_t end,
+                      Function &&function) const
+    {
+        auto blocks = getBlocks();
+        size_t first{0};
+        if (mSorted)
+        {
+            // Skip the blocks that end before the range
+            first = static_cast<size_t> (
+                std::partition_point(blocks.begin(), blocks.end(),
+                                     [start](const EpochFileBlock &block)
+                                     {
+                                         return block.maximum < start;
+                                     }) - blocks.begin());
+        }
+        for (size_t block = first; block < blocks.size(); ++block)
+        {
+            if (blocks[block].minimum >= end)
+            {
+                if (mSorted){break;}
+                continue;
+            }
+            if (blocks[block].maximum < start){continue;}
+            function(block, getBlock(block));
+        }
+    }
+private:
+    const int64_t *mEpochs{nullptr};
+    const EpochFileBlock *mBlocks{nullptr};
+    void *mMapping{nullptr};
+    size_t mMappingLength{0};
+    size_t mSize{0};
+    size_t mNumberOfBlocks{0};
+    size_t mBlockSize{0};
+    bool mSorted{true};
+};
+}
+#endif
@@ -0,0 +1,172 @@
+#ifndef TIME_EXPECTED_HPP
+#define TIME_EXPECTED_HPP
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+namespace Time
+{
+/// @brief The reasons a time cannot be parsed or a calendar field cannot
+///        be set.
+enum class Error : uint8_t
+{
+    InvalidTimeStamp,      /*!< The time stamp is malformed or has a field
+                                out of range. */
+    YearOutOfRange,        /*!< The year is not in [1678,2261]. */
+    MonthOutOfRange,       /*!< The month is not in [1,12]. */
+    DayOfMonthOutOfRange,  /*!< The day is not in the month. */
+    DayOfYearOutOfRange,   /*!< The day is not in the year. */
+    HourOutOfRange,        /*!< The hour is not in [0,23]. */
+    MinuteOutOfRange,      /*!< The minute is not in [0,59]. */
+    SecondOutOfRange,      /*!< The second is not in [0,59]. */
+    MicroSecondOutOfRange, /*!< The microsecond is not in [0,999999]. */
+    NanoSecondOutOfRange,  /*!< The nanosecond is not in [0,999999999]. */
+    EpochOutOfRange        /*!< The epoch is not finite or not in the
+                                years [1678,2261]. */
+};
+
+/// @result A description of the error, e.g., for an exception message.
+///         This is a string literal so it never allocates.
+[[nodiscard]] constexpr const char *toString(const Error error) noexcept
+{
+    switch (error)
+    {
+        case Error::InvalidTimeStamp:
+            return "Time stamp is malformed or out of range";
+        case Error::YearOutOfRange:
+            return "Year must be in range [1678,2261]";
+        case Error::MonthOutOfRange:
+            return "Month must be in range [1,12]";
+        case Error::DayOfMonthOutOfRange:
+            return "Day of month is out of range";
+        case Error::DayOfYearOutOfRange:
+            return "Day of year is out of range";
+        case Error::HourOutOfRange:
+            return "Hour must be in range [0,23]";
+        case Error::MinuteOutOfRange:
+            return "Minute must be in range [0,59]";
+        case Error::SecondOutOfRange:
+            return "Second must be in range [0,59]";
+        case Error::MicroSecondOutOfRange:
+            return "Microsecond must be in range [0,999999]";
+        case Error::NanoSecondOutOfRange:
+            return "Nanosecond must be in range [0,999999999]";
+        case Error::EpochOutOfRange:
+            return "Epoch must be finite and in the years [1678,2261]";
+    }
+    return "Unknown error";
+}
+
+/// @class Expected "expected.hpp" "time/expected.hpp"
+/// @brief Holds either a value or the \c Error explaining why there is
+///        no value.  This lets hot paths reject bad input with a branch
+///        instead of unwinding an exception.
+/// @note The member functions are named as in C++23's std::expected so
+///       that callers can migrate by changing a type alias.  This is
+///       not std::expected since the library targets C++20 and a type that
+///       depended on the consumer's standard would change the ABI.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+template<typename T>
+class Expected
+{
+    static_assert(std::is_nothrow_default_constructible_v<T>,
+                  "T must be nothrow default constructible");
+public:
+    /// @brief Holds a value.
+    constexpr Expected(const T &value)
+        noexcept(std::is_nothrow_copy_constructible_v<T>) :
+        mValue{value},
+        mHasValue{true}
+    {
+    }
+    /// @brief Holds an error.
+    constexpr Expected(const Error error) noexcept :
+        mError{error}
+    {
+    }
+    /// @result True indicates this holds a value.
+    [[nodiscard]] constexpr bool has_value() const noexcept
+    {
+        return mHasValue;
+    }
+    /// @result True indicates this holds a value.
+    [[nodiscard]] constexpr explicit operator bool() const noexcept
+    {
+        return mHasValue;
+    }
+    /// @result The value.
+    /// @throws std::invalid_argument if this holds an error.
+    [[nodiscard]] constexpr const T &value() const
+    {
+        if (!mHasValue){throw std::invalid_argument(toString(mError));}
+        return mValue;
+    }
+    /// @result The value or, if this holds an error, the default.
+    [[nodiscard]] constexpr T value_or(const T &defaultValue) const
+    {
+        return mHasValue ? mValue : defaultValue;
+    }
+    /// @result The error.  This is only meaningful if \c has_value()
+    ///         is false.
+    [[nodiscard]] constexpr Error error() const noexcept
+    {
+        return mError;
+    }
+    /// @result The value.  This is only meaningful if \c has_value()
+    ///         is true.
+    [[nodiscard]] constexpr const T &operator*() const noexcept
+    {
+        return mValue;
+    }
+    /// @result The value.  This is only meaningful if \c has_value()
+    ///         is true.
+    [[nodiscard]] constexpr const T *operator->() const noexcept
+    {
+        return &mValue;
+    }
+private:
+    T mValue{};
+    Error mError{Error::InvalidTimeStamp};
+    bool mHasValue{false};
+};
+
+/// @brief The outcome of an operation that returns nothing on success.
+template<>
+class Expected<void>
+{
+public:
+    /// @brief Success.
+    constexpr Expected() noexcept = default;
+    /// @brief Holds an error.
+    constexpr Expected(const Error error) noexcept :
+        mError{error},
+        mHasValue{false}
+    {
+    }
+    /// @result True indicates success.
+    [[nodiscard]] constexpr bool has_value() const noexcept
+    {
+        return mHasValue;
+    }
+    /// @result True indicates success.
+    [[nodiscard]] constexpr explicit operator bool() const noexcept
+    {
+        return mHasValue;
+    }
+    /// @throws std::invalid_argument if this holds an error.
+    constexpr void value() const
+    {
+        if (!mHasValue){throw std::invalid_argument(toString(mError));}
+    }
+    /// @result The error.  This is only meaningful if \c has_value()
+    ///         is false.
+    [[nodiscard]] constexpr Error error() const noexcept
+    {
+        return mError;
+    }
+private:
+    Error mError{Error::InvalidTimeStamp};
+    bool mHasValue{true};
+};
+}
+#endif
@@ -0,0 +1,129 @@
+#ifndef TIME_INTERVAL_INDEX_HPP
+#define TIME_INTERVAL_INDEX_HPP
+#include <cstdint>
+#include <span>
+#include <vector>
+namespace Time
+{
+/// @class IntervalIndex "intervalIndex.hpp" "time/intervalIndex.hpp"
+/// @brief An immutable index of half-open [start, end) time intervals,
+///        e.g., the channel and response epochs of station metadata.  Given
+///        a time, a stabbing query returns every interval containing it.
+///
+///        The interval boundaries split the time line into elementary
+///        segments.  The index stores the sorted boundaries and, for each
+///        segment, the intervals that cover it in two flat arrays.  A query
+///        is therefore a binary search followed by a contiguous read.  For
+///        monotonically increasing queries, e.g., packet times, a \c Cursor
+///        remembers the last segment and answers in amortized O(1).
+/// @note Intervals are identified by their position in the input.  Times
+///       are typically UTC measured in nanoseconds since the epoch.
+/// @note The storage is linear in the number of intervals when they
+///       rarely overlap, as is the case for metadata epochs.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class IntervalIndex
+{
+public:
+    /// @brief A half-open interval [start, end).
+    struct Interval
+    {
+        int64_t start{0}; ///< The start of the interval.
+        int64_t end{0};   ///< The end of the interval.
+    };
+    /// @brief A query position for monotonically increasing queries.  It
+    ///        remains valid for the lifetime of the index.
+    class Cursor
+    {
+    public:
+        /// @brief Creates a cursor positioned before the first interval.
+        explicit Cursor(const IntervalIndex &index) noexcept :
+            mIndex(&index)
+        {
+        }
+        /// @param[in] time  The query time.
+        /// @result The identifiers of the intervals containing the time in
+        ///         order of increasing start.  This is empty if no interval
+        ///         contains the time.
+        /// @note This is O(1) when the time is in the same or the next
+        ///       segment as the previous query and O(log n) otherwise.
+        [[nodiscard]] std::span<const uint32_t> stab(const int64_t time) noexcept
+        {
+            const auto &boundaries = mIndex->mBoundaries;
+            auto n = static_cast<int64_t> (boundaries.size());
+            if (mSegment + 1 < n && time >= boundaries[mSegment + 1])
+            {
+                // Step forward once and otherwise search
+                mSegment = mSegment + 1;
+                if (mSegment + 1 < n && time >= boundaries[mSegment + 1])
+                {
+                    mSegment = mIndex->findSegment(time);
+                }
+            }
+            else if (mSegment >= 0 && time < boundaries[mSegment])
+            {
+                mSegment = mIndex->findSegment(time);
+            }
+            return mIndex->getSegment(mSegment);
+        }
+    private:
+        const IntervalIndex *mIndex{nullptr};
+        int64_t mSegment{-1};
+    };
+
+    /// @brief Constructs an empty index.
+    IntervalIndex();
+    /// @brief Constructs the index.
+    /// @param[in] intervals  The intervals.  Interval i has identifier i.
+    ///                       Empty intervals, i.e., start = end, are
+    ///                       allowed and contain no times.
+    /// @throws std::invalid_argument if an interval ends before it starts
+    ///         or if there are more than 2^32 - 1 intervals.
+    explicit IntervalIndex(std::span<const Interval> intervals);
+
+    /// @result The number of intervals.
+    [[nodiscard]] size_t size() const noexcept;
+    /// @result True indicates there are no intervals.
+    [[nodiscard]] bool empty() const noexcept;
+    /// @param[in] identifier  The interval identifier.
+    /// @result The interval.
+    /// @throws std::out_of_range if the identifier is out of range.
+    [[nodiscard]] Interval at(size_t identifier) const;
+
+    /// @param[in] time  The query time.
+    /// @result The identifiers of the intervals containing the time in order
+    ///         of increasing start.  This is empty if no interval contains
+    ///         the time.
+    [[nodiscard]] std::span<const uint32_t> stab(int64_t time) const noexcept;
+    /// @brief For each time finds the containing interval with the latest
+    ///        start, i.e., the active epoch.
+    /// @param[in] times        The query times.  Sorted times are answered
+    ///                         in amortized O(1) per time.
+    /// @param[out] identifiers The identifier of the interval with the
+    ///                         latest start containing times[i] or -1 if no
+    ///                         interval contains times[i].  This must have
+    ///                         length at least times.size().
+    /// @throws std::invalid_argument if identifiers is too small.
+    void stab(std::span<const int64_t> times,
+              std::span<int64_t> identifiers) const;
+private:
+    [[nodiscard]] int64_t findSegment(int64_t time) const noexcept;
+    [[nodiscard]] std::span<const uint32_t> getSegment(const int64_t segment) const noexcept
+    {
+        if (segment < 0){return {};}
+        auto offset = mOffsets[static_cast<size_t> (segment)];
+        auto nIntervals = mOffsets[static_cast<size_t> (segment) + 1] - offset;
+        return std::span<const uint32_t> {mIdentifiers.data() + offset,
+                                          nIntervals};
+    }
+    /// The input intervals.
+    std::vector<Interval> mIntervals;
+    /// The sorted, unique interval boundaries.  Segment j is
+    /// [mBoundaries[j], mBoundaries[j + 1]).
+    std::vector<int64_t> mBoundaries;
+    /// The intervals covering segment j are
+    /// mIdentifiers[mOffsets[j]:mOffsets[j + 1]].
+    std::vector<size_t> mOffsets;
+    std::vector<uint32_t> mIdentifiers;
+};
+}
+#endif
@@ -0,0 +1,162 @@
+#ifndef TIME_LEAP_SECONDS_HPP
+#define TIME_LEAP_SECONDS_HPP
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+namespace Time
+{
+/// @class LeapSeconds "leapSeconds.hpp" "time/leapSeconds.hpp"
+/// @brief Converts between the UTC, TAI, and GPS time scales.  All times
+///        are integer nanoseconds:
+///        - UTC is measured since 1970-01-01T00:00:00 UTC and does not
+///          count leap seconds, i.e., UTC::getEpochInNanoSeconds().
+///        - TAI is measured since 1970-01-01T00:00:00 TAI so that
+///          TAI = UTC + (TAI - UTC).
+///        - GPS is measured since the GPS epoch, 1980-01-06T00:00:00 UTC,
+///          so that GPS = TAI - 19 s - 315964800 s.
+///
+///        By default the leap-second table is the one compiled into the
+///        library.  It can be replaced with a newer leap-seconds.list file
+///        as distributed by the IERS and NIST.
+///
+///        The converter remembers the leap-second segment of the last time
+///        it converted.  Away from leap seconds a conversion is therefore
+///        a range check and an addition.
+/// @note Since the segment is cached the conversions are not const.  Use
+///       one converter per thread.
+/// @note Times prior to 1972 use the 1972 offset of 10 s.
+/// @note A TAI time that falls within an inserted leap second, i.e.,
+///       23:59:60 UTC, is converted to the last representable UTC time
+///       prior to the insertion, i.e., 23:59:59.999999999.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class LeapSeconds
+{
+public:
+    /// @brief Constructs the converter from the compiled-in leap-second
+    ///        table.
+    LeapSeconds();
+
+    /// @brief Loads the leap-second table from a file in the format of the
+    ///        IERS/NIST leap-seconds.list file.  Each non-comment line has
+    ///        the seconds since 1900-01-01 (NTP time) followed by TAI - UTC
+    ///        in seconds.
+    /// @param[in] fileName  The name of the leap-seconds file.
+    /// @throws std::invalid_argument if the file does not exist, has no
+    ///         entries, or the entries are malformed or out of order.
+    void load(const std::filesystem::path &fileName);
+    /// @brief Restores the compiled-in leap-second table.
+    void loadDefault();
+
+    /// @param[in] utc  The UTC time in nanoseconds.
+    /// @result TAI - UTC in seconds at the given time.
+    [[nodiscard]] int getTAIMinusUTC(int64_t utc) noexcept;
+    /// @result The number of entries in the leap-second table.
+    [[nodiscard]] int getNumberOfEntries() const noexcept;
+
+    /// @brief Converts a UTC time to TAI.
+    /// @param[in] utc  The UTC time in nanoseconds.
+    /// @result The corresponding TAI time in nanoseconds.
+    [[nodiscard]] int64_t utcToTAI(const int64_t utc) noexcept
+    {
+        if (utc < mUTCSegmentStart || utc >= mUTCSegmentEnd) [[unlikely]]
+        {
+            updateUTCSegment(utc);
+        }
+        return utc + mUTCSegmentOffset;
+    }
+    /// @brief Converts a TAI time to UTC.
+    /// @param[in] tai  The TAI time in nanoseconds.
+    /// @result The corresponding UTC time in nanoseconds.
+    [[nodiscard]] int64_t taiToUTC(const int64_t tai) noexcept
+    {
+        if (tai < mTAISegmentStart || tai >= mTAISegmentEnd) [[unlikely]]
+        {
+            return updateTAISegment(tai);
+        }
+        return tai - mTAISegmentOffset;
+    }
+    /// @brief Converts a UTC time to GPS time.
+    /// @param[in] utc  The UTC time in nanoseconds.
+    /// @result The corresponding GPS time in nanoseconds.
+    [[nodiscard]] int64_t utcToGPS(const int64_t utc) noexcept
+    {
+        return taiToGPS(utcToTAI(utc));
+    }
+    /// @brief Converts a GPS time to UTC.
+    /// @param[in] gps  The GPS time in nanoseconds.
+    /// @result The corresponding UTC time in nanoseconds.
+    [[nodiscard]] int64_t gpsToUTC(const int64_t gps) noexcept
+    {
+        return taiToUTC(gpsToTAI(gps));
+    }
+    /// @brief Converts a TAI time to GPS time.  This is a constant shift.
+    [[nodiscard]] static constexpr int64_t taiToGPS(const int64_t tai) noexcept
+    {
+        return tai - GPS_EPOCH_IN_TAI;
+    }
+    /// @brief Converts a GPS time to TAI.  This is a constant shift.
+    [[nodiscard]] static constexpr int64_t gpsToTAI(const int64_t gps) noexcept
+    {
+        return gps + GPS_EPOCH_IN_TAI;
+    }
+
+    /// @brief Converts UTC times to TAI.
+    /// @param[in] utc   The UTC times in nanoseconds.
+    /// @param[out] tai  The corresponding TAI times in nanoseconds.  This
+    ///                  must have length at least utc.size() and may alias
+    ///                  utc.
+    /// @throws std::invalid_argument if tai is too small.
+    void utcToTAI(std::span<const int64_t> utc, std::span<int64_t> tai);
+    /// @brief Converts TAI times to UTC.
+    /// @param[in] tai   The TAI times in nanoseconds.
+    /// @param[out] utc  The corresponding UTC times in nanoseconds.  This
+    ///                  must have length at least tai.size() and may alias
+    ///                  tai.
+    /// @throws std::invalid_argument if utc is too small.
+    void taiToUTC(std::span<const int64_t> tai, std::span<int64_t> utc);
+    /// @brief Converts UTC times to GPS time.
+    /// @param[in] utc   The UTC times in nanoseconds.
+    /// @param[out] gps  The corresponding GPS times in nanoseconds.  This
+    ///                  must have length at least utc.size() and may alias
+    ///                  utc.
+    /// @throws std::invalid_argument if gps is too small.
+    void utcToGPS(std::span<const int64_t> utc, std::span<int64_t> gps);
+    /// @brief Converts GPS times to UTC.
+    /// @param[in] gps   The GPS times in nanoseconds.
+    /// @param[out] utc  The corresponding UTC times in nanoseconds.  This
+    ///                  must have length at least gps.size() and may alias
+    ///                  gps.
+    /// @throws std::invalid_argument if utc is too small.
+    void gpsToUTC(std::span<const int64_t> gps, std::span<int64_t> utc);
+
+    /// @brief The GPS epoch in TAI nanoseconds.  The GPS epoch is
+    ///        315964800 s after the UTC epoch and TAI - GPS is 19 s.
+    static constexpr int64_t GPS_EPOCH_IN_TAI{(315964800 + 19)*1000000000LL};
+private:
+    void setTable(std::vector<int64_t> &&utcStart,
+                  std::vector<int64_t> &&offset);
+    void updateUTCSegment(int64_t utc) noexcept;
+    int64_t updateTAISegment(int64_t tai) noexcept;
+    void utcToTAI(std::span<const int64_t> utc, std::span<int64_t> tai,
+                  int64_t shift);
+    void taiToUTC(std::span<const int64_t> tai, std::span<int64_t> utc,
+                  int64_t shift);
+    /// The UTC time at which each offset begins.
+    std::vector<int64_t> mUTCStart;
+    /// The TAI time at which each offset begins.
+    std::vector<int64_t> mTAIStart;
+    /// TAI - UTC in nanoseconds.
+    std::vector<int64_t> mOffset;
+    /// The cached UTC segment [start, end) and its offset.
+    int64_t mUTCSegmentStart{0};
+    int64_t mUTCSegmentEnd{0};
+    int64_t mUTCSegmentOffset{0};
+    /// The cached TAI segment [start, end) and its offset.  The end
+    /// excludes any leap second that ends the segment.
+    int64_t mTAISegmentStart{0};
+    int64_t mTAISegmentEnd{0};
+    int64_t mTAISegmentOffset{0};
+};
+}
+#endif
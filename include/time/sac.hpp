@@ -0,0 +1,116 @@
+#ifndef TIME_SAC_HPP
+#define TIME_SAC_HPP
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+/// Conversion of the times in SAC binary headers.  A SAC header stores a
+/// reference time as the integers nzyear, nzjday, nzhour, nzmin, nzsec, and
+/// nzmsec and its markers, e.g., the begin time b or a pick t0, as float
+/// offsets in seconds from the reference time.  These functions convert
+/// between the headers, laid end to end, and absolute UTC times measured in
+/// nanoseconds since the epoch (Jan 1 1970).
+namespace Time::SAC
+{
+/// @brief The byte order of the header.
+enum class ByteOrder
+{
+    BigEndian,   /*!< Big-endian. */
+    LittleEndian /*!< Little-endian (the usual SAC byte order). */
+};
+/// @brief The time markers in the header in the order they are stored in
+///        the marker times.
+enum class Marker
+{
+    B,  /*!< The begin time. */
+    E,  /*!< The end time. */
+    O,  /*!< The origin time. */
+    A,  /*!< The first arrival time. */
+    T0, /*!< User defined time pick 0. */
+    T1, /*!< User defined time pick 1. */
+    T2, /*!< User defined time pick 2. */
+    T3, /*!< User defined time pick 3. */
+    T4, /*!< User defined time pick 4. */
+    T5, /*!< User defined time pick 5. */
+    T6, /*!< User defined time pick 6. */
+    T7, /*!< User defined time pick 7. */
+    T8, /*!< User defined time pick 8. */
+    T9, /*!< User defined time pick 9. */
+    F   /*!< The end of event time. */
+};
+/// The number of markers per header.
+constexpr size_t NUMBER_OF_MARKERS{15};
+/// The length of a SAC binary header in bytes.
+constexpr size_t HEADER_LENGTH{632};
+/// The value of an undefined float header field.
+constexpr float UNDEFINED_FLOAT{-12345.0f};
+/// The value of an undefined integer header field.
+constexpr int32_t UNDEFINED_INTEGER{-12345};
+/// The time of an undefined marker.
+constexpr int64_t UNDEFINED_TIME{std::numeric_limits<int64_t>::lowest()};
+
+/// @param[in] row     The header index.
+/// @param[in] marker  The marker.
+/// @result The index of the marker of the given header in the marker times.
+[[nodiscard]] constexpr size_t getMarkerIndex(const size_t row,
+                                              const Marker marker) noexcept
+{
+    return row*NUMBER_OF_MARKERS + static_cast<size_t> (marker);
+}
+
+/// @brief Reads the reference and marker times of headers.
+/// @param[in] headers          The headers laid end to end.
+/// @param[out] referenceTimes  The reference time of each header measured
+///                             in nanoseconds since the epoch.  Invalid
+///                             headers are set to 0.
+/// @param[out] markerTimes     The marker times of header i are elements
+///                             [i*NUMBER_OF_MARKERS, (i + 1)*NUMBER_OF_MARKERS)
+///                             in the order of \c Marker.  Each is the
+///                             reference time plus the offset rounded to the
+///                             nearest nanosecond or \c UNDEFINED_TIME if the
+///                             offset is undefined.  Invalid headers are set
+///                             to 0.
+/// @param[out] invalid         Set to 1 if header i has a reference time field
+///                             that is undefined or out of range or a marker
+///                             offset that is not finite or too large and 0
+///                             otherwise.
+/// @param[in] byteOrder        The byte order of the headers.
+/// @result The number of invalid headers.
+/// @throws std::invalid_argument if the headers are not a whole number of
+///         headers or the outputs are too small.
+/// @note Headers are validated in bulk and never throw.  The reference
+///       times are converted as in \c Batch::fromDayOfYear().
+size_t getTimes(std::span<const std::byte> headers,
+                std::span<int64_t> referenceTimes,
+                std::span<int64_t> markerTimes,
+                std::span<uint8_t> invalid,
+                ByteOrder byteOrder = ByteOrder::LittleEndian);
+/// @brief Writes the reference and marker times of headers.  This is the
+///        inverse of \c getTimes().
+/// @param[in] referenceTimes  The reference time of each header measured in
+///                            nanoseconds since the epoch.  SAC stores
+///                            milliseconds so this is rounded down to the
+///                            millisecond and the markers are written
+///                            relative to the rounded time.
+/// @param[in] markerTimes     The marker times laid out as in
+///                            \c getTimes().  Markers that are
+///                            \c UNDEFINED_TIME are written as
+///                            \c UNDEFINED_FLOAT.
+/// @param[in,out] headers     The headers laid end to end.  Only the reference
+///                            time and marker fields of valid rows are
+///                            written.
+/// @param[out] invalid        Set to 1 if reference time i is not in the
+///                            years [1678,2261] or a marker time is too far
+///                            from it and 0 otherwise.
+/// @param[in] byteOrder       The byte order of the headers.
+/// @result The number of invalid rows.
+/// @throws std::invalid_argument if the headers are not a whole number of
+///         headers or the inputs or invalid are too small.
+/// @note Rows are validated in bulk and never throw.
+size_t setTimes(std::span<const int64_t> referenceTimes,
+                std::span<const int64_t> markerTimes,
+                std::span<std::byte> headers,
+                std::span<uint8_t> invalid,
+                ByteOrder byteOrder = ByteOrder::LittleEndian);
+}
+#endif
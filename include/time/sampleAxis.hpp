@@ -0,0 +1,110 @@
+#ifndef TIME_SAMPLE_AXIS_HPP
+#define TIME_SAMPLE_AXIS_HPP
+#include <cstdint>
+#include <span>
+namespace Time
+{
+/// @class SamplingPeriod "sampleAxis.hpp" "time/sampleAxis.hpp"
+/// @brief An exact sampling period of numerator/denominator nanoseconds.
+///        Most sampling rates, e.g., 100 Hz, have an integer period.  Rates
+///        such as 3 Hz do not and are represented exactly as a rational so
+///        sample times never drift.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class SamplingPeriod
+{
+public:
+    /// @brief Constructs an integer sampling period.
+    /// @param[in] nanoSeconds  The sampling period in nanoseconds.
+    /// @throws std::invalid_argument if nanoSeconds is not positive.
+    explicit SamplingPeriod(int64_t nanoSeconds);
+    /// @brief Constructs a rational sampling period.
+    /// @param[in] numerator    The numerator of the period in nanoseconds.
+    /// @param[in] denominator  The denominator of the period.
+    /// @throws std::invalid_argument if the numerator or denominator is not
+    ///         positive.
+    SamplingPeriod(int64_t numerator, int64_t denominator);
+    /// @brief Creates the sampling period of a sampling rate.
+    /// @param[in] numerator    The numerator of the sampling rate in Hz.
+    /// @param[in] denominator  The denominator of the sampling rate.
+    /// @result The sampling period, 10^9*denominator/numerator ns.
+    /// @throws std::invalid_argument if the numerator or denominator is not
+    ///         positive or the period overflows.
+    [[nodiscard]] static SamplingPeriod fromSamplingRate(int64_t numerator,
+                                                         int64_t denominator = 1);
+
+    /// @result The numerator of the period in nanoseconds.  The fraction
+    ///         is in lowest terms.
+    [[nodiscard]] int64_t getNumerator() const noexcept;
+    /// @result The denominator of the period.
+    [[nodiscard]] int64_t getDenominator() const noexcept;
+    /// @result True indicates the period is an integer number of nanoseconds.
+    [[nodiscard]] bool isInteger() const noexcept;
+
+    /// @param[in] sample  The sample index.
+    /// @result The time of the sample relative to sample 0, i.e.,
+    ///         sample*period, rounded to the nearest nanosecond.
+    [[nodiscard]] int64_t getOffset(int64_t sample) const noexcept;
+private:
+    int64_t mNumerator{1};
+    int64_t mDenominator{1};
+};
+
+/// Generation of sample times and the mapping of times to sample indices.
+/// Sample i is at startTime + period.getOffset(i).  All times are UTC
+/// measured in nanoseconds since the epoch (Jan 1 1970).
+namespace SampleAxis
+{
+/// @brief Fills the sample times.  This is exact and equivalent to, but
+///        much faster than, repeatedly adding the sampling period to a
+///        \c UTC.
+/// @param[in] startTime  The time of sample 0.
+/// @param[in] period     The sampling period.
+/// @param[out] times     The time of sample i is written to times[i].
+/// @note The loop is vectorized with AVX-512 or AVX2 when the CPU
+///       supports it.
+void generate(int64_t startTime, const SamplingPeriod &period,
+              std::span<int64_t> times) noexcept;
+
+/// @param[in] startTime  The time of sample 0.
+/// @param[in] period     The sampling period.
+/// @param[in] time       The query time.
+/// @result The index of the last sample at or before the time.
+[[nodiscard]] int64_t toFloorIndex(int64_t startTime,
+                                   const SamplingPeriod &period,
+                                   int64_t time) noexcept;
+/// @param[in] startTime  The time of sample 0.
+/// @param[in] period     The sampling period.
+/// @param[in] time       The query time.
+/// @result The index of the sample nearest the time.  Ties go to the
+///         later sample.
+[[nodiscard]] int64_t toNearestIndex(int64_t startTime,
+                                     const SamplingPeriod &period,
+                                     int64_t time) noexcept;
+
+/// @brief Maps times to the index of the last sample at or before each
+///        time, e.g., to find the start of a window.
+/// @param[in] startTime  The time of sample 0.
+/// @param[in] period     The sampling period.
+/// @param[in] times      The query times.
+/// @param[out] indices   The sample index of each query time.  This must
+///                       have length at least times.size().
+/// @throws std::invalid_argument if indices is too small.
+/// @note For integer periods the division is vectorized with AVX-512
+///       when the CPU supports it.
+void toFloorIndices(int64_t startTime, const SamplingPeriod &period,
+                    std::span<const int64_t> times,
+                    std::span<int64_t> indices);
+/// @brief Maps times to the index of the nearest sample.  Ties go to the
+///        later sample.
+/// @param[in] startTime  The time of sample 0.
+/// @param[in] period     The sampling period.
+/// @param[in] times      The query times.
+/// @param[out] indices   The sample index of each query time.  This must
+///                       have length at least times.size().
+/// @throws std::invalid_argument if indices is too small.
+void toNearestIndices(int64_t startTime, const SamplingPeriod &period,
+                      std::span<const int64_t> times,
+                      std::span<int64_t> indices);
+}
+}
+#endif
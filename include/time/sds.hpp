@@ -0,0 +1,49 @@
+#ifndef TIME_SDS_HPP
+#define TIME_SDS_HPP
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include "time/boundaries.hpp"
+/// Paths of the day files in a SeisComP Data Structure (SDS) archive, i.e.,
+/// YEAR/NET/STA/CHA.D/NET.STA.LOC.CHA.D.YEAR.DAY where DAY is the
+/// zero-padded day of the year.
+namespace Time::SDS
+{
+/// The maximum length of a network, station, location, or channel code.
+constexpr size_t MAXIMUM_CODE_LENGTH{8};
+/// The length of a path with the longest codes.
+constexpr size_t MAXIMUM_PATH_LENGTH{24 + 7*MAXIMUM_CODE_LENGTH};
+
+/// @brief Formats the path, relative to the archive root, of a day file.
+/// @param[in] network     The network code, e.g., UU.
+/// @param[in] station     The station code, e.g., CTU.
+/// @param[in] location    The location code, e.g., 01.  This may be empty.
+/// @param[in] channel     The channel code, e.g., HHZ.
+/// @param[in] year        The year.
+/// @param[in] dayOfYear   The day of the year.
+/// @param[out] path       The path.  This is not null terminated and must
+///                        have length at least \c MAXIMUM_PATH_LENGTH or at
+///                        least the length of the path.
+/// @result The number of characters written to the path.
+/// @throws std::invalid_argument if a code is too long, a required code is
+///         empty, a code has characters other than letters, digits, - or _,
+///         the year is not in [1678,2261], the day is not in the year, or
+///         the path is too small.
+/// @note This does not allocate.
+[[nodiscard]] size_t formatPath(std::string_view network,
+                                std::string_view station,
+                                std::string_view location,
+                                std::string_view channel,
+                                int year, int dayOfYear,
+                                std::span<char> path);
+/// @brief Formats the path of the day file containing a day or hour, e.g.,
+///        from a \c BoundaryRange.
+/// @copydetails formatPath(std::string_view, std::string_view, std::string_view, std::string_view, int, int, std::span<char>)
+[[nodiscard]] size_t formatPath(std::string_view network,
+                                std::string_view station,
+                                std::string_view location,
+                                std::string_view channel,
+                                const Boundary &day,
+                                std::span<char> path);
+}
+#endif
@@ -0,0 +1,72 @@
+#ifndef TIME_SEED_HPP
+#define TIME_SEED_HPP
+#include <cstddef>
+#include <cstdint>
+#include <span>
+/// Decoding of the times in SEED 2.x, e.g., miniSEED, fixed data headers.
+/// The times are read in place from the byte buffer and validated in a
+/// single pass.
+namespace Time::SEED
+{
+/// @brief The byte order of the header fields.
+enum class ByteOrder
+{
+    BigEndian,   /*!< Big-endian (the SEED default). */
+    LittleEndian /*!< Little-endian. */
+};
+/// The length of a BTIME in bytes.
+constexpr size_t BTIME_LENGTH{10};
+/// The length of the fixed section of a data header in bytes.
+constexpr size_t FIXED_HEADER_LENGTH{48};
+/// The offset of the record start time in the fixed section of the data
+/// header.
+constexpr size_t START_TIME_OFFSET{20};
+
+/// @brief Decodes a BTIME, i.e., the year, day of year, hour, minute,
+///        second, an unused byte, and the 0.0001 s ticks.
+/// @param[in] btime      The BTIME.  This must have at least
+///                       \c BTIME_LENGTH bytes.
+/// @param[in] byteOrder  The byte order of the year, day of year, and ticks.
+/// @result The UTC time measured in nanoseconds since the epoch
+///         (Jan 1 1970).
+/// @throws std::invalid_argument if the buffer is too small or a field is
+///         out of range.
+/// @note A second of 60, i.e., a leap second, is allowed and is carried
+///       into the next minute as in the POSIX time scale.
+[[nodiscard]] int64_t fromBTIME(std::span<const std::byte> btime,
+                                ByteOrder byteOrder = ByteOrder::BigEndian);
+/// @brief Decodes the start time of a data record.  This is the BTIME in
+///        the fixed section of the header plus the time correction if the
+///        activity flags indicate the correction was not applied.
+/// @param[in] record     The data record.  This must have at least
+///                       \c FIXED_HEADER_LENGTH bytes.
+/// @param[in] byteOrder  The byte order of the header.
+/// @result The UTC start time measured in nanoseconds since the epoch
+///         (Jan 1 1970).
+/// @throws std::invalid_argument if the record is too small or a field
+///         of the start time is out of range.
+[[nodiscard]] int64_t getRecordStartTime(std::span<const std::byte> record,
+                                         ByteOrder byteOrder = ByteOrder::BigEndian);
+/// @brief Decodes the start times of a stream of fixed-length data
+///        records, e.g., a miniSEED file or a buffer of SeedLink packets.
+/// @param[in] records       The records laid end to end.
+/// @param[in] recordLength  The length of each record in bytes, e.g., 512.
+/// @param[out] startTimes   The UTC start time of each record measured in
+///                          nanoseconds since the epoch (Jan 1 1970).
+///                          Invalid records are set to 0.
+/// @param[out] invalid      Set to 1 if record i has a start time field out
+///                          of range and 0 otherwise.
+/// @param[in] byteOrder     The byte order of the headers.
+/// @result The number of invalid records.
+/// @throws std::invalid_argument if the record length is smaller than the
+///         fixed header, the records are not a whole number of records, or
+///         the outputs are smaller than the number of records.
+/// @note Records are validated in bulk and never throw.  This does not
+///       allocate.
+size_t getRecordStartTimes(std::span<const std::byte> records,
+                           size_t recordLength,
+                           std::span<int64_t> startTimes,
+                           std::span<uint8_t> invalid,
+                           ByteOrder byteOrder = ByteOrder::BigEndian);
+}
+#endif
@@ -0,0 +1,235 @@
+#ifndef TIME_SORT_HPP
+#define TIME_SORT_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "time/utc.hpp"
+/// Stable sorts of times and of records keyed by a time.  Large inputs are
+/// radix sorted on the integer nanoseconds since the epoch, which is linear
+/// in the number of times.  Only the bits spanned by the times are
+/// visited.
+namespace Time::Sort
+{
+/// @brief Sorts times in increasing order.
+/// @param[in,out] times  The nanoseconds since the epoch to sort.
+void sort(std::span<int64_t> times);
+/// @brief Sorts times in increasing order.
+/// @param[in,out] times  The times to sort.
+void sort(std::span<UTC> times);
+/// @brief Stable sorts records in increasing order of time.
+/// @param[in,out] values  The records to sort.
+/// @param[in] key         Returns the time of a record as a \c UTC or as
+///                        nanoseconds since the epoch.
+/// @note T must be copyable.
+template<typename T, typename Key>
+void sort(std::span<T> values, Key &&key);
+/// @brief Stable sorts (time, payload) pairs in increasing order of time,
+///        e.g., Time::Sort::sort(std::span {picks}).
+/// @param[in,out] pairs  The pairs to sort.
+template<typename T>
+void sort(std::span<std::pair<UTC, T>> pairs);
+/// @brief Stable sorts (time, payload) pairs in increasing order of time.
+/// @param[in,out] pairs  The pairs to sort where the time is in nanoseconds
+///                       since the epoch.
+template<typename T>
+void sort(std::span<std::pair<int64_t, T>> pairs);
+}
+
+namespace Time::Internal
+{
+/// @result The nanoseconds since the epoch.
+[[nodiscard]] constexpr int64_t toSortKey(const int64_t time) noexcept
+{
+    return time;
+}
+[[nodiscard]] constexpr int64_t toSortKey(const UTC &time) noexcept
+{
+    return time.getEpochInNanoSeconds().count();
+}
+
+/// @brief Stable insertion sort of a few times.  Unlike std::stable_sort
+///        this does not allocate.
+template<typename T, typename IsLess>
+void insertionSort(T *values, const size_t n, const IsLess &isLess)
+{
+    for (size_t i = 1; i < n; ++i)
+    {
+        if (!isLess(values[i], values[i - 1])){continue;}
+        T value = std::move(values[i]);
+        auto j = i;
+        while (j > 0 && isLess(value, values[j - 1]))
+        {
+            values[j] = std::move(values[j - 1]);
+            j = j - 1;
+        }
+        values[j] = std::move(value);
+    }
+}
+
+/// @brief Stable MSD radix sort of a block on the low bits of the keys
+///        relative to the minimum key.  The higher bits are shared by every
+///        time in the block.  The block should fit in the cache.
+/// @param[in,out] source       The block.  On exit this is scratch space.
+/// @param[out] destination     The sorted block.
+/// @param[in] n                The number of times in the block.
+/// @param[in] nBits            The number of low bits on which to sort.
+template<typename T, typename GetOffset>
+void radixSortBlock(T *source, T *destination, const size_t n,
+                    int nBits, const GetOffset &getOffset)
+{
+    // Below this an insertion sort wins
+    constexpr size_t N_SMALL{32};
+    auto isLess = [&](const T &lhs, const T &rhs)
+    {
+        return getOffset(lhs) < getOffset(rhs);
+    };
+    if (n < N_SMALL || nBits == 0)
+    {
+        std::move(source, source + n, destination);
+        if (nBits > 0){insertionSort(destination, n, isLess);}
+        return;
+    }
+    // Size the digit so that a bucket holds about one time
+    const int radixBits = std::clamp(static_cast<int> (std::bit_width(n)),
+                                     8, 12);
+    const size_t nBuckets{size_t {1} << radixBits};
+    std::vector<size_t> offsets(nBuckets + 1);
+    int shift{0};
+    while (true)
+    {
+        shift = std::max(nBits - radixBits, 0);
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            offsets[((getOffset(source[i]) >> shift) & (nBuckets - 1)) + 1]
+                += 1;
+        }
+        // Skip digits shared by every time in the block
+        auto bucket = (getOffset(source[0]) >> shift) & (nBuckets - 1);
+        if (offsets[bucket + 1] != n){break;}
+        if (shift == 0)
+        {
+            std::move(source, source + n, destination);
+            return;
+        }
+        nBits = shift;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto bucket = (getOffset(source[i]) >> shift) & (nBuckets - 1);
+        destination[next[bucket]] = std::move(source[i]);
+        next[bucket] = next[bucket] + 1;
+    }
+    if (shift == 0){return;}
+    for (size_t bucket = 0; bucket < nBuckets; ++bucket)
+    {
+        auto start = offsets[bucket];
+        auto nInBucket = offsets[bucket + 1] - start;
+        if (nInBucket < 2){continue;}
+        if (nInBucket < N_SMALL)
+        {
+            insertionSort(destination + start, nInBucket, isLess);
+            continue;
+        }
+        radixSortBlock(destination + start, source + start, nInBucket,
+                       shift, getOffset);
+        std::move(source + start, source + start + nInBucket,
+                  destination + start);
+    }
+}
+
+/// @brief Stable radix sort on the int64 keys.  The first pass is a most
+///        significant digit pass on the key range that splits the input
+///        into cache-sized blocks.  Each block is then sorted in the cache.
+///        This avoids repeatedly scattering the entire input through
+///        memory.
+template<typename T, typename Key>
+void radixSort(std::span<T> values, const Key &key)
+{
+    constexpr int RADIX_BITS{11};
+    constexpr size_t N_BUCKETS{size_t {1} << RADIX_BITS};
+    // Below this std::stable_sort wins
+    constexpr size_t N_SMALL{512};
+    auto n = values.size();
+    auto getKey = [&](const T &value)
+    {
+        return toSortKey(key(value));
+    };
+    auto isLess = [&](const T &lhs, const T &rhs)
+    {
+        return getKey(lhs) < getKey(rhs);
+    };
+    // Pick tables are usually appended in time order
+    if (std::is_sorted(values.begin(), values.end(), isLess)){return;}
+    if (n < N_SMALL)
+    {
+        std::stable_sort(values.begin(), values.end(), isLess);
+        return;
+    }
+    // Sort on the offset from the earliest time so only the bits spanned
+    // by the times are visited
+    auto [first, last] = std::minmax_element(values.begin(), values.end(),
+                                             isLess);
+    auto minimum = static_cast<uint64_t> (getKey(*first));
+    auto range = static_cast<uint64_t> (getKey(*last)) - minimum;
+    auto getOffset = [&](const T &value)
+    {
+        return static_cast<uint64_t> (getKey(value)) - minimum;
+    };
+    auto nBits = static_cast<int> (std::bit_width(range));
+    auto shift = std::max(nBits - RADIX_BITS, 0);
+    std::vector<size_t> offsets(N_BUCKETS + 1, 0);
+    for (const auto &value : values)
+    {
+        offsets[(getOffset(value) >> shift) + 1] += 1;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<T> buffer(values.begin(), values.end());
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (auto &value : values)
+    {
+        auto bucket = getOffset(value) >> shift;
+        buffer[next[bucket]] = std::move(value);
+        next[bucket] = next[bucket] + 1;
+    }
+    for (size_t bucket = 0; bucket < N_BUCKETS; ++bucket)
+    {
+        auto start = offsets[bucket];
+        radixSortBlock(buffer.data() + start, values.data() + start,
+                       offsets[bucket + 1] - start, shift, getOffset);
+    }
+}
+}
+
+template<typename T, typename Key>
+void Time::Sort::sort(std::span<T> values, Key &&key)
+{
+    Internal::radixSort(values, key);
+}
+
+template<typename T>
+void Time::Sort::sort(std::span<std::pair<UTC, T>> pairs)
+{
+    Internal::radixSort(pairs, [](const std::pair<UTC, T> &pair)
+                               {
+                                   return pair.first;
+                               });
+}
+
+template<typename T>
+void Time::Sort::sort(std::span<std::pair<int64_t, T>> pairs)
+{
+    Internal::radixSort(pairs, [](const std::pair<int64_t, T> &pair)
+                               {
+                                   return pair.first;
+                               });
+}
+#endif
@@ -1,13 +1,45 @@
 #ifndef TIME_UTC_HPP
 #define TIME_UTC_HPP
+#include <version>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <atomic>
 #include <chrono>
-#include <memory>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "time/calendar.hpp"
+#include "time/expected.hpp"
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
 namespace Time
 {
+/// @brief An exact interval of time.  Coarser durations, e.g.,
+///        std::chrono::milliseconds {10}, convert to this implicitly.
+using Duration = std::chrono::nanoseconds;
 /// @class UTC "utc.hpp" "time/utc.hpp"
 /// @brief Defines a UTC time.
+/// @note This is a value type whose state is stored inline.  Construction,
+///       copying, and moving never allocate.  The canonical state is the
+///       integer number of nanoseconds since the epoch.  The calendar fields
+///       are only computed when a getter requests them and are then cached.
+/// @note Const access is thread safe.  Any number of threads may call the
+///       const member functions of, or copy, the same time concurrently
+///       without locking.  The calendar cache is a single word that is
+///       published atomically.  As with any value type, modifying a time
+///       while other threads access it is a data race.
+/// @note Each throwing setter has a trySet variant, and the string
+///       constructor has \c tryParse(), that instead returns the \c Error.
+///       These are cheaper when bad input is routine, e.g., corrupt packets.
+/// @note Construction from nanoseconds or a time stamp, the epoch getters,
+///       and the comparisons are constexpr.  Hence, fixed reference times
+///       can be written as, e.g., "2020-01-01T00:00:00"_utc and cost nothing
+///       at run time.
 /// @copyright Ben Baker (University of Utah) distributed under the MIT license.
 class UTC 
 {
@@ -15,28 +47,69 @@ public:
     /// @name Constructors
     /// @{
     /// @brief Constructor.
-    UTC();
+    constexpr UTC() noexcept = default;
     /// @brief Initializes this class from a time stamp.
     /// @param[in] time   The UTC time stamp measured in seconds from the epoch. 
+    /// @throws std::invalid_argument if the time is not finite or not in the
+    ///         years [1678,2261].
     /// @sa \c setEpoch()
     explicit UTC(double time);
     /// @brief Initializes this class from a time stamp.
-    /// @param[in] time   The UTC time stamp measured in microseconds from
-    ///                   the epoch. 
+    /// @param[in] time   The UTC time stamp measured in nanoseconds (or
+    ///                   any coarser duration, e.g., microseconds) from
+    ///                   the epoch.
     /// @sa \c setEpoch()
-    explicit UTC(const std::chrono::microseconds &time);
+    constexpr explicit UTC(const std::chrono::nanoseconds &time) noexcept :
+        mEpoch{time.count()}
+    {
+    }
     /// @brief Initializes a time from string-time stamp.
-    /// @param[in] time   The time stamp in YYYY-MM-DD:HH:MM:SS.XXXXXX form.
-    /// @throws std::invalid_argument if the string length is unexpected.
-    /// @note This can also parse YYYY-MM-DD:HH:MM:SS form.
-    explicit UTC(const std::string &time);
+    /// @param[in] time   The time stamp in YYYY-MM-DDTHH:MM:SS.XXXXXX form.
+    ///                   The fraction may have 0 to 9 digits, the T may be
+    ///                   a space, and a trailing Z is allowed.
+    /// @throws std::invalid_argument if the time stamp cannot be parsed or
+    ///         a field is out of range.  In a constant expression this is a
+    ///         compile error instead.
+    constexpr explicit UTC(const std::string_view time) :
+        mEpoch{std::is_constant_evaluated() ?
+               parseConstant(time) : parse(time)}
+    {
+    }
+    /// @brief Parses a time stamp without throwing.
+    /// @param[in] time   The time stamp in the same forms as the string
+    ///                   constructor.
+    /// @result The time or \c Error::InvalidTimeStamp.
+    [[nodiscard]] static Expected<UTC> tryParse(std::string_view time) noexcept;
+    /// @brief Creates a time from its calendar fields without throwing.
+    /// @param[in] year        The year which must be in [1678,2261].
+    /// @param[in] month       The month which must be in [1,12].
+    /// @param[in] dayOfMonth  The day of the month.
+    /// @param[in] hour        The hour which must be in [0,23].
+    /// @param[in] minute      The minute which must be in [0,59].
+    /// @param[in] second      The second which must be in [0,59].
+    /// @param[in] nanoSecond  The nanosecond which must be in [0,999999999].
+    /// @result The time or the error of the first field out of range.
+    [[nodiscard]] static Expected<UTC> fromComponents(int year, int month,
+                                                      int dayOfMonth,
+                                                      int hour = 0,
+                                                      int minute = 0,
+                                                      int second = 0,
+                                                      int nanoSecond = 0) noexcept;
     /// @brief Copy constructor.
     /// @param[in] time  The time class from which to initialize this class.
-    UTC(const UTC &time);
+    ///                  This may be concurrently read by other threads.
+    constexpr UTC(const UTC &time) noexcept :
+        mEpoch{time.mEpoch},
+        mCalendar{time.loadCalendar()}
+    {
+    }
     /// @brief Move constructor.
     /// @param[in,out] time  The time class from which to initialize this class.
-    ///                      On exit, location's behavior is undefined.
-    UTC(UTC &&time) noexcept;
+    ///                      On exit, time is unchanged and remains valid.
+    constexpr UTC(UTC &&time) noexcept :
+        UTC(static_cast<const UTC &> (time))
+    {
+    }
     /// @}
 
     /// @name Operators   
@@ -44,30 +117,87 @@ public:
     /// @brief Copy assignment operator.
     /// @param[in] time  The time class to copy to this.
     /// @result A deep copy of the input time.
-    UTC& operator=(const UTC &time);
+    constexpr UTC& operator=(const UTC &time) noexcept
+    {
+        mEpoch = time.mEpoch;
+        mCalendar = time.loadCalendar();
+        return *this;
+    }
     /// @brief Move assignment operator.
     /// @param[in,out] time  The time class whose memory will be moved to this.
+    ///                      On exit, time is unchanged and remains valid.
     /// @result The memory from time moved to this.
-    UTC& operator=(UTC &&time) noexcept;
+    constexpr UTC& operator=(UTC &&time) noexcept
+    {
+        return *this = static_cast<const UTC &> (time);
+    }
+    /// @brief Advances the time in place.
+    /// @param[in] duration  The duration to add.
+    /// @result The advanced time.
+    /// @note If the calendar fields are cached and the time stays on the
+    ///       same day, only the time of day in the cache is updated.
+    ///       Hence, advancing a time in a sliding window is nearly free.
+    UTC& operator+=(Duration duration) noexcept;
+    /// @brief Moves the time back in place.
+    /// @param[in] duration  The duration to subtract.
+    /// @result The earlier time.
+    /// @note See \c operator+=() for the handling of the calendar fields.
+    UTC& operator-=(Duration duration) noexcept;
     /// @}
      
     /// @brief Sets the time to now.
+    /// @note The time is read from the source selected with
+    ///       \c Clock::setSource().  The calendar fields are not computed
+    ///       until requested.
     void now() noexcept;
+    /// @result The current time measured in nanoseconds since the epoch
+    ///         (Jan 1 1970).  This is the cheapest way to time stamp, e.g.,
+    ///         packets since no \c UTC is created.
+    /// @sa \c Clock::setSource()
+    [[nodiscard]] static std::chrono::nanoseconds nowEpoch() noexcept;
 
     /// @brief Sets the seconds since the epoch.
     /// @param[in] timeStamp   The seconds since the epoch (Jan 1 1970).
-    void setEpoch(double timeStamp) noexcept;
-    /// @brief Sets the microseconds since the epoch.
-    void setEpoch(const std::chrono::microseconds &timeStamp) noexcept;
+    ///                        This is rounded to the nearest microsecond.
+    /// @throws std::invalid_argument if the time stamp is not finite or not
+    ///         in the years [1678,2261].
+    /// @note Every API that takes seconds as a double rounds them to the
+    ///       nearest microsecond.  A double near the present only resolves
+    ///       a fraction of a microsecond.
+    void setEpoch(double timeStamp);
+    /// @brief Sets the seconds since the epoch without throwing.  This is
+    ///        \c setEpoch() but a time stamp that is not finite or out of
+    ///        range leaves the time unchanged and returns
+    ///        Error::EpochOutOfRange.
+    [[nodiscard]] Expected<void> trySetEpoch(double timeStamp) noexcept;
+    /// @brief Sets the nanoseconds (or any coarser duration, e.g.,
+    ///        microseconds) since the epoch.
+    void setEpoch(const std::chrono::nanoseconds &timeStamp) noexcept;
     /// @result The seconds since the epoch (Jan 1 1970).
     [[nodiscard]] double getEpoch() const noexcept;
-    /// @result The microseconds since the epoch (Jan 1 1970).
-    [[nodiscard]] std::chrono::microseconds getEpochInMicroSeconds() const noexcept;
+    /// @result The microseconds since the epoch (Jan 1 1970).  This is
+    ///         rounded down to the nearest microsecond.
+    [[nodiscard]] constexpr std::chrono::microseconds getEpochInMicroSeconds() const noexcept
+    {
+        return std::chrono::microseconds{
+            Calendar::floorDivide(mEpoch,
+                                  Calendar::NANOSECONDS_PER_MICROSECOND)};
+    }
+    /// @result The nanoseconds since the epoch (Jan 1 1970).
+    [[nodiscard]] constexpr std::chrono::nanoseconds getEpochInNanoSeconds() const noexcept
+    {
+        return std::chrono::nanoseconds{mEpoch};
+    }
 
     /// @brief Sets the year in which to perform the calculation.
-    /// @param[in] year  The year which must be in the range [-1000,2999].
+    /// @param[in] year  The year which must be in the range [1678,2261]
+    ///                  so that the time is representable in nanoseconds.
     /// @throws std::invalid_argument if year is not in range.
     void setYear(int year);
+    /// @brief Sets the year without throwing.  This is \c setYear()
+    ///        but an out of range input leaves the time unchanged and
+    ///        returns Error::YearOutOfRange.
+    [[nodiscard]] Expected<void> trySetYear(int year) noexcept;
     /// @result The year in which to perform the calculation.
     [[nodiscard]] int getYear() const noexcept;
     /// @result True indicates the year is a leap year.
@@ -80,6 +210,11 @@ public:
     ///                         range of valid days for that month. 
     /// @note This will change the day of the year.
     void setMonthAndDay(const std::pair<int, int> &monthAndDay);
+    /// @brief Sets the month and day without throwing.  This is \c setMonthAndDay()
+    ///        but an out of range input leaves the time unchanged and
+    ///        returns Error::MonthOutOfRange or Error::DayOfMonthOutOfRange.
+    [[nodiscard]] Expected<void>
+        trySetMonthAndDay(const std::pair<int, int> &monthAndDay) noexcept;
     /// @result result.first is the month and result.second is the day of
     ///         the month.
     [[nodiscard]] std::pair<int, int> getMonthAndDay() const noexcept;
@@ -95,6 +230,10 @@ public:
     /// @throw std::invalid_argument if the day of the year is out of range.
     /// @note This will change the values of the month and day of the month.
     void setDayOfYear(int dayOfYear);
+    /// @brief Sets the day of the year without throwing.  This is \c setDayOfYear()
+    ///        but an out of range input leaves the time unchanged and
+    ///        returns Error::DayOfYearOutOfRange.
+    [[nodiscard]] Expected<void> trySetDayOfYear(int dayOfYear) noexcept;
     /// @result The day of the year.
     [[nodiscard]] int getDayOfYear() const noexcept;
    
@@ -102,6 +241,10 @@ public:
     /// @param[in] hour  The hour of the day.  This must be in the range [0,23].
     /// @throws std::invalid_argument if the hour is out of range.
     void setHour(int hour);
+    /// @brief Sets the hour without throwing.  This is \c setHour()
+    ///        but an out of range input leaves the time unchanged and
+    ///        returns Error::HourOutOfRange.
+    [[nodiscard]] Expected<void> trySetHour(int hour) noexcept;
     /// @result The hour of the day.
     [[nodiscard]] int getHour() const noexcept;
 
@@ -110,6 +253,10 @@ public:
     ///                    range [0,59].
     /// @throws std::invalid_argument if the minute is out of range.
     void setMinute(int minute);
+    /// @brief Sets the minute without throwing.  This is \c setMinute()
+    ///        but an out of range input leaves the time unchanged and
+    ///        returns Error::MinuteOutOfRange.
+    [[nodiscard]] Expected<void> trySetMinute(int minute) noexcept;
     /// @result The minute of the hour.
     [[nodiscard]] int getMinute() const noexcept;
 
@@ -118,6 +265,10 @@ public:
     ///                     range [0,59].
     /// @throws std::invalid_argument if the second is out of range. 
     void setSecond(int second);
+    /// @brief Sets the second without throwing.  This is \c setSecond()
+    ///        but an out of range input leaves the time unchanged and
+    ///        returns Error::SecondOutOfRange.
+    [[nodiscard]] Expected<void> trySetSecond(int second) noexcept;
     /// @result The second of the minute.
     [[nodiscard]] int getSecond() const noexcept;
 
@@ -125,63 +276,291 @@ public:
     /// @brief Sets the microsecond.
     /// @param[in] muSec   The additional microseconds to add to the second.
     ///                    This must be in the range [0, 999999].
+    /// @throws std::invalid_argument if the microsecond is out of range.
     void setMicroSecond(const int muSec);
+    /// @brief Sets the microsecond without throwing.  This is \c setMicroSecond()
+    ///        but an out of range input leaves the time unchanged and
+    ///        returns Error::MicroSecondOutOfRange.
+    [[nodiscard]] Expected<void> trySetMicroSecond(int muSec) noexcept;
     /// @result The microsecond to add to the second.
     [[nodiscard]] int getMicroSecond() const noexcept;
 
+    /// @brief Sets the nanosecond.
+    /// @param[in] nanoSec  The additional nanoseconds to add to the second.
+    ///                     This must be in the range [0, 999999999].
+    /// @throws std::invalid_argument if the nanosecond is out of range.
+    void setNanoSecond(int nanoSec);
+    /// @brief Sets the nanosecond without throwing.  This is \c setNanoSecond()
+    ///        but an out of range input leaves the time unchanged and
+    ///        returns Error::NanoSecondOutOfRange.
+    [[nodiscard]] Expected<void> trySetNanoSecond(int nanoSec) noexcept;
+    /// @result The nanosecond to add to the second.
+    [[nodiscard]] int getNanoSecond() const noexcept;
+
+    /// @brief The number of characters written by \c toChars().
+    static constexpr size_t ISO8601_LENGTH{26};
+    /// @brief Writes the time as YYYY-MM-DDTHH:MM:SS.SSSSSS.
+    /// @param[out] buffer  The buffer to write to.  This must have space for
+    ///                     at least \c ISO8601_LENGTH characters.  The result
+    ///                     is not null terminated.
+    /// @result A pointer to one past the last written character.
+    /// @note This does not allocate.
+    char *toChars(char *buffer) const noexcept;
+
     /// @name Destructors
     /// @{
     /// @brief Resets the class.
     void clear() noexcept;    
     /// @brief Destructor.
-    ~UTC();
+    ~UTC() = default;
     /// @}
 
     /// @brief Swaps two time classes.
     /// @param[in,out] lhs  Class to exchange with rhs.
     /// @param[in,out] rhs  Class to exchange with lhs.
-    friend void swap(UTC &lhs, UTC &rhs);
+    friend void swap(UTC &lhs, UTC &rhs) noexcept;
 private:
-    class UTCImpl;
-    std::unique_ptr<UTCImpl> pImpl;
+    /// Parses a time stamp with the fast run-time parser.
+    [[nodiscard]] static int64_t parse(std::string_view time);
+    /// Parses a time stamp one character at a time so that it may be
+    /// evaluated at compile time.  This accepts the same forms as parse().
+    [[nodiscard]] static constexpr int64_t parseConstant(std::string_view time);
+    /// @result The calendar cache.  This is an atomic load since const
+    ///         getters on other threads may be publishing it.
+    [[nodiscard]] constexpr uint64_t loadCalendar() const noexcept
+    {
+        if (std::is_constant_evaluated()){return mCalendar;}
+        return std::atomic_ref<uint64_t> (mCalendar).load(
+            std::memory_order_relaxed);
+    }
+    /// The nanoseconds since the epoch.
+    int64_t mEpoch{0};
+    /// The lazily computed calendar fields packed into a single word.
+    /// Zero indicates the fields have not yet been computed.  Const access
+    /// reads and writes this through std::atomic_ref.
+    alignas(std::atomic_ref<uint64_t>::required_alignment)
+    mutable uint64_t mCalendar{0};
 };
 /// @brief Swaps two time classes, lhs and rhs.
 /// @param[in,out] lhs  On exit this will contain the information in rhs.
 /// @param[in,out] rhs  On exit this will contain the information in lhs.
-void swap(UTC &lhs, UTC &rhs);
+inline void swap(UTC &lhs, UTC &rhs) noexcept
+{
+    std::swap(lhs, rhs);
+}
 /// @brief Computes the sum of two times a la: x + y.
 /// @param[in] x   The time.
 /// @param[in] y   The time to add to x.
 /// @result The sum of the two times: x + y.
-UTC operator+(const UTC &x, const UTC &y);
+constexpr UTC operator+(const UTC &x, const UTC &y) noexcept
+{
+    return UTC{x.getEpochInNanoSeconds() + y.getEpochInNanoSeconds()};
+}
+/// @brief Adds a duration to a time a la: x + y.
+/// @param[in] x   The time.
+/// @param[in] y   The duration to add to x.
+/// @result The sum of the time and the duration: x + y.
+inline UTC operator+(const UTC &x, const Duration y) noexcept
+{
+    UTC result{x};
+    result += y;
+    return result;
+}
+/// @brief Subtracts a duration from a time a la: x - y.
+/// @param[in] x   The time.
+/// @param[in] y   The duration to subtract from x.
+/// @result The difference of the time and the duration: x - y.
+inline UTC operator-(const UTC &x, const Duration y) noexcept
+{
+    UTC result{x};
+    result -= y;
+    return result;
+}
+/// @result The exact interval from rhs to lhs, i.e., lhs - rhs.
+/// @note Unlike x - y, which returns a UTC for backwards compatibility,
+///       this is an interval.
+[[nodiscard]] constexpr Duration difference(const UTC &lhs,
+                                            const UTC &rhs) noexcept
+{
+    return lhs.getEpochInNanoSeconds() - rhs.getEpochInNanoSeconds();
+}
 /// @brief Adds seconds to a time a la: x + y (seconds).
 /// @param[in] x   The time.
-/// @param[in] y   The number of seconds to add to x.
+/// @param[in] y   The number of seconds to add to x.  As with
+///                \c UTC::setEpoch(), this is rounded to the nearest
+///                microsecond.
 /// @result The sum of the time in x with the number of seconds in y: x + y.
+/// @throws std::invalid_argument if y is not finite or at least 9.2e9
+///         seconds in magnitude.
 UTC operator+(const UTC &x, double y); 
 /// @brief Computes the difference between two times a la: x - y.
 /// @param[in] x   The time.
 /// @param[in] y   The time to subtract from x.
 /// @result The difference between the two times: x - y.
-UTC operator-(const UTC &x, const UTC &y);
+constexpr UTC operator-(const UTC &x, const UTC &y) noexcept
+{
+    return UTC{x.getEpochInNanoSeconds() - y.getEpochInNanoSeconds()};
+}
 /// @brief Removes seconds from a time a la: x - y (seconds).
 /// @param[in] x   The time.
-/// @param[in] y   The number of seconds to subtract from to x.
+/// @param[in] y   The number of seconds to subtract from to x.  As with
+///                \c UTC::setEpoch(), this is rounded to the nearest
+///                microsecond.
 /// @result The difference between the time in x and the
 ///         number of seconds in y: x - y.
+/// @throws std::invalid_argument if y is not finite or at least 9.2e9
+///         seconds in magnitude.
 UTC operator-(const UTC &x, double y); 
-/// @result True indicates that lhs == rhs, i.e., the times are equal.
-bool operator==(const UTC &lhs, const UTC &rhs);
-/// @result True indicates that lhs != rhs, i.e., the times are not equal.
-bool operator!=(const UTC &lhs, const UTC &rhs);
-/// @result True indicates that lhs > rhs, i.e., the lhs is later than the rhs.
-bool operator>(const UTC &lhs, const UTC &rhs);
-/// @result True indicates that lhs < rhs, i.e, the lhs is earlier than the rhs.
-bool operator<(const UTC &lhs, const UTC &rhs);
+/// @result True indicates that lhs == rhs, i.e., the times are equal to
+///         the nanosecond.
+constexpr bool operator==(const UTC &lhs, const UTC &rhs) noexcept
+{
+    return lhs.getEpochInNanoSeconds() == rhs.getEpochInNanoSeconds();
+}
+/// @result The ordering of the times, e.g., less indicates the lhs is
+///         earlier than the rhs.  This also defines <, <=, >, and >=.
+constexpr std::strong_ordering operator<=>(const UTC &lhs,
+                                           const UTC &rhs) noexcept
+{
+    return lhs.getEpochInNanoSeconds().count()
+       <=> rhs.getEpochInNanoSeconds().count();
+}
 /// @brief Outputs a time as YYYY-MM-DDTHH:MM:SS.SSSSSS
 /// @param[in] os    An output stream object.
 /// @param[in] time  The time stamp
 /// @return A formatted time.
 std::ostream& operator<<(std::ostream &os, const UTC &time);
+
+constexpr int64_t UTC::parseConstant(const std::string_view time)
+{
+    auto digits = [&](const size_t position, const size_t length)
+    {
+        int result{0};
+        for (size_t i = position; i < position + length; ++i)
+        {
+            if (time[i] < '0' || time[i] > '9')
+            {
+                throw std::invalid_argument("Time stamp has a non-digit");
+            }
+            result = 10*result + (time[i] - '0');
+        }
+        return result;
+    };
+    if (time.size() < 19)
+    {
+        throw std::invalid_argument("Time stamp is too short");
+    }
+    if (time[4] != '-' || time[7] != '-' || time[13] != ':' || time[16] != ':')
+    {
+        throw std::invalid_argument("Time stamp has a bad separator");
+    }
+    if (time[10] != 'T' && time[10] != ' ')
+    {
+        throw std::invalid_argument("Time stamp has a bad date-time separator");
+    }
+    auto year = digits(0, 4);
+    auto month = digits(5, 2);
+    auto dayOfMonth = digits(8, 2);
+    auto hour = digits(11, 2);
+    auto minute = digits(14, 2);
+    auto second = digits(17, 2);
+    int64_t nanoSecond{0};
+    size_t i{19};
+    if (i < time.size() && time[i] == '.')
+    {
+        i = i + 1;
+        int64_t scale{Calendar::NANOSECONDS_PER_SECOND};
+        auto first = i;
+        while (i < time.size() && time[i] >= '0' && time[i] <= '9')
+        {
+            if (i - first == 9)
+            {
+                throw std::invalid_argument("Fraction has more than 9 digits");
+            }
+            scale = scale/10;
+            nanoSecond = nanoSecond + (time[i] - '0')*scale;
+            i = i + 1;
+        }
+        if (i == first){throw std::invalid_argument("Fraction is empty");}
+    }
+    if (i < time.size() && time[i] == 'Z'){i = i + 1;}
+    if (i != time.size())
+    {
+        throw std::invalid_argument("Time stamp has trailing characters");
+    }
+    if (year < Calendar::MINIMUM_YEAR || year > Calendar::MAXIMUM_YEAR)
+    {
+        throw std::invalid_argument("Year must be in range [1678,2261]");
+    }
+    if (month < 1 || month > 12)
+    {
+        throw std::invalid_argument("Month must be in range [1,12]");
+    }
+    if (dayOfMonth < 1 || dayOfMonth > Calendar::daysInMonth(year, month))
+    {
+        throw std::invalid_argument("Day of month is out of range");
+    }
+    if (hour > 23){throw std::invalid_argument("Hour must be in range [0,23]");}
+    if (minute > 59)
+    {
+        throw std::invalid_argument("Minute must be in range [0,59]");
+    }
+    if (second > 59)
+    {
+        throw std::invalid_argument("Second must be in range [0,59]");
+    }
+    return Calendar::toEpoch(year, month, dayOfMonth,
+                             hour, minute, second, nanoSecond);
+}
+
+namespace Literals
+{
+/// @brief Creates a time from a time stamp at compile time, e.g.,
+///        using namespace Time::Literals;
+///        constexpr auto gpsEpoch = "1980-01-06T00:00:00"_utc;
+/// @param[in] time    The time stamp in YYYY-MM-DDTHH:MM:SS.XXXXXX form.
+///                    The fraction may have 0 to 9 digits, the T may be a
+///                    space, and a trailing Z is allowed.
+/// @param[in] length  The length of the time stamp.
+/// @result The time.  A malformed time stamp is a compile error.
+consteval UTC operator""_utc(const char *time, const size_t length)
+{
+    return UTC{std::string_view{time, length}};
 }
+}
+}
+
+/// @brief Hashes a time on its nanoseconds since the epoch so that, e.g.,
+///        times can key a std::unordered_map.
+/// @note Sample times share their low bits, e.g., they are multiples of
+///       10 ms, so the key is mixed (the splitmix64 finalizer) rather than
+///       used as is.
+template<>
+struct std::hash<Time::UTC>
+{
+    [[nodiscard]] size_t operator()(const Time::UTC &time) const noexcept
+    {
+        auto key = static_cast<uint64_t> (time.getEpochInNanoSeconds().count());
+        key = (key ^ (key >> 30))*0xBF58476D1CE4E5B9ULL;
+        key = (key ^ (key >> 27))*0x94D049BB133111EBULL;
+        return static_cast<size_t> (key ^ (key >> 31));
+    }
+};
+
+#if defined(__cpp_lib_format)
+/// @brief Formats a time as YYYY-MM-DDTHH:MM:SS.SSSSSS with std::format.
+///        The standard string format specifications, e.g., width, apply.
+template<>
+struct std::formatter<Time::UTC, char> : std::formatter<std::string_view, char>
+{
+    template<typename FormatContext>
+    auto format(const Time::UTC &time, FormatContext &context) const
+    {
+        char buffer[Time::UTC::ISO8601_LENGTH];
+        time.toChars(buffer);
+        return std::formatter<std::string_view, char>::format(
+            std::string_view(buffer, Time::UTC::ISO8601_LENGTH), context);
+    }
+};
+#endif
 #endif
@@ -0,0 +1,34 @@
+#ifndef TIME_VERSION_HPP
+#define TIME_VERSION_HPP
+#include <string>
+#define TIME_MAJOR 1
+#define TIME_MINOR 0
+#define TIME_PATCH 1
+#define TIME_VERSION "1.0.1"
+namespace Time
+{
+/// @class Version version.hpp "time/version.hpp"
+/// @brief Defines library's version information.
+/// @copyright Ben Baker (University of Utah) distributed under the MIT license.
+class Version
+{
+public:
+    /// @result The API's major version number.
+    [[nodiscard]] static int getMajor() noexcept;
+    /// @result The API's minor version number.
+    [[nodiscard]] static int getMinor() noexcept;
+    /// @result The API's patch version number.
+    [[nodiscard]] static int getPatch() noexcept;
+    /// @result The full version number as a string, e.g., "1.2.3".
+    [[nodiscard]] static std::string getVersion() noexcept;
+    /// @brief Determines if the version is greater than or equal to
+    ///        the current (major, minor, patch).
+    /// @param[in] major  The major version number.
+    /// @param[in] minor  The minor version number.
+    /// @param[in] patch  The patch number.
+    /// @result True indicates that the version is at least equal to the
+    ///         given major, minor, patch.
+    [[nodiscard]] static bool isAtLeast(int major, int minor, int patch) noexcept;
+};
+}
+#endif
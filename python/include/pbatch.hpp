@@ -0,0 +1,9 @@
+#ifndef PTIME_BATCH_HPP
+#define PTIME_BATCH_HPP
+#include <pybind11/pybind11.h>
+namespace PTime
+{
+/// Adds the module-level functions that convert NumPy arrays of times.
+void initializeBatch(pybind11::module &m);
+}
+#endif
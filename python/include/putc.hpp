@@ -1,5 +1,6 @@
 #ifndef PTIME_UTC_HPP
 #define PTIME_UTC_HPP
+#include <cstdint>
 #include <memory>
 #include <pybind11/pybind11.h>
 namespace Time
@@ -37,6 +38,13 @@ public:
     void setEpoch(double epoch);
     [[nodiscard]] double getEpoch() const;
 
+    void setEpochInNanoSeconds(int64_t epoch);
+    [[nodiscard]] int64_t getEpochInNanoSeconds() const;
+
+    /// Conversions to and from datetime.datetime.  Naive datetimes are UTC.
+    [[nodiscard]] static UTC fromDateTime(const pybind11::handle &dateTime);
+    [[nodiscard]] pybind11::object toDateTime() const;
+
     void setYear(int year);
     [[nodiscard]] int getYear() const;
 
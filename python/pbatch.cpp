@@ -0,0 +1,546 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <time/batch.hpp>
+#include <time/utc.hpp>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include "include/pbatch.hpp"
+
+namespace py = pybind11;
+
+namespace
+{
+/// Contiguous arrays of the matching dtype are used without a copy.
+using Int64Array = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+using Int32Array = py::array_t<int32_t, py::array::c_style | py::array::forcecast>;
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// The number of rows formatted at a time when writing strings.
+constexpr size_t BLOCK_SIZE{4096};
+
+/// Throws if any row is invalid.
+void checkInvalid(const size_t nInvalid, const size_t firstInvalid,
+                  const char *what)
+{
+    if (nInvalid == 0){return;}
+    throw std::invalid_argument(std::to_string(nInvalid) + " " + what
+                              + " could not be converted; the first is row "
+                              + std::to_string(firstInvalid));
+}
+
+/// The epochs as integer nanoseconds.  Seconds are rounded to the nearest
+/// microsecond as in UTC.epoch.
+/// @throws std::invalid_argument if an epoch is not finite or not in the
+///         years [1678,2261].
+/// @note This must be called without the GIL.
+void toNanoSeconds(const double *seconds, const size_t n,
+                   std::vector<int64_t> &nanoSeconds)
+{
+    nanoSeconds.resize(n);
+    size_t nInvalid{0};
+    size_t firstInvalid{0};
+    Time::UTC time;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (time.trySetEpoch(seconds[i]))
+        {
+            nanoSeconds[i] = time.getEpochInNanoSeconds().count();
+        }
+        else
+        {
+            if (nInvalid == 0){firstInvalid = i;}
+            nInvalid = nInvalid + 1;
+        }
+    }
+    checkInvalid(nInvalid, firstInvalid, "epochs");
+}
+
+/// The epochs as seconds.
+/// @note This must be called without the GIL.
+void toSeconds(const int64_t *nanoSeconds, const size_t n, double *seconds)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        seconds[i] = Time::UTC{std::chrono::nanoseconds {nanoSeconds[i]}}.getEpoch();
+    }
+}
+
+/// Throws if any row was invalid.
+void checkInvalid(const size_t nInvalid, const std::vector<uint8_t> &invalid,
+                  const char *what)
+{
+    if (nInvalid == 0){return;}
+    auto row = std::distance(invalid.begin(),
+                             std::find(invalid.begin(), invalid.end(), 1));
+    checkInvalid(nInvalid, static_cast<size_t> (row), what);
+}
+
+/// The number of nanoseconds in one tick of a datetime64 dtype, e.g.,
+/// 1000 for datetime64[us] and 10000000 for datetime64[10ms].
+int64_t getNanoSecondsPerTick(const py::dtype &dtype)
+{
+    if (dtype.kind() != 'M')
+    {
+        throw std::invalid_argument("Array must have a datetime64 dtype");
+    }
+    auto name = py::str(dtype.attr("str")).cast<std::string> ();
+    auto open = name.find('[');
+    auto close = name.find(']');
+    if (open == std::string::npos || close == std::string::npos)
+    {
+        throw std::invalid_argument("datetime64 dtype must have a unit");
+    }
+    std::string_view unit{name.data() + open + 1, close - open - 1};
+    int64_t count{1};
+    auto firstLetter = unit.find_first_not_of("0123456789");
+    if (firstLetter == std::string_view::npos)
+    {
+        throw std::invalid_argument("Malformed datetime64 unit " + name);
+    }
+    if (firstLetter > 0)
+    {
+        count = std::stoll(std::string {unit.substr(0, firstLetter)});
+    }
+    unit.remove_prefix(firstLetter);
+    int64_t nanoSeconds{0};
+    if (unit == "ns"){nanoSeconds = 1;}
+    else if (unit == "us"){nanoSeconds = 1000;}
+    else if (unit == "ms"){nanoSeconds = 1000000;}
+    else if (unit == "s"){nanoSeconds = 1000000000;}
+    else if (unit == "m"){nanoSeconds = 60000000000;}
+    else if (unit == "h"){nanoSeconds = 3600000000000;}
+    else if (unit == "D"){nanoSeconds = 86400000000000;}
+    else if (unit == "W"){nanoSeconds = 7*86400000000000;}
+    else
+    {
+        throw std::invalid_argument("Unsupported datetime64 unit " + name);
+    }
+    int64_t result{0};
+    if (__builtin_mul_overflow(count, nanoSeconds, &result))
+    {
+        throw std::invalid_argument("datetime64 unit is too large");
+    }
+    return result;
+}
+
+/// Returns the epochs as seconds or nanoseconds.
+py::array toEpochArray(const std::vector<int64_t> &epochs,
+                       const bool nanoSeconds)
+{
+    auto n = static_cast<py::ssize_t> (epochs.size());
+    if (nanoSeconds)
+    {
+        Int64Array result(n);
+        std::copy(epochs.begin(), epochs.end(), result.mutable_data());
+        return result;
+    }
+    DoubleArray result(n);
+    auto resultPointer = result.mutable_data();
+    {
+    py::gil_scoped_release release;
+    toSeconds(epochs.data(), epochs.size(), resultPointer);
+    }
+    return result;
+}
+
+/// Epochs to calendar columns
+py::tuple epochsToCalendar(const py::object &epochs, const bool nanoSeconds)
+{
+    // Read the nanoseconds directly or convert the seconds
+    std::optional<Int64Array> nanoSecondArray;
+    std::optional<DoubleArray> secondArray;
+    py::ssize_t n{0};
+    if (nanoSeconds)
+    {
+        nanoSecondArray = epochs.cast<Int64Array> ();
+        n = nanoSecondArray->size();
+    }
+    else
+    {
+        secondArray = epochs.cast<DoubleArray> ();
+        n = secondArray->size();
+    }
+    Int32Array year(n), dayOfYear(n), month(n), dayOfMonth(n),
+               hour(n), minute(n), second(n), microSecond(n);
+    auto size = static_cast<size_t> (n);
+    Time::Batch::CalendarColumns calendar
+    {
+        {year.mutable_data(), size},
+        {dayOfYear.mutable_data(), size},
+        {month.mutable_data(), size},
+        {dayOfMonth.mutable_data(), size},
+        {hour.mutable_data(), size},
+        {minute.mutable_data(), size},
+        {second.mutable_data(), size},
+        {microSecond.mutable_data(), size}
+    };
+    const int64_t *epochPointer{nullptr};
+    const double *secondPointer{nullptr};
+    if (nanoSeconds)
+    {
+        epochPointer = nanoSecondArray->data();
+    }
+    else
+    {
+        secondPointer = secondArray->data();
+    }
+    {
+    py::gil_scoped_release release;
+    std::vector<int64_t> work;
+    if (!nanoSeconds)
+    {
+        toNanoSeconds(secondPointer, size, work);
+        epochPointer = work.data();
+    }
+    Time::Batch::toCalendar(std::span<const int64_t> {epochPointer, size},
+                            calendar);
+    // The sub-second was written as nanoseconds
+    for (auto &value : calendar.nanoSecond){value = value/1000;}
+    }
+    return py::make_tuple(year, dayOfYear, month, dayOfMonth,
+                          hour, minute, second, microSecond);
+}
+
+/// Calendar columns to epochs
+template<bool useDayOfYear>
+py::array calendarToEpochs(const Int32Array &year,
+                           const Int32Array &day,
+                           const std::optional<Int32Array> &month,
+                           const Int32Array &hour,
+                           const Int32Array &minute,
+                           const Int32Array &second,
+                           const std::optional<Int32Array> &microSecond,
+                           const bool nanoSeconds)
+{
+    auto n = static_cast<size_t> (year.size());
+    auto toSpan = [](const Int32Array &array)
+    {
+        return std::span<const int32_t> {array.data(),
+                                         static_cast<size_t> (array.size())};
+    };
+    Time::Batch::ConstCalendarColumns calendar;
+    calendar.year = toSpan(year);
+    if constexpr (useDayOfYear)
+    {
+        calendar.dayOfYear = toSpan(day);
+    }
+    else
+    {
+        calendar.month = toSpan(*month);
+        calendar.dayOfMonth = toSpan(day);
+    }
+    calendar.hour = toSpan(hour);
+    calendar.minute = toSpan(minute);
+    calendar.second = toSpan(second);
+    if (microSecond){calendar.microSecond = toSpan(*microSecond);}
+    std::vector<int64_t> epochs(n);
+    std::vector<uint8_t> invalid(n);
+    size_t nInvalid{0};
+    {
+    py::gil_scoped_release release;
+    if constexpr (useDayOfYear)
+    {
+        nInvalid = Time::Batch::fromDayOfYear(calendar, epochs, invalid);
+    }
+    else
+    {
+        nInvalid = Time::Batch::fromMonthAndDay(calendar, epochs, invalid);
+    }
+    }
+    checkInvalid(nInvalid, invalid, "rows");
+    return toEpochArray(epochs, nanoSeconds);
+}
+
+/// ISO-8601 strings to epochs
+py::array stringsToEpochs(const py::object &times, const bool nanoSeconds)
+{
+    std::vector<std::string_view> views;
+    // Storage for strings that cannot be viewed in place
+    std::vector<char> characters;
+    std::vector<std::string> strings;
+    // Keeps a contiguous copy of the array alive while it is viewed
+    py::object owner;
+    if (py::isinstance<py::array> (times))
+    {
+        auto array = py::array::ensure(times, py::array::c_style);
+        if (!array){throw std::invalid_argument("Array must be contiguous");}
+        owner = array;
+        auto kind = array.dtype().kind();
+        auto n = static_cast<size_t> (array.size());
+        auto itemSize = static_cast<size_t> (array.itemsize());
+        views.resize(n);
+        if (kind == 'S')
+        {
+            // Bytes are viewed in place.  NumPy pads with nulls.
+            auto data = static_cast<const char *> (array.data());
+            for (size_t i = 0; i < n; ++i)
+            {
+                std::string_view view{data + i*itemSize, itemSize};
+                views[i] = view.substr(0, view.find('\0'));
+            }
+        }
+        else if (kind == 'U')
+        {
+            // Unicode is UCS-4.  Anything outside of ASCII is invalid.
+            auto length = itemSize/4;
+            auto data = static_cast<const uint32_t *> (array.data());
+            characters.resize(n*length);
+            {
+            py::gil_scoped_release release;
+            for (size_t i = 0; i < n; ++i)
+            {
+                size_t nCharacters{0};
+                for ( ; nCharacters < length; ++nCharacters)
+                {
+                    auto c = data[i*length + nCharacters];
+                    if (c == 0){break;}
+                    characters[i*length + nCharacters]
+                        = c < 128 ? static_cast<char> (c) : '\x7f';
+                }
+                views[i] = std::string_view {characters.data() + i*length,
+                                             nCharacters};
+            }
+            }
+        }
+        else
+        {
+            throw std::invalid_argument("Array must have a string dtype");
+        }
+    }
+    else
+    {
+        for (const auto &time : times){strings.push_back(time.cast<std::string> ());}
+        views.assign(strings.begin(), strings.end());
+    }
+    auto n = views.size();
+    std::vector<int64_t> epochs(n);
+    std::vector<uint8_t> invalid(n);
+    size_t nInvalid{0};
+    {
+    py::gil_scoped_release release;
+    nInvalid = Time::Batch::fromStrings(views, epochs, invalid);
+    }
+    checkInvalid(nInvalid, invalid, "times");
+    return toEpochArray(epochs, nanoSeconds);
+}
+
+/// Epochs to ISO-8601 strings
+py::array epochsToStrings(const py::object &epochs, const bool nanoSeconds)
+{
+    std::optional<Int64Array> nanoSecondArray;
+    std::optional<DoubleArray> secondArray;
+    const int64_t *epochPointer{nullptr};
+    const double *secondPointer{nullptr};
+    size_t n{0};
+    if (nanoSeconds)
+    {
+        nanoSecondArray = epochs.cast<Int64Array> ();
+        epochPointer = nanoSecondArray->data();
+        n = static_cast<size_t> (nanoSecondArray->size());
+    }
+    else
+    {
+        secondArray = epochs.cast<DoubleArray> ();
+        secondPointer = secondArray->data();
+        n = static_cast<size_t> (secondArray->size());
+    }
+    constexpr auto length = Time::UTC::ISO8601_LENGTH;
+    py::array result(py::dtype("<U" + std::to_string(length)),
+                     {static_cast<py::ssize_t> (n)});
+    auto output = static_cast<uint32_t *> (result.mutable_data());
+    {
+    py::gil_scoped_release release;
+    std::vector<int64_t> work;
+    if (!nanoSeconds)
+    {
+        toNanoSeconds(secondPointer, n, work);
+        epochPointer = work.data();
+    }
+    // Format blocks then widen to UCS-4
+    std::vector<char> buffer((length + 1)*BLOCK_SIZE);
+    for (size_t i0 = 0; i0 < n; i0 = i0 + BLOCK_SIZE)
+    {
+        auto nBlock = std::min(BLOCK_SIZE, n - i0);
+        Time::Batch::toColumn(std::span<const int64_t> {epochPointer + i0,
+                                                        nBlock},
+                              '\n', buffer);
+        for (size_t i = 0; i < nBlock; ++i)
+        {
+            auto row = buffer.data() + i*(length + 1);
+            auto outputRow = output + (i0 + i)*length;
+            for (size_t j = 0; j < length; ++j)
+            {
+                outputRow[j] = static_cast<uint32_t> (row[j]);
+            }
+        }
+    }
+    }
+    return result;
+}
+
+/// datetime64 to epochs
+py::array datetime64ToEpochs(const py::array &times, const bool nanoSeconds)
+{
+    auto nanoSecondsPerTick = getNanoSecondsPerTick(times.dtype());
+    auto ticks = py::array::ensure(times, py::array::c_style);
+    if (!ticks){throw std::invalid_argument("Array must be contiguous");}
+    auto n = static_cast<size_t> (ticks.size());
+    auto data = static_cast<const int64_t *> (ticks.data());
+    // Nanosecond ticks already are the epochs once NaT is ruled out
+    if (nanoSecondsPerTick == 1 && nanoSeconds)
+    {
+        size_t nInvalid{0};
+        size_t firstInvalid{0};
+        {
+        py::gil_scoped_release release;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (data[i] == std::numeric_limits<int64_t>::lowest())
+            {
+                if (nInvalid == 0){firstInvalid = i;}
+                nInvalid = nInvalid + 1;
+            }
+        }
+        }
+        checkInvalid(nInvalid, firstInvalid, "times");
+        return ticks.attr("view")("int64").cast<py::array> ();
+    }
+    std::vector<int64_t> epochs(n);
+    size_t nInvalid{0};
+    std::vector<uint8_t> invalid(n, 0);
+    {
+    py::gil_scoped_release release;
+    for (size_t i = 0; i < n; ++i)
+    {
+        // NaT is the smallest int64
+        if (data[i] == std::numeric_limits<int64_t>::lowest() ||
+            __builtin_mul_overflow(data[i], nanoSecondsPerTick, &epochs[i]))
+        {
+            invalid[i] = 1;
+            nInvalid = nInvalid + 1;
+        }
+    }
+    }
+    checkInvalid(nInvalid, invalid, "times");
+    return toEpochArray(epochs, nanoSeconds);
+}
+
+/// Epochs to datetime64
+py::array epochsToDateTime64(const py::object &epochs, const std::string &unit,
+                             const bool nanoSeconds)
+{
+    py::dtype dtype("datetime64[" + unit + "]");
+    auto nanoSecondsPerTick = getNanoSecondsPerTick(dtype);
+    std::optional<Int64Array> nanoSecondArray;
+    std::optional<DoubleArray> secondArray;
+    const int64_t *epochPointer{nullptr};
+    const double *secondPointer{nullptr};
+    size_t n{0};
+    if (nanoSeconds)
+    {
+        nanoSecondArray = epochs.cast<Int64Array> ();
+        // Nanosecond epochs already are the ticks
+        if (nanoSecondsPerTick == 1)
+        {
+            return nanoSecondArray->attr("view")(dtype).cast<py::array> ();
+        }
+        epochPointer = nanoSecondArray->data();
+        n = static_cast<size_t> (nanoSecondArray->size());
+    }
+    else
+    {
+        secondArray = epochs.cast<DoubleArray> ();
+        secondPointer = secondArray->data();
+        n = static_cast<size_t> (secondArray->size());
+    }
+    py::array result(dtype, {static_cast<py::ssize_t> (n)});
+    auto output = static_cast<int64_t *> (result.mutable_data());
+    {
+    py::gil_scoped_release release;
+    std::vector<int64_t> work;
+    if (!nanoSeconds)
+    {
+        toNanoSeconds(secondPointer, n, work);
+        epochPointer = work.data();
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        // Round toward negative infinity
+        auto tick = epochPointer[i]/nanoSecondsPerTick;
+        if (tick*nanoSecondsPerTick > epochPointer[i]){tick = tick - 1;}
+        output[i] = tick;
+    }
+    }
+    return result;
+}
+}
+
+/// Creates the module-level functions
+void PTime::initializeBatch(pybind11::module &m)
+{
+    m.def("epochs_to_calendar",
+          &epochsToCalendar,
+          py::arg("epochs"),
+          py::arg("nanoseconds") = false,
+          "Converts an array of epochs to calendar columns.  The epochs are seconds since the epoch (Jan 1, 1970) or, if nanoseconds is True, integer nanoseconds since the epoch.  The result is the tuple of int32 arrays (year, day_of_year, month, day_of_month, hour, minute, second, microsecond).  Contiguous float64 (int64) arrays are read without a copy and the GIL is released during the conversion.  A ValueError is raised if any epoch in seconds is not finite or not in the years [1678,2261].");
+    m.def("calendar_to_epochs",
+          [](const Int32Array &year, const Int32Array &month,
+             const Int32Array &dayOfMonth, const Int32Array &hour,
+             const Int32Array &minute, const Int32Array &second,
+             const std::optional<Int32Array> &microSecond,
+             const bool nanoSeconds)
+          {
+              return calendarToEpochs<false>(year, dayOfMonth, month, hour,
+                                             minute, second, microSecond,
+                                             nanoSeconds);
+          },
+          py::arg("year"), py::arg("month"), py::arg("day_of_month"),
+          py::arg("hour"), py::arg("minute"), py::arg("second"),
+          py::arg("microsecond") = py::none(),
+          py::arg("nanoseconds") = false,
+          "Converts arrays of the year, month, day of month, hour, minute, second, and, optionally, microsecond to epochs.  The result is seconds since the epoch or, if nanoseconds is True, int64 nanoseconds since the epoch.  Contiguous int32 arrays are read without a copy and the GIL is released during the conversion.  A ValueError is raised if any row is invalid.");
+    m.def("day_of_year_to_epochs",
+          [](const Int32Array &year, const Int32Array &dayOfYear,
+             const Int32Array &hour, const Int32Array &minute,
+             const Int32Array &second,
+             const std::optional<Int32Array> &microSecond,
+             const bool nanoSeconds)
+          {
+              return calendarToEpochs<true>(year, dayOfYear, std::nullopt,
+                                            hour, minute, second,
+                                            microSecond, nanoSeconds);
+          },
+          py::arg("year"), py::arg("day_of_year"),
+          py::arg("hour"), py::arg("minute"), py::arg("second"),
+          py::arg("microsecond") = py::none(),
+          py::arg("nanoseconds") = false,
+          "Converts arrays of the year, day of year, hour, minute, second, and, optionally, microsecond to epochs.  The result is seconds since the epoch or, if nanoseconds is True, int64 nanoseconds since the epoch.  A ValueError is raised if any row is invalid.");
+    m.def("strings_to_epochs",
+          &stringsToEpochs,
+          py::arg("times"),
+          py::arg("nanoseconds") = false,
+          "Parses ISO-8601 time stamps of the form YYYY-MM-DDTHH:MM:SS[.f][Z] to epochs.  The times may be a NumPy bytes or str array or a sequence of str.  Bytes arrays are read without a copy.  The result is seconds since the epoch or, if nanoseconds is True, int64 nanoseconds since the epoch.  A ValueError is raised if any time cannot be parsed.");
+    m.def("epochs_to_strings",
+          &epochsToStrings,
+          py::arg("epochs"),
+          py::arg("nanoseconds") = false,
+          "Formats an array of epochs as a str array of time stamps with the format YYYY-MM-DDTHH:MM:SS.SSSSSS.  The epochs are seconds since the epoch or, if nanoseconds is True, integer nanoseconds since the epoch.  A ValueError is raised if any epoch in seconds is not finite or not in the years [1678,2261].");
+    m.def("datetime64_to_epochs",
+          &datetime64ToEpochs,
+          py::arg("times"),
+          py::arg("nanoseconds") = false,
+          "Converts a datetime64 array with a unit from weeks to nanoseconds to epochs.  The result is seconds since the epoch or, if nanoseconds is True, int64 nanoseconds since the epoch.  A contiguous datetime64[ns] array converted to nanoseconds is returned as a view without a copy.  A ValueError is raised for NaT or times that overflow.");
+    m.def("epochs_to_datetime64",
+          &epochsToDateTime64,
+          py::arg("epochs"),
+          py::arg("unit") = "us",
+          py::arg("nanoseconds") = false,
+          "Converts epochs to a datetime64 array with the given unit, e.g., us or ns.  Times are rounded down to the unit.  The epochs are seconds since the epoch or, if nanoseconds is True, integer nanoseconds since the epoch.  Contiguous int64 nanoseconds converted to datetime64[ns] are returned as a view without a copy.  A ValueError is raised if any epoch in seconds is not finite or not in the years [1678,2261].");
+}
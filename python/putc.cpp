@@ -1,6 +1,10 @@
-#include <sstream>
+#include <chrono>
+#include <string>
+#include <stdexcept>
 #include <time/utc.hpp>
 #include "include/putc.hpp"
+// Python.h must precede the datetime C API
+#include <datetime.h>
 
 using namespace PTime;
 
@@ -104,6 +108,71 @@ double UTC::getEpoch() const
     return mTime->getEpoch();
 }
 
+/// Get/Set epoch in nanoseconds
+void UTC::setEpochInNanoSeconds(const int64_t time)
+{
+    mTime->setEpoch(std::chrono::nanoseconds {time});
+}
+
+int64_t UTC::getEpochInNanoSeconds() const
+{
+    return mTime->getEpochInNanoSeconds().count();
+}
+
+/// From datetime.datetime
+UTC UTC::fromDateTime(const pybind11::handle &dateTime)
+{
+    if (!PyDateTimeAPI){PyDateTime_IMPORT;}
+    if (!PyDateTimeAPI){throw pybind11::error_already_set();}
+    if (!PyDateTime_Check(dateTime.ptr()))
+    {
+        throw std::invalid_argument("Time must be a datetime.datetime");
+    }
+    auto object = dateTime.ptr();
+    auto year = PyDateTime_GET_YEAR(object);
+    if (year < 1678 || year > 2261)
+    {
+        throw std::invalid_argument("Year must be in range [1678,2261]");
+    }
+    std::chrono::year_month_day date{
+        std::chrono::year {year},
+        std::chrono::month {static_cast<unsigned int> (PyDateTime_GET_MONTH(object))},
+        std::chrono::day {static_cast<unsigned int> (PyDateTime_GET_DAY(object))}};
+    auto epoch = std::chrono::duration_cast<std::chrono::nanoseconds>
+                 (std::chrono::sys_days {date}.time_since_epoch())
+               + std::chrono::hours {PyDateTime_DATE_GET_HOUR(object)}
+               + std::chrono::minutes {PyDateTime_DATE_GET_MINUTE(object)}
+               + std::chrono::seconds {PyDateTime_DATE_GET_SECOND(object)}
+               + std::chrono::microseconds {PyDateTime_DATE_GET_MICROSECOND(object)};
+    // Aware datetimes are shifted to UTC
+    auto offset = dateTime.attr("utcoffset")();
+    if (!offset.is_none())
+    {
+        auto delta = offset.ptr();
+        epoch = epoch
+              - std::chrono::days {PyDateTime_DELTA_GET_DAYS(delta)}
+              - std::chrono::seconds {PyDateTime_DELTA_GET_SECONDS(delta)}
+              - std::chrono::microseconds {PyDateTime_DELTA_GET_MICROSECONDS(delta)};
+    }
+    return UTC{Time::UTC {epoch}};
+}
+
+/// To a naive datetime.datetime in UTC
+pybind11::object UTC::toDateTime() const
+{
+    if (!PyDateTimeAPI){PyDateTime_IMPORT;}
+    if (!PyDateTimeAPI){throw pybind11::error_already_set();}
+    auto result = PyDateTime_FromDateAndTime(mTime->getYear(),
+                                             mTime->getMonth(),
+                                             mTime->getDayOfMonth(),
+                                             mTime->getHour(),
+                                             mTime->getMinute(),
+                                             mTime->getSecond(),
+                                             mTime->getMicroSecond());
+    if (result == nullptr){throw pybind11::error_already_set();}
+    return pybind11::reinterpret_steal<pybind11::object> (result);
+}
+
 /// Get/Set Year
 void UTC::setYear(const int year)
 {
@@ -189,9 +258,9 @@ int UTC::getMicroSecond() const
 /// Converts a time to string
 std::string UTC::toString() const noexcept
 {
-    std::stringstream ss;
-    ss << *mTime;
-    return ss.str();
+    std::string result(Time::UTC::ISO8601_LENGTH, '\0');
+    mTime->toChars(result.data());
+    return result;
 }
 
 /// Creates the class
@@ -225,7 +294,11 @@ void PTime::initializeUTC(pybind11::module &m)
     time.def_property("epoch",
                       &PTime::UTC::getEpoch,
                       &PTime::UTC::setEpoch,
-                      "The UTC time in seconds since the epoch (Jan 1, 1970).");
+                      "The UTC time in seconds since the epoch (Jan 1, 1970).  This is rounded to the nearest microsecond and must be finite and in the years [1678,2261].");
+    time.def_property("epoch_ns",
+                      &PTime::UTC::getEpochInNanoSeconds,
+                      &PTime::UTC::setEpochInNanoSeconds,
+                      "The UTC time in integer nanoseconds since the epoch (Jan 1, 1970).  Unlike epoch this is exact.");
     time.def_property("year",
                       &PTime::UTC::getYear,
                       &PTime::UTC::setYear, 
@@ -266,6 +339,12 @@ void PTime::initializeUTC(pybind11::module &m)
     time.def("now",
              &PTime::UTC::now,
              "Sets the UTC time to now.");
+    time.def_static("from_datetime",
+                    &PTime::UTC::fromDateTime,
+                    "Creates a time from a datetime.datetime.  A naive datetime is interpreted as UTC and an aware datetime is converted to UTC.");
+    time.def("to_datetime",
+             &PTime::UTC::toDateTime,
+             "Converts the time to a naive datetime.datetime in UTC.  The time is truncated to the microsecond.");
     time.def("to_string",
              &PTime::UTC::toString,
              "Converts a time to a string representation with the format: YYYY-MM-DDTHH:MM::SS.SSSSSS");
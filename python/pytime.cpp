@@ -1,4 +1,5 @@
 #include "include/putc.hpp"
+#include "include/pbatch.hpp"
 #include <time/version.hpp>
 #include <pybind11/pybind11.h>
 
@@ -8,4 +9,5 @@ PYBIND11_MODULE(pytime, m)
     m.attr("__doc__") = "A toolkit for manipulating UTC time.";
 
     PTime::initializeUTC(m);
+    PTime::initializeBatch(m);
 }
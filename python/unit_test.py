@@ -1,4 +1,6 @@
 #!/usr/bin/env python3
+import datetime
+import numpy as np
 import pytime
 
 def test_utc():
@@ -77,8 +79,124 @@ def test_utc():
     assert tsub.second == 8, 'get second failed - sub double'
     assert tsub.microsecond == 900000, 'get micro_second failed - sub double'
 
+def test_batch():
+    """
+    Tests the vectorized conversions.
+    """
+    epochs = np.array([1578528728.8, 0.0, 1336403638.000100, -1.5])
+    year, day_of_year, month, day_of_month, hour, minute, second, microsecond \
+        = pytime.epochs_to_calendar(epochs)
+    for i, epoch in enumerate(epochs):
+        t = pytime.UTC()
+        t.epoch = epoch
+        assert year[i] == t.year, 'year failed'
+        assert day_of_year[i] == t.day_of_year, 'day of year failed'
+        assert month[i] == t.month, 'month failed'
+        assert day_of_month[i] == t.day_of_month, 'day of month failed'
+        assert hour[i] == t.hour, 'hour failed'
+        assert minute[i] == t.minute, 'minute failed'
+        assert second[i] == t.second, 'second failed'
+        assert microsecond[i] == t.microsecond, 'microsecond failed'
+    assert year.dtype == np.int32, 'calendar dtype failed'
+    # Integer nanoseconds
+    nanoseconds = np.array([1578528728800000123], dtype = np.int64)
+    columns = pytime.epochs_to_calendar(nanoseconds, nanoseconds = True)
+    assert columns[0][0] == 2020, 'nanosecond year failed'
+    assert columns[7][0] == 800000, 'nanosecond microsecond failed'
+    # And back
+    result = pytime.calendar_to_epochs(year, month, day_of_month,
+                                       hour, minute, second, microsecond)
+    assert np.allclose(result, epochs, atol = 1.e-7, rtol = 0), 'calendar to epochs failed'
+    result = pytime.day_of_year_to_epochs(year, day_of_year,
+                                          hour, minute, second, microsecond,
+                                          nanoseconds = True)
+    assert result.dtype == np.int64, 'nanosecond dtype failed'
+    assert result[0] == 1578528728800000000, 'day of year to epochs failed'
+    try:
+        pytime.calendar_to_epochs([2020], [2], [30], [0], [0], [0])
+        assert False, 'invalid day not detected'
+    except ValueError:
+        pass
+    # Strings
+    strings = pytime.epochs_to_strings(epochs)
+    assert strings[0] == "2020-01-09T00:12:08.800000", 'epochs to strings failed'
+    assert strings[3] == "1969-12-31T23:59:58.500000", 'negative epoch failed'
+    result = pytime.strings_to_epochs(strings)
+    assert np.allclose(result, epochs, atol = 1.e-7, rtol = 0), 'strings to epochs failed'
+    result = pytime.strings_to_epochs(strings.astype('S'), nanoseconds = True)
+    assert result[0] == 1578528728800000000, 'bytes to epochs failed'
+    result = pytime.strings_to_epochs(["2020-01-09T00:12:08.8Z"])
+    assert abs(result[0] - 1578528728.8) < 1.e-7, 'list to epochs failed'
+    try:
+        pytime.strings_to_epochs(["2020-01-09T25:12:08"])
+        assert False, 'invalid string not detected'
+    except ValueError:
+        pass
+    # Epochs that are not finite or out of range
+    for bad in [np.nan, np.inf, -np.inf, 1.e300]:
+        epochs = np.array([0.0, bad])
+        for convert in [pytime.epochs_to_calendar, pytime.epochs_to_strings,
+                        pytime.epochs_to_datetime64]:
+            try:
+                convert(epochs)
+                assert False, 'invalid epoch not detected'
+            except ValueError:
+                pass
+    try:
+        t = pytime.UTC()
+        t.epoch = np.nan
+        assert False, 'NaN epoch not detected'
+    except ValueError:
+        pass
+
+def test_datetime():
+    """
+    Tests the conversions to and from datetime64 and datetime.
+    """
+    times = np.array(['2020-01-09T00:12:08.800000123', '1969-12-31T23:59:58.5'],
+                     dtype = 'datetime64[ns]')
+    nanoseconds = pytime.datetime64_to_epochs(times, nanoseconds = True)
+    assert nanoseconds[0] == 1578528728800000123, 'datetime64[ns] to epochs failed'
+    assert nanoseconds[1] == -1500000000, 'negative datetime64 failed'
+    nanoseconds[1] = 0
+    assert times[1] == np.datetime64(0, 'ns'), 'view should share memory'
+    epochs = pytime.datetime64_to_epochs(times.astype('datetime64[us]'))
+    assert abs(epochs[0] - 1578528728.8) < 1.e-7, 'datetime64[us] to epochs failed'
+    result = pytime.epochs_to_datetime64(np.array([1578528728.8, -1.5]))
+    assert result.dtype == np.dtype('datetime64[us]'), 'dtype failed'
+    assert result[0] == np.datetime64('2020-01-09T00:12:08.800000'), 'epochs to datetime64 failed'
+    assert result[1] == np.datetime64('1969-12-31T23:59:58.500000'), 'negative epochs to datetime64 failed'
+    result = pytime.epochs_to_datetime64(np.array([-1], dtype = np.int64),
+                                         unit = 's', nanoseconds = True)
+    assert result[0] == np.datetime64(-1, 's'), 'floor to unit failed'
+    try:
+        pytime.datetime64_to_epochs(np.array(['NaT'], dtype = 'datetime64[ns]'))
+        assert False, 'NaT not detected'
+    except ValueError:
+        pass
+    try:
+        pytime.datetime64_to_epochs(np.array(['2020-01-09', 'NaT'], dtype = 'datetime64[ns]'),
+                                    nanoseconds = True)
+        assert False, 'NaT not detected in view'
+    except ValueError:
+        pass
+    # Scalars
+    t = pytime.UTC.from_datetime(datetime.datetime(2020, 1, 9, 0, 12, 8, 800000))
+    assert t.epoch_ns == 1578528728800000000, 'from datetime failed'
+    assert t.to_datetime() == datetime.datetime(2020, 1, 9, 0, 12, 8, 800000), 'to datetime failed'
+    mountain = datetime.timezone(datetime.timedelta(hours = -7))
+    t = pytime.UTC.from_datetime(datetime.datetime(2020, 1, 8, 17, 12, 8, 800000,
+                                                   tzinfo = mountain))
+    assert t.epoch_ns == 1578528728800000000, 'aware datetime failed'
+    t.epoch_ns = 1578528728800000999
+    assert t.microsecond == 800000, 'epoch_ns failed'
+
 if __name__ == "__main__":
     print(pytime.__doc__ + " v:" + pytime.__version__)
     print(pytime.UTC().__doc__)
     test_utc() 
     print("Passed UTC test")
+    test_batch()
+    print("Passed batch test")
+    test_datetime()
+    print("Passed datetime test")
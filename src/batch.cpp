@@ -0,0 +1,1024 @@
+#include <algorithm>
+#include <string>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include "time/batch.hpp"
+#include "time/calendar.hpp"
+#include "simd.hpp"
+#include "iso8601.hpp"
+
+using namespace Time;
+
+namespace
+{
+
+/// The number of times processed per block.
+constexpr size_t BLOCK_SIZE{512};
+
+/// Pointers to the start of the output columns for a block.
+struct Output
+{
+    int32_t *year;
+    int32_t *dayOfYear;
+    int32_t *month;
+    int32_t *dayOfMonth;
+    int32_t *hour;
+    int32_t *minute;
+    int32_t *second;
+};
+
+/// Pointers to the start of the input columns for a block.
+struct Input
+{
+    const int32_t *year;
+    const int32_t *dayOfYear;
+    const int32_t *month;
+    const int32_t *dayOfMonth;
+    const int32_t *hour;
+    const int32_t *minute;
+    const int32_t *second;
+};
+
+/// The days from 1970-01-01 to Jan 1 of the year for years in
+/// [1678,2261].  Combining comparison masks does not vectorize well so
+/// this is computed arithmetically.
+template<typename I>
+[[gnu::always_inline]] inline I daysToJanuary1(const I &year) noexcept
+{
+    using namespace SIMD;
+    auto previousYear = year - 1;
+    auto era = divide<400>(previousYear);
+    auto yoe = previousYear - era*400;
+    return era*146097 + yoe*365 + (yoe >> 2) - divide<100>(yoe)
+         + 306 - 719468;
+}
+
+/// The days from 1970-01-01 to the first of the month for years in
+/// [1677,2262].  This is H. Hinnant's days_from_civil algorithm.
+template<typename I>
+[[gnu::always_inline]] inline I daysToFirstOfMonth(const I &year,
+                                                   const I &month) noexcept
+{
+    using namespace SIMD;
+    auto y = year - toOne<I>(month <= 2);
+    auto era = divide<400>(y);
+    auto yoe = y - era*400;
+    auto mp = select<I>(month > 2, month - 3, month + 9);
+    auto doy = divide<5>(mp*153 + 2);
+    auto doe = yoe*365 + (yoe >> 2) - divide<100>(yoe) + doy;
+    return era*146097 + doe - 719468;
+}
+
+/// The date of LANES<I> days since the epoch.
+template<typename I>
+struct Civil
+{
+    I year;
+    I month;
+    I dayOfMonth;
+};
+
+/// Branch-free civil-from-days.  This follows H. Hinnant's civil_from_days
+/// algorithm on days in the range of int64 nanoseconds.
+template<typename I>
+[[gnu::always_inline]] inline Civil<I> civilFromDays(const I &days) noexcept
+{
+    using namespace SIMD;
+    // Since days >= -106752 the shifted day is positive.
+    auto z = days + 719468;
+    auto era = divide<146097>(z);
+    auto doe = z - era*146097;
+    auto yoe = divide<365>(doe - divide<1460>(doe) + divide<36524>(doe)
+                         - toOne<I>(doe == 146096));
+    auto doyMarch = doe - (yoe*365 + (yoe >> 2) - divide<100>(yoe));
+    auto mp = divide<153>(doyMarch*5 + 2);
+    auto dayOfMonth = doyMarch - divide<5>(mp*153 + 2) + 1;
+    auto month = select<I>(mp < 10, mp + 3, mp - 9);
+    auto year = yoe + era*400 + toOne<I>(month <= 2);
+    return Civil<I>{year, month, dayOfMonth};
+}
+
+/// Branch-free civil-from-days and time-of-day decomposition of
+/// LANES<I> times at index i.
+template<typename I>
+[[gnu::always_inline]] inline
+void toCalendarKernel(const int32_t *days, const int32_t *secondOfDay,
+                      const Output &output, const size_t i) noexcept
+{
+    using namespace SIMD;
+    // Date
+    auto day = load<I>(days + i);
+    auto [year, month, dayOfMonth] = civilFromDays<I>(day);
+    auto dayOfYear = day - daysToJanuary1<I>(year) + 1;
+    // Time of day
+    auto sod = load<I>(secondOfDay + i);
+    auto hour = divide<3600>(sod);
+    auto secondOfHour = sod - hour*3600;
+    auto minute = divide<60>(secondOfHour);
+    auto second = secondOfHour - minute*60;
+    store<I>(year, output.year + i);
+    store<I>(dayOfYear, output.dayOfYear + i);
+    store<I>(month, output.month + i);
+    store<I>(dayOfMonth, output.dayOfMonth + i);
+    store<I>(hour, output.hour + i);
+    store<I>(minute, output.minute + i);
+    store<I>(second, output.second + i);
+}
+
+/// Runs the kernel over n elements with vectors of type I and finishes
+/// the remainder with scalars.
+template<typename I>
+[[gnu::always_inline]] inline
+void toCalendarLoop(const int32_t *days, const int32_t *secondOfDay,
+                    const Output &output, const size_t n) noexcept
+{
+    constexpr auto lanes = static_cast<size_t> (SIMD::LANES<I>);
+    size_t i = 0;
+    for ( ; i + lanes <= n; i = i + lanes)
+    {
+        toCalendarKernel<I>(days, secondOfDay, output, i);
+    }
+    for ( ; i < n; ++i)
+    {
+        toCalendarKernel<int32_t>(days, secondOfDay, output, i);
+    }
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+[[gnu::target("avx512f")]]
+void toCalendarAVX512(const int32_t *days, const int32_t *secondOfDay,
+                      const Output &output, const size_t n) noexcept
+{
+    toCalendarLoop<SIMD::Int32x16>(days, secondOfDay, output, n);
+}
+
+[[gnu::target("avx2")]]
+void toCalendarAVX2(const int32_t *days, const int32_t *secondOfDay,
+                    const Output &output, const size_t n) noexcept
+{
+    toCalendarLoop<SIMD::Int32x8>(days, secondOfDay, output, n);
+}
+#endif
+
+void toCalendarScalar(const int32_t *days, const int32_t *secondOfDay,
+                      const Output &output, const size_t n) noexcept
+{
+    toCalendarLoop<int32_t>(days, secondOfDay, output, n);
+}
+
+/// Branch-free validation and days-from-civil conversion of LANES<I>
+/// times at index i.  Out of range fields are replaced by safe values
+/// and flagged in bad.
+template<typename I, bool useDayOfYear>
+[[gnu::always_inline]] inline
+void fromCalendarKernel(const Input &input, int32_t *days,
+                        int32_t *secondOfDay, int32_t *bad,
+                        const size_t i) noexcept
+{
+    using namespace SIMD;
+    const auto zero = broadcast<I>(0);
+    const auto one = broadcast<I>(1);
+    auto year = load<I>(input.year + i);
+    auto badYear = toOne<I>(year < Calendar::MINIMUM_YEAR)
+                 + toOne<I>(year > Calendar::MAXIMUM_YEAR);
+    year = select<I>(badYear == zero, year, broadcast<I>(1970));
+    // Since 400 | year implies 100 | year implies 4 | year this is 0 or 1
+    auto isLeap = toOne<I>((year & 3) == zero)
+                - toOne<I>(year - divide<100>(year)*100 == zero)
+                + toOne<I>(year - divide<400>(year)*400 == zero);
+    I daysSinceEpoch;
+    I badDate;
+    if constexpr (useDayOfYear)
+    {
+        auto dayOfYear = load<I>(input.dayOfYear + i);
+        badDate = toOne<I>(dayOfYear < 1) + toOne<I>(dayOfYear > isLeap + 365);
+        dayOfYear = select<I>(badDate == zero, dayOfYear, one);
+        daysSinceEpoch = daysToJanuary1<I>(year) + dayOfYear - 1;
+    }
+    else
+    {
+        auto month = load<I>(input.month + i);
+        auto dayOfMonth = load<I>(input.dayOfMonth + i);
+        auto badMonth = toOne<I>(month < 1) + toOne<I>(month > 12);
+        month = select<I>(badMonth == zero, month, one);
+        // 28 + 2 bits per month packed into a constant
+        auto daysInMonth = 28 + ((broadcast<I>(0x3BBEECC) >> (month*2)) & 3)
+                         + toOne<I>(month == 2)*isLeap;
+        auto badDay = toOne<I>(dayOfMonth < 1)
+                    + toOne<I>(dayOfMonth > daysInMonth);
+        dayOfMonth = select<I>(badDay == zero, dayOfMonth, one);
+        badDate = badMonth + badDay;
+        // H. Hinnant's days_from_civil
+        auto yearFromMarch = year - toOne<I>(month <= 2);
+        auto era = divide<400>(yearFromMarch);
+        auto yoe = yearFromMarch - era*400;
+        auto mp = select<I>(month > 2, month - 3, month + 9);
+        auto doy = divide<5>(mp*153 + 2) + dayOfMonth - 1;
+        auto doe = yoe*365 + (yoe >> 2) - divide<100>(yoe) + doy;
+        daysSinceEpoch = era*146097 + doe - 719468;
+    }
+    auto hour = load<I>(input.hour + i);
+    auto minute = load<I>(input.minute + i);
+    auto second = load<I>(input.second + i);
+    auto badTime = toOne<I>(hour < 0) + toOne<I>(hour > 23)
+                 + toOne<I>(minute < 0) + toOne<I>(minute > 59)
+                 + toOne<I>(second < 0) + toOne<I>(second > 59);
+    auto isGoodTime = badTime == zero;
+    auto sod = select<I>(isGoodTime, hour, zero)*3600
+             + select<I>(isGoodTime, minute, zero)*60
+             + select<I>(isGoodTime, second, zero);
+    store<I>(daysSinceEpoch, days + i);
+    store<I>(sod, secondOfDay + i);
+    store<I>(badYear + badDate + badTime, bad + i);
+}
+
+template<typename I, bool useDayOfYear>
+[[gnu::always_inline]] inline
+void fromCalendarLoop(const Input &input, int32_t *days,
+                      int32_t *secondOfDay, int32_t *bad,
+                      const size_t n) noexcept
+{
+    constexpr auto lanes = static_cast<size_t> (SIMD::LANES<I>);
+    size_t i = 0;
+    for ( ; i + lanes <= n; i = i + lanes)
+    {
+        fromCalendarKernel<I, useDayOfYear>(input, days, secondOfDay, bad, i);
+    }
+    for ( ; i < n; ++i)
+    {
+        fromCalendarKernel<int32_t, useDayOfYear>(input, days, secondOfDay,
+                                                  bad, i);
+    }
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+template<bool useDayOfYear>
+[[gnu::target("avx512f")]]
+void fromCalendarAVX512(const Input &input, int32_t *days,
+                        int32_t *secondOfDay, int32_t *bad,
+                        const size_t n) noexcept
+{
+    fromCalendarLoop<SIMD::Int32x16, useDayOfYear>(input, days, secondOfDay,
+                                                   bad, n);
+}
+
+template<bool useDayOfYear>
+[[gnu::target("avx2")]]
+void fromCalendarAVX2(const Input &input, int32_t *days,
+                      int32_t *secondOfDay, int32_t *bad,
+                      const size_t n) noexcept
+{
+    fromCalendarLoop<SIMD::Int32x8, useDayOfYear>(input, days, secondOfDay,
+                                                  bad, n);
+}
+#endif
+
+template<bool useDayOfYear>
+void fromCalendarScalar(const Input &input, int32_t *days,
+                        int32_t *secondOfDay, int32_t *bad,
+                        const size_t n) noexcept
+{
+    fromCalendarLoop<int32_t, useDayOfYear>(input, days, secondOfDay, bad, n);
+}
+
+template<typename T>
+void checkColumn(const std::span<T> &column, const size_t n,
+                 const char *name)
+{
+    if (column.size() < n)
+    {
+        throw std::invalid_argument(std::string {name} + " column size = "
+                                  + std::to_string(column.size())
+                                  + " must be at least "
+                                  + std::to_string(n));
+    }
+}
+
+}
+
+/// Epochs to calendar
+void Batch::toCalendar(const std::span<const int64_t> epochs,
+                       const CalendarColumns &calendar)
+{
+    auto n = epochs.size();
+    checkColumn(calendar.year, n, "Year");
+    checkColumn(calendar.dayOfYear, n, "Day of year");
+    checkColumn(calendar.month, n, "Month");
+    checkColumn(calendar.dayOfMonth, n, "Day of month");
+    checkColumn(calendar.hour, n, "Hour");
+    checkColumn(calendar.minute, n, "Minute");
+    checkColumn(calendar.second, n, "Second");
+    checkColumn(calendar.nanoSecond, n, "Nanosecond");
+    [[maybe_unused]] auto instructionSet = SIMD::getInstructionSet();
+    std::array<int32_t, BLOCK_SIZE> days;
+    std::array<int32_t, BLOCK_SIZE> secondOfDay;
+    for (size_t i0 = 0; i0 < n; i0 = i0 + BLOCK_SIZE)
+    {
+        auto nBlock = std::min(BLOCK_SIZE, n - i0);
+        // Split the 64-bit epochs into days, seconds of the day, and
+        // nanoseconds.  The divisions by constants reduce to multiplies.
+        for (size_t i = 0; i < nBlock; ++i)
+        {
+            auto epoch = epochs[i0 + i];
+            auto day = Calendar::floorDivide(epoch, Calendar::NANOSECONDS_PER_DAY);
+            // Wraps at the extremes of int64 but the remainder is exact
+            auto nanoSecondOfDay
+                = static_cast<uint64_t> (epoch)
+                - static_cast<uint64_t> (day)
+                 *static_cast<uint64_t> (Calendar::NANOSECONDS_PER_DAY);
+            auto second = static_cast<uint32_t>
+                (nanoSecondOfDay/static_cast<uint64_t> (Calendar::NANOSECONDS_PER_SECOND));
+            days[i] = static_cast<int32_t> (day);
+            secondOfDay[i] = static_cast<int32_t> (second);
+            calendar.nanoSecond[i0 + i] = static_cast<int32_t>
+                (nanoSecondOfDay - second*static_cast<uint64_t> (Calendar::NANOSECONDS_PER_SECOND));
+        }
+        Output output{calendar.year.data() + i0,
+                      calendar.dayOfYear.data() + i0,
+                      calendar.month.data() + i0,
+                      calendar.dayOfMonth.data() + i0,
+                      calendar.hour.data() + i0,
+                      calendar.minute.data() + i0,
+                      calendar.second.data() + i0};
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        if (instructionSet == SIMD::InstructionSet::AVX512)
+        {
+            toCalendarAVX512(days.data(), secondOfDay.data(), output, nBlock);
+            continue;
+        }
+        if (instructionSet == SIMD::InstructionSet::AVX2)
+        {
+            toCalendarAVX2(days.data(), secondOfDay.data(), output, nBlock);
+            continue;
+        }
+#endif
+        toCalendarScalar(days.data(), secondOfDay.data(), output, nBlock);
+    }
+}
+
+namespace
+{
+/// Calendar to epochs
+template<bool useDayOfYear>
+size_t fromCalendar(const Batch::ConstCalendarColumns &calendar,
+                    const std::span<int64_t> epochs,
+                    const std::span<uint8_t> invalid)
+{
+    auto n = calendar.year.size();
+    if constexpr (useDayOfYear)
+    {
+        checkColumn(calendar.dayOfYear, n, "Day of year");
+    }
+    else
+    {
+        checkColumn(calendar.month, n, "Month");
+        checkColumn(calendar.dayOfMonth, n, "Day of month");
+    }
+    checkColumn(calendar.hour, n, "Hour");
+    checkColumn(calendar.minute, n, "Minute");
+    checkColumn(calendar.second, n, "Second");
+    checkColumn(epochs, n, "Epoch");
+    checkColumn(invalid, n, "Invalid");
+    if (!calendar.microSecond.empty() && !calendar.nanoSecond.empty())
+    {
+        throw std::invalid_argument(
+           "Only one of the microsecond or nanosecond columns can be set");
+    }
+    const int32_t *subSecond = nullptr;
+    int64_t subSecondScale{1};
+    int32_t maximumSubSecond{0};
+    if (!calendar.microSecond.empty())
+    {
+        checkColumn(calendar.microSecond, n, "Microsecond");
+        subSecond = calendar.microSecond.data();
+        subSecondScale = Calendar::NANOSECONDS_PER_MICROSECOND;
+        maximumSubSecond = 999999;
+    }
+    else if (!calendar.nanoSecond.empty())
+    {
+        checkColumn(calendar.nanoSecond, n, "Nanosecond");
+        subSecond = calendar.nanoSecond.data();
+        maximumSubSecond = 999999999;
+    }
+    [[maybe_unused]] auto instructionSet = SIMD::getInstructionSet();
+    std::array<int32_t, BLOCK_SIZE> days;
+    std::array<int32_t, BLOCK_SIZE> secondOfDay;
+    std::array<int32_t, BLOCK_SIZE> bad;
+    size_t nInvalid = 0;
+    for (size_t i0 = 0; i0 < n; i0 = i0 + BLOCK_SIZE)
+    {
+        auto nBlock = std::min(BLOCK_SIZE, n - i0);
+        Input input{calendar.year.data() + i0,
+                    useDayOfYear ? calendar.dayOfYear.data() + i0 : nullptr,
+                    useDayOfYear ? nullptr : calendar.month.data() + i0,
+                    useDayOfYear ? nullptr : calendar.dayOfMonth.data() + i0,
+                    calendar.hour.data() + i0,
+                    calendar.minute.data() + i0,
+                    calendar.second.data() + i0};
+        bool done = false;
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        if (instructionSet == SIMD::InstructionSet::AVX512)
+        {
+            fromCalendarAVX512<useDayOfYear>(input, days.data(),
+                                             secondOfDay.data(), bad.data(),
+                                             nBlock);
+            done = true;
+        }
+        else if (instructionSet == SIMD::InstructionSet::AVX2)
+        {
+            fromCalendarAVX2<useDayOfYear>(input, days.data(),
+                                           secondOfDay.data(), bad.data(),
+                                           nBlock);
+            done = true;
+        }
+#endif
+        if (!done)
+        {
+            fromCalendarScalar<useDayOfYear>(input, days.data(),
+                                             secondOfDay.data(), bad.data(),
+                                             nBlock);
+        }
+        // Assemble the 64-bit epochs
+        for (size_t i = 0; i < nBlock; ++i)
+        {
+            int32_t fraction = 0;
+            if (subSecond != nullptr){fraction = subSecond[i0 + i];}
+            auto isBad = (bad[i] != 0)
+                       | (fraction < 0)
+                       | (fraction > maximumSubSecond);
+            auto epoch = days[i]*Calendar::NANOSECONDS_PER_DAY
+                       + secondOfDay[i]*Calendar::NANOSECONDS_PER_SECOND
+                       + fraction*subSecondScale;
+            epochs[i0 + i] = isBad ? 0 : epoch;
+            invalid[i0 + i] = static_cast<uint8_t> (isBad);
+            nInvalid = nInvalid + static_cast<size_t> (isBad);
+        }
+    }
+    return nInvalid;
+}
+
+}
+
+size_t Batch::fromMonthAndDay(const ConstCalendarColumns &calendar,
+                              const std::span<int64_t> epochs,
+                              const std::span<uint8_t> invalid)
+{
+    return ::fromCalendar<false>(calendar, epochs, invalid);
+}
+
+size_t Batch::fromDayOfYear(const ConstCalendarColumns &calendar,
+                            const std::span<int64_t> epochs,
+                            const std::span<uint8_t> invalid)
+{
+    return ::fromCalendar<true>(calendar, epochs, invalid);
+}
+
+size_t Batch::fromStrings(const std::span<const std::string_view> times,
+                          const std::span<int64_t> epochs,
+                          const std::span<uint8_t> invalid)
+{
+    auto n = times.size();
+    checkColumn(epochs, n, "Epoch");
+    checkColumn(invalid, n, "Invalid");
+    size_t nInvalid = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        int64_t epoch = 0;
+        auto isBad = !ISO8601::parse(times[i], epoch);
+        epochs[i] = isBad ? 0 : epoch;
+        invalid[i] = static_cast<uint8_t> (isBad);
+        nInvalid = nInvalid + static_cast<size_t> (isBad);
+    }
+    return nInvalid;
+}
+
+size_t Batch::fromColumn(const std::string_view column,
+                         const char delimiter,
+                         const std::span<int64_t> epochs,
+                         const std::span<uint8_t> invalid)
+{
+    size_t nRows = 0;
+    size_t start = 0;
+    while (start < column.size())
+    {
+        auto end = column.find(delimiter, start);
+        if (end == std::string_view::npos){end = column.size();}
+        auto row = column.substr(start, end - start);
+        if (!row.empty() && row.back() == '\r'){row.remove_suffix(1);}
+        if (nRows >= epochs.size() || nRows >= invalid.size())
+        {
+            throw std::invalid_argument("Outputs have fewer than "
+                                      + std::to_string(nRows + 1) + " rows");
+        }
+        int64_t epoch = 0;
+        auto isBad = !ISO8601::parse(row, epoch);
+        epochs[nRows] = isBad ? 0 : epoch;
+        invalid[nRows] = static_cast<uint8_t> (isBad);
+        nRows = nRows + 1;
+        start = end + 1;
+    }
+    return nRows;
+}
+
+size_t Batch::toColumn(const std::span<const int64_t> epochs,
+                       const char delimiter,
+                       const std::span<char> buffer)
+{
+    constexpr size_t rowLength{ISO8601::LENGTH + 1};
+    auto n = epochs.size();
+    if (buffer.size() < rowLength*n)
+    {
+        throw std::invalid_argument("Buffer size = "
+                                  + std::to_string(buffer.size())
+                                  + " must be at least "
+                                  + std::to_string(rowLength*n));
+    }
+    std::array<int32_t, BLOCK_SIZE> year;
+    std::array<int32_t, BLOCK_SIZE> dayOfYear;
+    std::array<int32_t, BLOCK_SIZE> month;
+    std::array<int32_t, BLOCK_SIZE> dayOfMonth;
+    std::array<int32_t, BLOCK_SIZE> hour;
+    std::array<int32_t, BLOCK_SIZE> minute;
+    std::array<int32_t, BLOCK_SIZE> second;
+    std::array<int32_t, BLOCK_SIZE> nanoSecond;
+    auto output = buffer.data();
+    for (size_t i0 = 0; i0 < n; i0 = i0 + BLOCK_SIZE)
+    {
+        auto nBlock = std::min(BLOCK_SIZE, n - i0);
+        CalendarColumns calendar{year, dayOfYear, month, dayOfMonth,
+                                 hour, minute, second, nanoSecond};
+        toCalendar(epochs.subspan(i0, nBlock), calendar);
+        for (size_t i = 0; i < nBlock; ++i)
+        {
+            output = ISO8601::format(output, year[i], month[i],
+                                     dayOfMonth[i], hour[i], minute[i],
+                                     second[i], nanoSecond[i]/1000);
+            *output = delimiter;
+            output = output + 1;
+        }
+    }
+    return static_cast<size_t> (output - buffer.data());
+}
+
+///--------------------------------------------------------------------------///
+///                                 Binning                                  ///
+///--------------------------------------------------------------------------///
+namespace
+{
+
+enum class Rounding
+{
+    Floor,
+    Ceil,
+    Round
+};
+
+/// Below this period the quotient of the double precision approximation
+/// can be off by more than one so the division is done exactly.
+constexpr int64_t MINIMUM_APPROXIMATE_PERIOD{65536};
+
+/// @result The lower or upper multiple of the period as selected by the
+///         rounding given the lower multiple and the remainder.
+template<typename I, Rounding rounding>
+[[gnu::always_inline]] inline I selectBound(const I &lower, const I &upper,
+                                            const I &x) noexcept
+{
+    using namespace SIMD;
+    if constexpr (rounding == Rounding::Floor)
+    {
+        return lower;
+    }
+    else if constexpr (rounding == Rounding::Ceil)
+    {
+        return select<I>(x > lower, upper, lower);
+    }
+    else
+    {
+        return select<I>(x - lower >= upper - x, upper, lower);
+    }
+}
+
+/// @result multiple*period or, if that is not representable, the nearest
+///         limit of int64.
+int64_t saturatedMultiple(const int64_t multiple, const int64_t period) noexcept
+{
+    int64_t result{0};
+    if (__builtin_mul_overflow(multiple, period, &result))
+    {
+        return multiple < 0 ? std::numeric_limits<int64_t>::lowest() :
+                              std::numeric_limits<int64_t>::max();
+    }
+    return result;
+}
+
+/// @result The time before multiple*period or INT64_MAX if multiple*period
+///         is not representable.
+int64_t lastBefore(const int64_t multiple, const int64_t period) noexcept
+{
+    int64_t result{0};
+    if (__builtin_mul_overflow(multiple, period, &result))
+    {
+        return std::numeric_limits<int64_t>::max();
+    }
+    return result - 1;
+}
+
+/// Rounds a time exactly.  This is defined for every int64 time.
+template<Rounding rounding>
+int64_t roundExactly(const int64_t x, const int64_t period) noexcept
+{
+    auto quotient = Calendar::floorDivide(x, period);
+    if constexpr (rounding != Rounding::Floor)
+    {
+        // The quotient is at most INT64_MAX/period so this cannot overflow
+        auto remainder = Calendar::floorModulo(x, period);
+        bool up = rounding == Rounding::Ceil ? remainder > 0 :
+                  remainder >= period - remainder;
+        quotient = quotient + (up ? 1 : 0);
+    }
+    return saturatedMultiple(quotient, period);
+}
+
+/// Rounds LANES<I> times at index i to a multiple of the period.  The
+/// quotient is estimated by multiplying by the reciprocal in double
+/// precision, which is within two of floor(x/p) for periods of at least
+/// MINIMUM_APPROXIMATE_PERIOD, and then corrected.  Every intermediate is
+/// within four periods of x so the times must be at least that far from the
+/// limits of int64.
+template<typename I, Rounding rounding>
+[[gnu::always_inline]] inline
+void roundToPeriodKernel(const int64_t *epochs, int64_t *result,
+                         const int64_t period, const double inverse,
+                         const size_t i) noexcept
+{
+    using namespace SIMD;
+    using F = typename FloatOf<I>::type;
+    auto x = load<I>(epochs + i);
+    auto lower = convert<I>(convert<F>(x)*inverse)*period;
+    // Truncation toward zero can add another period of error
+    for (int k = 0; k < 2; ++k)
+    {
+        auto remainder = x - lower;
+        lower = select<I>(remainder < 0, lower - period, lower);
+        lower = select<I>(remainder >= period, lower + period, lower);
+    }
+    store<I>(selectBound<I, rounding>(lower, lower + period, x), result + i);
+}
+
+/// Rounds the times in blocks.  Blocks with a time within four periods of
+/// the limits of int64 are rounded exactly.
+template<typename I, Rounding rounding>
+[[gnu::always_inline]] inline
+void roundToPeriodLoop(const int64_t *epochs, int64_t *result,
+                       const int64_t period, const size_t n) noexcept
+{
+    constexpr auto lanes = static_cast<size_t> (SIMD::LANES<I>);
+    constexpr auto maximum = std::numeric_limits<int64_t>::max();
+    const double inverse = 1.0/static_cast<double> (period);
+    const bool approximate = period <= maximum/8;
+    const auto low = approximate ? -maximum + 4*period : 0;
+    const auto high = approximate ? maximum - 4*period : 0;
+    for (size_t i0 = 0; i0 < n; i0 = i0 + BLOCK_SIZE)
+    {
+        auto nBlock = std::min(BLOCK_SIZE, n - i0);
+        // The block is in L1 for the rounding that follows
+        bool safe = approximate;
+        for (size_t i = i0; i < i0 + nBlock; ++i)
+        {
+            safe = safe & (epochs[i] >= low) & (epochs[i] <= high);
+        }
+        if (!safe)
+        {
+            for (size_t i = i0; i < i0 + nBlock; ++i)
+            {
+                result[i] = roundExactly<rounding>(epochs[i], period);
+            }
+            continue;
+        }
+        size_t i = i0;
+        for ( ; i + lanes <= i0 + nBlock; i = i + lanes)
+        {
+            roundToPeriodKernel<I, rounding>(epochs, result, period,
+                                             inverse, i);
+        }
+        for ( ; i < i0 + nBlock; ++i)
+        {
+            roundToPeriodKernel<int64_t, rounding>(epochs, result, period,
+                                                   inverse, i);
+        }
+    }
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+// AVX2 has no 64-bit integer to double conversion or multiply so only
+// AVX-512 is vectorized.
+template<Rounding rounding>
+[[gnu::target("avx512f,avx512dq")]]
+void roundToPeriodAVX512(const int64_t *epochs, int64_t *result,
+                         const int64_t period, const size_t n) noexcept
+{
+    roundToPeriodLoop<SIMD::Int64x8, rounding>(epochs, result, period, n);
+}
+#endif
+
+template<Rounding rounding>
+void roundToPeriodScalar(const int64_t *epochs, int64_t *result,
+                         const int64_t period, const size_t n) noexcept
+{
+    roundToPeriodLoop<int64_t, rounding>(epochs, result, period, n);
+}
+
+template<Rounding rounding>
+void roundToPeriod(const std::span<const int64_t> epochs,
+                   const std::chrono::nanoseconds period,
+                   const std::span<int64_t> result)
+{
+    auto p = period.count();
+    if (p <= 0){throw std::invalid_argument("Period must be positive");}
+    checkColumn(result, epochs.size(), "Result");
+    if (p < MINIMUM_APPROXIMATE_PERIOD)
+    {
+        for (size_t i = 0; i < epochs.size(); ++i)
+        {
+            result[i] = roundExactly<rounding>(epochs[i], p);
+        }
+        return;
+    }
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    if (SIMD::getInstructionSet() == SIMD::InstructionSet::AVX512)
+    {
+        roundToPeriodAVX512<rounding>(epochs.data(), result.data(), p,
+                                      epochs.size());
+        return;
+    }
+#endif
+    roundToPeriodScalar<rounding>(epochs.data(), result.data(), p,
+                                  epochs.size());
+}
+
+/// Computes the first day of the month or year containing, and the first
+/// day of the next month or year after, LANES<I> days at index i.
+template<typename I, bool isYear>
+[[gnu::always_inline]] inline
+void calendarBoundsKernel(const int32_t *days, int32_t *first,
+                          int32_t *next, const size_t i) noexcept
+{
+    using namespace SIMD;
+    auto civil = civilFromDays<I>(load<I>(days + i));
+    if constexpr (isYear)
+    {
+        store<I>(daysToJanuary1<I>(civil.year), first + i);
+        store<I>(daysToJanuary1<I>(civil.year + 1), next + i);
+    }
+    else
+    {
+        store<I>(daysToFirstOfMonth<I>(civil.year, civil.month), first + i);
+        auto december = civil.month == 12;
+        auto nextYear = civil.year + toOne<I>(december);
+        auto nextMonth = select<I>(december, broadcast<I>(1), civil.month + 1);
+        store<I>(daysToFirstOfMonth<I>(nextYear, nextMonth), next + i);
+    }
+}
+
+template<typename I, bool isYear>
+[[gnu::always_inline]] inline
+void calendarBoundsLoop(const int32_t *days, int32_t *first, int32_t *next,
+                        const size_t n) noexcept
+{
+    constexpr auto lanes = static_cast<size_t> (SIMD::LANES<I>);
+    size_t i = 0;
+    for ( ; i + lanes <= n; i = i + lanes)
+    {
+        calendarBoundsKernel<I, isYear>(days, first, next, i);
+    }
+    for ( ; i < n; ++i)
+    {
+        calendarBoundsKernel<int32_t, isYear>(days, first, next, i);
+    }
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+template<bool isYear>
+[[gnu::target("avx512f")]]
+void calendarBoundsAVX512(const int32_t *days, int32_t *first,
+                          int32_t *next, const size_t n) noexcept
+{
+    calendarBoundsLoop<SIMD::Int32x16, isYear>(days, first, next, n);
+}
+
+template<bool isYear>
+[[gnu::target("avx2")]]
+void calendarBoundsAVX2(const int32_t *days, int32_t *first,
+                        int32_t *next, const size_t n) noexcept
+{
+    calendarBoundsLoop<SIMD::Int32x8, isYear>(days, first, next, n);
+}
+#endif
+
+template<bool isYear>
+void calendarBoundsScalar(const int32_t *days, int32_t *first,
+                          int32_t *next, const size_t n) noexcept
+{
+    calendarBoundsLoop<int32_t, isYear>(days, first, next, n);
+}
+
+template<bool isYear>
+void calendarBounds(const int32_t *days, int32_t *first, int32_t *next,
+                    const size_t n) noexcept
+{
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    auto instructionSet = SIMD::getInstructionSet();
+    if (instructionSet == SIMD::InstructionSet::AVX512)
+    {
+        calendarBoundsAVX512<isYear>(days, first, next, n);
+        return;
+    }
+    if (instructionSet == SIMD::InstructionSet::AVX2)
+    {
+        calendarBoundsAVX2<isYear>(days, first, next, n);
+        return;
+    }
+#endif
+    calendarBoundsScalar<isYear>(days, first, next, n);
+}
+
+template<Rounding rounding>
+void roundToCalendarPeriod(const std::span<const int64_t> epochs,
+                           const Batch::CalendarPeriod period,
+                           const std::span<int64_t> result)
+{
+    if (period == Batch::CalendarPeriod::Day)
+    {
+        roundToPeriod<rounding>(epochs,
+            std::chrono::nanoseconds {Calendar::NANOSECONDS_PER_DAY}, result);
+        return;
+    }
+    auto n = epochs.size();
+    checkColumn(result, n, "Result");
+    std::array<int32_t, BLOCK_SIZE> days;
+    std::array<int32_t, BLOCK_SIZE> first;
+    std::array<int32_t, BLOCK_SIZE> next;
+    for (size_t i0 = 0; i0 < n; i0 = i0 + BLOCK_SIZE)
+    {
+        auto nBlock = std::min(BLOCK_SIZE, n - i0);
+        for (size_t i = 0; i < nBlock; ++i)
+        {
+            days[i] = static_cast<int32_t> (
+                Calendar::floorDivide(epochs[i0 + i],
+                                      Calendar::NANOSECONDS_PER_DAY));
+        }
+        if (period == Batch::CalendarPeriod::Year)
+        {
+            calendarBounds<true>(days.data(), first.data(), next.data(),
+                                 nBlock);
+        }
+        else
+        {
+            calendarBounds<false>(days.data(), first.data(), next.data(),
+                                  nBlock);
+        }
+        for (size_t i = 0; i < nBlock; ++i)
+        {
+            // The periods containing the extreme times are not representable
+            // so the bound is selected before it is saturated
+            auto lower = static_cast<__int128> (first[i])
+                        *Calendar::NANOSECONDS_PER_DAY;
+            auto upper = static_cast<__int128> (next[i])
+                        *Calendar::NANOSECONDS_PER_DAY;
+            auto bound = selectBound<__int128, rounding>(
+                lower, upper, static_cast<__int128> (epochs[i0 + i]));
+            result[i0 + i] = static_cast<int64_t> (std::clamp<__int128> (
+                bound, std::numeric_limits<int64_t>::lowest(),
+                std::numeric_limits<int64_t>::max()));
+        }
+    }
+}
+
+/// Splits sorted times into runs.  The bin of a time is given by
+/// getBounds(time) which returns the start of the bin and the last time in
+/// the bin.  The last time, unlike the start of the next bin, is always
+/// representable.
+template<typename GetBounds>
+std::vector<Batch::Group> groupRuns(const std::span<const int64_t> epochs,
+                                    GetBounds &&getBounds)
+{
+    std::vector<Batch::Group> groups;
+    auto n = epochs.size();
+    size_t i = 0;
+    while (i < n)
+    {
+        auto [start, last] = getBounds(epochs[i]);
+        // Gallop to bracket the first time in a later bin then bisect.
+        // Every time before low is known to be in this bin.
+        auto low = i + 1;
+        auto high = low;
+        size_t step = 1;
+        while (high < n && epochs[high] <= last)
+        {
+            low = high + 1;
+            high = low + step;
+            step = 2*step;
+        }
+        high = std::min(high, n);
+        auto end = static_cast<size_t> (
+            std::upper_bound(epochs.begin() + static_cast<ptrdiff_t> (low),
+                             epochs.begin() + static_cast<ptrdiff_t> (high),
+                             last) - epochs.begin());
+        groups.push_back(Batch::Group{start, i, end});
+        i = end;
+    }
+    return groups;
+}
+
+}
+
+void Batch::floor(const std::span<const int64_t> epochs,
+                  const std::chrono::nanoseconds period,
+                  const std::span<int64_t> result)
+{
+    ::roundToPeriod<Rounding::Floor>(epochs, period, result);
+}
+
+void Batch::ceil(const std::span<const int64_t> epochs,
+                 const std::chrono::nanoseconds period,
+                 const std::span<int64_t> result)
+{
+    ::roundToPeriod<Rounding::Ceil>(epochs, period, result);
+}
+
+void Batch::round(const std::span<const int64_t> epochs,
+                  const std::chrono::nanoseconds period,
+                  const std::span<int64_t> result)
+{
+    ::roundToPeriod<Rounding::Round>(epochs, period, result);
+}
+
+void Batch::floor(const std::span<const int64_t> epochs,
+                  const CalendarPeriod period,
+                  const std::span<int64_t> result)
+{
+    ::roundToCalendarPeriod<Rounding::Floor>(epochs, period, result);
+}
+
+void Batch::ceil(const std::span<const int64_t> epochs,
+                 const CalendarPeriod period,
+                 const std::span<int64_t> result)
+{
+    ::roundToCalendarPeriod<Rounding::Ceil>(epochs, period, result);
+}
+
+void Batch::round(const std::span<const int64_t> epochs,
+                  const CalendarPeriod period,
+                  const std::span<int64_t> result)
+{
+    ::roundToCalendarPeriod<Rounding::Round>(epochs, period, result);
+}
+
+std::vector<Batch::Group>
+Batch::groupBy(const std::span<const int64_t> epochs,
+               const std::chrono::nanoseconds period)
+{
+    auto p = period.count();
+    if (p <= 0){throw std::invalid_argument("Period must be positive");}
+    return ::groupRuns(epochs, [p](const int64_t time)
+    {
+        auto quotient = Calendar::floorDivide(time, p);
+        return std::pair<int64_t, int64_t>
+               {::saturatedMultiple(quotient, p),
+                ::lastBefore(quotient + 1, p)};
+    });
+}
+
+std::vector<Batch::Group>
+Batch::groupBy(const std::span<const int64_t> epochs,
+               const CalendarPeriod period)
+{
+    if (period == CalendarPeriod::Day)
+    {
+        return groupBy(epochs,
+            std::chrono::nanoseconds {Calendar::NANOSECONDS_PER_DAY});
+    }
+    return ::groupRuns(epochs, [period](const int64_t time)
+    {
+        auto date = Calendar::civilFromDays(
+            Calendar::floorDivide(time, Calendar::NANOSECONDS_PER_DAY));
+        int64_t first{0};
+        int64_t next{0};
+        if (period == CalendarPeriod::Year)
+        {
+            first = Calendar::daysFromCivil(date.year, 1, 1);
+            next = Calendar::daysFromCivil(date.year + 1, 1, 1);
+        }
+        else
+        {
+            first = Calendar::daysFromCivil(date.year, date.month, 1);
+            next = date.month == 12 ?
+                   Calendar::daysFromCivil(date.year + 1, 1, 1) :
+                   Calendar::daysFromCivil(date.year, date.month + 1, 1);
+        }
+        return std::pair<int64_t, int64_t>
+               {::saturatedMultiple(first, Calendar::NANOSECONDS_PER_DAY),
+                ::lastBefore(next, Calendar::NANOSECONDS_PER_DAY)};
+    });
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "time/boundaries.hpp"
+#include "time/calendar.hpp"
+
+using namespace Time;
+
+namespace
+{
+
+constexpr int64_t NANOSECONDS_PER_HOUR{3600*Calendar::NANOSECONDS_PER_SECOND};
+/// The times in the years [1678,2261].  The periods containing these times
+/// and the periods after them fit in int64 nanoseconds.
+constexpr int64_t MINIMUM_TIME{Calendar::toEpoch(Calendar::MINIMUM_YEAR,
+                                                 1, 1, 0, 0, 0, 0)};
+constexpr int64_t MAXIMUM_TIME{Calendar::toEpoch(Calendar::MAXIMUM_YEAR + 1,
+                                                 1, 1, 0, 0, 0, 0)};
+
+void checkTime(const int64_t time, const std::string &name)
+{
+    if (time < MINIMUM_TIME || time >= MAXIMUM_TIME)
+    {
+        throw std::invalid_argument(name + " must be in the years [1678,2261]");
+    }
+}
+
+/// Moves the date forward a day.
+void nextDay(Boundary &boundary) noexcept
+{
+    boundary.dayOfYear = boundary.dayOfYear + 1;
+    boundary.dayOfMonth = boundary.dayOfMonth + 1;
+    if (boundary.dayOfMonth > Calendar::daysInMonth(boundary.year,
+                                                    boundary.month))
+    {
+        boundary.dayOfMonth = 1;
+        boundary.month = boundary.month + 1;
+        if (boundary.month > 12)
+        {
+            boundary.month = 1;
+            boundary.dayOfYear = 1;
+            boundary.year = boundary.year + 1;
+        }
+    }
+}
+
+}
+
+Boundary Time::getBoundary(const int64_t time, const BoundaryPeriod period)
+{
+    ::checkTime(time, "Time");
+    auto days = Calendar::floorDivide(time, Calendar::NANOSECONDS_PER_DAY);
+    auto date = Calendar::civilFromDays(days);
+    Boundary boundary;
+    boundary.year = date.year;
+    boundary.month = date.month;
+    boundary.dayOfMonth = date.dayOfMonth;
+    boundary.dayOfYear = Calendar::dayOfYear(date.year, date.month,
+                                             date.dayOfMonth);
+    if (period == BoundaryPeriod::Hour)
+    {
+        boundary.start = Calendar::floorDivide(time, NANOSECONDS_PER_HOUR)
+                        *NANOSECONDS_PER_HOUR;
+        boundary.end = boundary.start + NANOSECONDS_PER_HOUR;
+        boundary.hour = static_cast<int> ((boundary.start
+                                         - days*Calendar::NANOSECONDS_PER_DAY)
+                                         /NANOSECONDS_PER_HOUR);
+    }
+    else if (period == BoundaryPeriod::Day)
+    {
+        boundary.start = days*Calendar::NANOSECONDS_PER_DAY;
+        boundary.end = boundary.start + Calendar::NANOSECONDS_PER_DAY;
+    }
+    else
+    {
+        boundary.dayOfYear = boundary.dayOfYear - (boundary.dayOfMonth - 1);
+        boundary.dayOfMonth = 1;
+        boundary.start = Calendar::toEpoch(boundary.year, boundary.month,
+                                           1, 0, 0, 0, 0);
+        boundary.end = boundary.start
+                     + Calendar::daysInMonth(boundary.year, boundary.month)
+                      *Calendar::NANOSECONDS_PER_DAY;
+    }
+    return boundary;
+}
+
+Boundary Time::getNextBoundary(const Boundary &boundary,
+                               const BoundaryPeriod period) noexcept
+{
+    auto next = boundary;
+    next.start = boundary.end;
+    if (period == BoundaryPeriod::Hour)
+    {
+        next.hour = boundary.hour + 1;
+        if (next.hour == 24)
+        {
+            next.hour = 0;
+            ::nextDay(next);
+        }
+        next.end = next.start + NANOSECONDS_PER_HOUR;
+    }
+    else if (period == BoundaryPeriod::Day)
+    {
+        ::nextDay(next);
+        next.end = next.start + Calendar::NANOSECONDS_PER_DAY;
+    }
+    else
+    {
+        next.dayOfYear = boundary.dayOfYear
+                       + Calendar::daysInMonth(boundary.year, boundary.month);
+        next.month = boundary.month + 1;
+        if (next.month > 12)
+        {
+            next.month = 1;
+            next.dayOfYear = 1;
+            next.year = boundary.year + 1;
+        }
+        next.end = next.start
+                 + Calendar::daysInMonth(next.year, next.month)
+                  *Calendar::NANOSECONDS_PER_DAY;
+    }
+    return next;
+}
+
+BoundaryRange::BoundaryRange(const int64_t start, const int64_t end,
+                             const BoundaryPeriod period) :
+    mPeriod(period)
+{
+    // The end is exclusive so it may be the first instant of 2262
+    if (end != MAXIMUM_TIME){::checkTime(end, "End time");}
+    mFirst = getBoundary(start, period);
+    // Start the first period at the end so the range is empty
+    if (end <= start){mFirst.start = end;}
+    mEnd = end;
+}
+
+int64_t Time::findBoundarySample(const int64_t startTime,
+                                 const SamplingPeriod &samplingPeriod,
+                                 const int64_t nSamples,
+                                 const BoundaryPeriod period)
+{
+    if (nSamples < 0)
+    {
+        throw std::invalid_argument("Number of samples must be non-negative");
+    }
+    auto boundary = getBoundary(startTime, period);
+    // The first sample at or after the boundary follows the last sample
+    // before it
+    auto index = SampleAxis::toFloorIndex(startTime, samplingPeriod,
+                                          boundary.end - 1) + 1;
+    return std::min(index, nSamples);
+}
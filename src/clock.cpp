@@ -0,0 +1,269 @@
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#include "time/clock.hpp"
+
+using namespace Time;
+
+namespace
+{
+
+std::atomic<Clock::Source> source{Clock::Source::Realtime};
+std::atomic<int64_t> resynchronizationInterval{1000000000};
+
+/// The TSC calibration.  This is published with a sequence lock so that
+/// reading the clock never blocks.  The scale is the nanoseconds per tick
+/// in 32.32 fixed point.
+struct Calibration
+{
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<int64_t> nanoSeconds{0};
+    std::atomic<uint64_t> scale{0};
+    std::atomic<uint64_t> maximumTicks{0};
+};
+Calibration calibration;
+/// Serializes the writers of the calibration.
+std::mutex calibrationMutex;
+
+int64_t readRealtime() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+           (std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t readCoarseRealtime() noexcept
+{
+#if defined(CLOCK_REALTIME_COARSE)
+    timespec now;
+    clock_gettime(CLOCK_REALTIME_COARSE, &now);
+    return static_cast<int64_t> (now.tv_sec)*1000000000 + now.tv_nsec;
+#else
+    return readRealtime();
+#endif
+}
+
+uint64_t readTicks() noexcept
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/// A simultaneous reading of the TSC and the realtime clock.
+struct Sample
+{
+    uint64_t ticks{0};
+    int64_t nanoSeconds{0};
+};
+
+/// Reads the realtime clock between two reads of the TSC a few times and
+/// keeps the tightest bracket.
+Sample sample() noexcept
+{
+    Sample result;
+    uint64_t bestWidth{std::numeric_limits<uint64_t>::max()};
+    for (int i = 0; i < 5; ++i)
+    {
+        auto before = readTicks();
+        auto nanoSeconds = readRealtime();
+        auto after = readTicks();
+        if (after - before < bestWidth)
+        {
+            bestWidth = after - before;
+            result.ticks = before + (after - before)/2;
+            result.nanoSeconds = nanoSeconds;
+        }
+    }
+    return result;
+}
+
+/// @result The number of ticks in the resynchronization interval.
+uint64_t getMaximumTicks(const uint64_t scale) noexcept
+{
+    auto interval = static_cast<unsigned __int128>
+                    (resynchronizationInterval.load(std::memory_order_relaxed));
+    return static_cast<uint64_t> ((interval << 32)/scale);
+}
+
+/// Publishes a calibration.  The caller must hold the calibration mutex.
+void publish(const Sample &anchor, const uint64_t scale) noexcept
+{
+    auto sequence = calibration.sequence.load(std::memory_order_relaxed);
+    calibration.sequence.store(sequence + 1, std::memory_order_relaxed);
+    // A reader that sees any of these also sees the odd sequence
+    calibration.ticks.store(anchor.ticks, std::memory_order_release);
+    calibration.nanoSeconds.store(anchor.nanoSeconds,
+                                  std::memory_order_release);
+    calibration.scale.store(scale, std::memory_order_release);
+    calibration.maximumTicks.store(getMaximumTicks(scale),
+                                   std::memory_order_release);
+    calibration.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/// Measures the TSC rate against the realtime clock.
+void calibrate()
+{
+    std::lock_guard<std::mutex> lock(calibrationMutex);
+    auto start = sample();
+    std::this_thread::sleep_for(std::chrono::milliseconds {10});
+    auto end = sample();
+    if (end.ticks <= start.ticks || end.nanoSeconds <= start.nanoSeconds)
+    {
+        throw std::invalid_argument("TSC calibration failed");
+    }
+    auto scale = static_cast<uint64_t>
+        ((static_cast<unsigned __int128> (end.nanoSeconds - start.nanoSeconds)
+          << 32)/(end.ticks - start.ticks));
+    publish(end, scale);
+}
+
+/// Re-anchors the TSC to the realtime clock.  The rate is refined over
+/// the interval since the last anchor unless the realtime clock was
+/// stepped, e.g., by NTP.
+/// @result False indicates another thread is resynchronizing.
+bool resynchronize() noexcept
+{
+    std::unique_lock<std::mutex> lock(calibrationMutex, std::try_to_lock);
+    if (!lock.owns_lock()){return false;}
+    auto anchor = sample();
+    auto previousTicks = calibration.ticks.load(std::memory_order_relaxed);
+    auto previousNanoSeconds
+        = calibration.nanoSeconds.load(std::memory_order_relaxed);
+    auto scale = calibration.scale.load(std::memory_order_relaxed);
+    if (anchor.ticks > previousTicks &&
+        anchor.nanoSeconds > previousNanoSeconds)
+    {
+        auto newScale = static_cast<uint64_t>
+           ((static_cast<unsigned __int128>
+             (anchor.nanoSeconds - previousNanoSeconds) << 32)
+           /(anchor.ticks - previousTicks));
+        auto difference = newScale > scale ?
+                          newScale - scale : scale - newScale;
+        if (difference < scale/1000){scale = newScale;}
+    }
+    publish(anchor, scale);
+    return true;
+}
+
+int64_t readTSC() noexcept
+{
+    while (true)
+    {
+        auto sequence = calibration.sequence.load(std::memory_order_acquire);
+        // A writer is updating the calibration
+        if (sequence % 2 == 1){return readRealtime();}
+        auto anchorTicks = calibration.ticks.load(std::memory_order_acquire);
+        auto anchorNanoSeconds
+            = calibration.nanoSeconds.load(std::memory_order_acquire);
+        auto scale = calibration.scale.load(std::memory_order_acquire);
+        auto maximumTicks
+            = calibration.maximumTicks.load(std::memory_order_acquire);
+        if (calibration.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            continue;
+        }
+        auto ticks = readTicks() - anchorTicks;
+        // The counters of different cores may differ by a few ticks
+        if (static_cast<int64_t> (ticks) < 0){ticks = 0;}
+        if (ticks >= maximumTicks)
+        {
+            if (resynchronize()){continue;}
+            return readRealtime();
+        }
+        return anchorNanoSeconds
+             + static_cast<int64_t> ((static_cast<unsigned __int128> (ticks)
+                                     *scale) >> 32);
+    }
+}
+
+}
+
+/// Source
+void Clock::setSource(const Source newSource)
+{
+    if (newSource == Source::TSC)
+    {
+        if (!isTSCAvailable())
+        {
+            throw std::invalid_argument("An invariant TSC is not available");
+        }
+        calibrate();
+    }
+    source.store(newSource, std::memory_order_relaxed);
+}
+
+Clock::Source Clock::getSource() noexcept
+{
+    return source.load(std::memory_order_relaxed);
+}
+
+bool Clock::isTSCAvailable() noexcept
+{
+#if defined(__x86_64__)
+    // CPUID.80000007H:EDX[8] indicates the TSC rate is invariant
+    static const bool available = []()
+    {
+        unsigned int eax{0}, ebx{0}, ecx{0}, edx{0};
+        if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 ||
+            eax < 0x80000007)
+        {
+            return false;
+        }
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        return (edx & (1U << 8)) != 0;
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+/// Resynchronization interval
+void Clock::setResynchronizationInterval(const std::chrono::nanoseconds interval)
+{
+    if (interval.count() <= 0)
+    {
+        throw std::invalid_argument("Interval must be positive");
+    }
+    std::lock_guard<std::mutex> lock(calibrationMutex);
+    resynchronizationInterval.store(interval.count(),
+                                    std::memory_order_relaxed);
+    auto scale = calibration.scale.load(std::memory_order_relaxed);
+    if (scale > 0)
+    {
+        Sample anchor{calibration.ticks.load(std::memory_order_relaxed),
+                      calibration.nanoSeconds.load(std::memory_order_relaxed)};
+        publish(anchor, scale);
+    }
+}
+
+std::chrono::nanoseconds Clock::getResynchronizationInterval() noexcept
+{
+    return std::chrono::nanoseconds
+           {resynchronizationInterval.load(std::memory_order_relaxed)};
+}
+
+/// Now
+std::chrono::nanoseconds Clock::now() noexcept
+{
+    switch (source.load(std::memory_order_relaxed))
+    {
+        case Source::CoarseRealtime:
+            return std::chrono::nanoseconds {readCoarseRealtime()};
+        case Source::TSC:
+            return std::chrono::nanoseconds {readTSC()};
+        default:
+            return std::chrono::nanoseconds {readRealtime()};
+    }
+}
@@ -0,0 +1,64 @@
+#include <atomic>
+#include "time/dayCache.hpp"
+#include "dayCacheEntry.hpp"
+
+using namespace Time;
+
+namespace
+{
+/// The number of threads that have enabled the cache.  When this is zero
+/// the conversions skip the thread-local lookup entirely.
+std::atomic<int> nEnabledThreads{0};
+struct ThreadState
+{
+    /// A thread that exits with the cache enabled no longer counts.
+    ~ThreadState()
+    {
+        if (enabled){nEnabledThreads.fetch_sub(1, std::memory_order_relaxed);}
+    }
+    Internal::DayCacheEntry entry;
+    bool enabled{false};
+};
+thread_local ThreadState threadState;
+}
+
+Internal::DayCacheEntry *Internal::getDayCacheEntry() noexcept
+{
+    if (nEnabledThreads.load(std::memory_order_relaxed) == 0){return nullptr;}
+    return threadState.enabled ? &threadState.entry : nullptr;
+}
+
+void DayCache::enable() noexcept
+{
+    if (threadState.enabled){return;}
+    threadState.enabled = true;
+    nEnabledThreads.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DayCache::disable() noexcept
+{
+    if (!threadState.enabled){return;}
+    threadState.enabled = false;
+    nEnabledThreads.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool DayCache::isEnabled() noexcept
+{
+    return threadState.enabled;
+}
+
+uint64_t DayCache::getHits() noexcept
+{
+    return threadState.entry.hits;
+}
+
+uint64_t DayCache::getMisses() noexcept
+{
+    return threadState.entry.misses;
+}
+
+void DayCache::resetCounters() noexcept
+{
+    threadState.entry.hits = 0;
+    threadState.entry.misses = 0;
+}
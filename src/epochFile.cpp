@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "time/epochFile.hpp"
+
+using namespace Time;
+
+namespace
+{
+
+static_assert(sizeof(EpochFileBlock) == 16);
+
+constexpr std::array<char, 8> MAGIC{'U', 'U', 'E', 'P', 'O', 'C', 'H', '\0'};
+constexpr uint32_t VERSION{1};
+constexpr uint32_t SORTED{1};
+
+/// The file header.  The times begin immediately after it.
+struct Header
+{
+    std::array<char, 8> magic{MAGIC};
+    uint32_t version{VERSION};
+    uint32_t flags{0};
+    uint64_t blockSize{0};
+    uint64_t size{0};
+    uint64_t numberOfBlocks{0};
+    uint64_t indexOffset{0};
+    std::array<uint64_t, 2> reserved{0, 0};
+};
+static_assert(sizeof(Header) == 64);
+
+/// The times are mapped in place so they must be in the host's order.
+void checkByteOrder()
+{
+    if constexpr (std::endian::native != std::endian::little)
+    {
+        throw std::invalid_argument("Epoch files require a little-endian host");
+    }
+}
+
+constexpr uint64_t getIndexOffset(const uint64_t size) noexcept
+{
+    return sizeof(Header) + size*sizeof(int64_t);
+}
+
+}
+
+///--------------------------------------------------------------------------///
+///                                 Writer                                   ///
+///--------------------------------------------------------------------------///
+EpochFileWriter::EpochFileWriter(const std::filesystem::path &fileName,
+                                 const size_t blockSize) :
+    mFileName(fileName),
+    mBlockSize(blockSize)
+{
+    ::checkByteOrder();
+    if (blockSize == 0)
+    {
+        throw std::invalid_argument("Block size must be positive");
+    }
+    mFile.open(fileName, std::ios::binary | std::ios::trunc);
+    if (!mFile)
+    {
+        throw std::invalid_argument("Could not create " + fileName.string());
+    }
+    // The header is written on close
+    Header header;
+    mFile.write(reinterpret_cast<const char *> (&header), sizeof(Header));
+}
+
+void EpochFileWriter::append(const int64_t epoch)
+{
+    append(std::span<const int64_t> {&epoch, 1});
+}
+
+void EpochFileWriter::append(const std::span<const int64_t> epochs)
+{
+    if (!mFile.is_open())
+    {
+        throw std::invalid_argument(mFileName.string() + " is closed");
+    }
+    size_t i{0};
+    while (i < epochs.size())
+    {
+        auto offset = mSize % mBlockSize;
+        if (offset == 0)
+        {
+            mBlocks.push_back(EpochFileBlock{epochs[i], epochs[i]});
+        }
+        // Fill the rest of the current block
+        auto n = std::min(mBlockSize - offset, epochs.size() - i);
+        auto chunk = epochs.subspan(i, n);
+        auto [minimum, maximum] = std::minmax_element(chunk.begin(),
+                                                      chunk.end());
+        auto &block = mBlocks.back();
+        block.minimum = std::min(block.minimum, *minimum);
+        block.maximum = std::max(block.maximum, *maximum);
+        if (mSorted)
+        {
+            mSorted = (mSize == 0 || mLast <= chunk.front())
+                   && std::is_sorted(chunk.begin(), chunk.end());
+        }
+        mLast = chunk.back();
+        mSize = mSize + n;
+        i = i + n;
+    }
+    mFile.write(reinterpret_cast<const char *> (epochs.data()),
+                static_cast<std::streamsize> (epochs.size_bytes()));
+    if (!mFile)
+    {
+        throw std::invalid_argument("Failed to write to "
+                                  + mFileName.string());
+    }
+}
+
+size_t EpochFileWriter::size() const noexcept
+{
+    return mSize;
+}
+
+void EpochFileWriter::close()
+{
+    if (!mFile.is_open()){return;}
+    mFile.write(reinterpret_cast<const char *> (mBlocks.data()),
+                static_cast<std::streamsize> (mBlocks.size()
+                                             *sizeof(EpochFileBlock)));
+    Header header;
+    header.flags = mSorted ? SORTED : 0;
+    header.blockSize = mBlockSize;
+    header.size = mSize;
+    header.numberOfBlocks = mBlocks.size();
+    header.indexOffset = ::getIndexOffset(mSize);
+    mFile.seekp(0);
+    mFile.write(reinterpret_cast<const char *> (&header), sizeof(Header));
+    mFile.close();
+    if (!mFile)
+    {
+        throw std::invalid_argument("Failed to write " + mFileName.string());
+    }
+}
+
+EpochFileWriter::~EpochFileWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+///--------------------------------------------------------------------------///
+///                                 Reader                                   ///
+///--------------------------------------------------------------------------///
+EpochFileReader::EpochFileReader(const std::filesystem::path &fileName)
+{
+    ::checkByteOrder();
+    if (!std::filesystem::exists(fileName))
+    {
+        throw std::invalid_argument(fileName.string() + " does not exist");
+    }
+    auto descriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        throw std::invalid_argument("Could not open " + fileName.string());
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0 ||
+        static_cast<size_t> (status.st_size) < sizeof(Header))
+    {
+        ::close(descriptor);
+        throw std::invalid_argument(fileName.string()
+                                  + " is too small to be an epoch file");
+    }
+    auto length = static_cast<size_t> (status.st_size);
+    auto mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED,
+                          descriptor, 0);
+    // The mapping holds its own reference to the file
+    ::close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::invalid_argument("Could not map " + fileName.string());
+    }
+    mMapping = mapping;
+    mMappingLength = length;
+    Header header;
+    std::memcpy(&header, mapping, sizeof(Header));
+    auto nBlocks = header.blockSize > 0 ?
+                   (header.size + header.blockSize - 1)/header.blockSize : 0;
+    if (header.magic != MAGIC ||
+        header.version != VERSION ||
+        header.blockSize == 0 ||
+        header.size > (length - sizeof(Header))/sizeof(int64_t) ||
+        header.numberOfBlocks != nBlocks ||
+        header.indexOffset != ::getIndexOffset(header.size) ||
+        length != header.indexOffset
+                + header.numberOfBlocks*sizeof(EpochFileBlock))
+    {
+        close();
+        throw std::invalid_argument(fileName.string()
+                                  + " is not a valid epoch file");
+    }
+    const auto *bytes = static_cast<const std::byte *> (mapping);
+    mEpochs = reinterpret_cast<const int64_t *> (bytes + sizeof(Header));
+    mBlocks = reinterpret_cast<const EpochFileBlock *>
+              (bytes + header.indexOffset);
+    mSize = header.size;
+    mNumberOfBlocks = header.numberOfBlocks;
+    mBlockSize = header.blockSize;
+    mSorted = (header.flags & SORTED) != 0;
+}
+
+EpochFileReader::EpochFileReader(EpochFileReader &&reader) noexcept
+{
+    *this = std::move(reader);
+}
+
+EpochFileReader& EpochFileReader::operator=(EpochFileReader &&reader) noexcept
+{
+    if (&reader == this){return *this;}
+    close();
+    mEpochs = std::exchange(reader.mEpochs, nullptr);
+    mBlocks = std::exchange(reader.mBlocks, nullptr);
+    mMapping = std::exchange(reader.mMapping, nullptr);
+    mMappingLength = std::exchange(reader.mMappingLength, 0);
+    mSize = std::exchange(reader.mSize, 0);
+    mNumberOfBlocks = std::exchange(reader.mNumberOfBlocks, 0);
+    mBlockSize = std::exchange(reader.mBlockSize, 0);
+    mSorted = std::exchange(reader.mSorted, true);
+    return *this;
+}
+
+EpochFileReader::~EpochFileReader()
+{
+    close();
+}
+
+void EpochFileReader::close() noexcept
+{
+    if (mMapping != nullptr){::munmap(mMapping, mMappingLength);}
+    mEpochs = nullptr;
+    mBlocks = nullptr;
+    mMapping = nullptr;
+    mMappingLength = 0;
+    mSize = 0;
+    mNumberOfBlocks = 0;
+    mBlockSize = 0;
+    mSorted = true;
+}
+
+bool EpochFileReader::isOpen() const noexcept
+{
+    return mMapping != nullptr;
+}
+
+size_t EpochFileReader::size() const noexcept
+{
+    return mSize;
+}
+
+bool EpochFileReader::empty() const noexcept
+{
+    return mSize == 0;
+}
+
+bool EpochFileReader::isSorted() const noexcept
+{
+    return mSorted;
+}
+
+size_t EpochFileReader::getBlockSize() const noexcept
+{
+    return mBlockSize;
+}
+
+std::span<const int64_t> EpochFileReader::getEpochs() const noexcept
+{
+    return std::span<const int64_t> {mEpochs, mSize};
+}
+
+std::span<const EpochFileBlock> EpochFileReader::getBlocks() const noexcept
+{
+    return std::span<const EpochFileBlock> {mBlocks, mNumberOfBlocks};
+}
+
+std::span<const int64_t> EpochFileReader::getBlock(const size_t block) const
+{
+    if (block >= mNumberOfBlocks)
+    {
+        throw std::out_of_range("Block " + std::to_string(block)
+                              + " must be less than "
+                              + std::to_string(mNumberOfBlocks));
+    }
+    auto offset = block*mBlockSize;
+    return getEpochs().subspan(offset, std::min(mBlockSize, mSize - offset));
+}
+
+UTC EpochFileReader::at(const size_t index) const
+{
+    if (index >= mSize)
+    {
+        throw std::out_of_range("Index " + std::to_string(index)
+                              + " must be less than " + std::to_string(mSize));
+    }
+    return UTC{std::chrono::nanoseconds {mEpochs[index]}};
+}
+
+std::span<const int64_t> EpochFileReader::find(const int64_t start,
+                                               const int64_t end) const
+{
+    if (!mSorted)
+    {
+        throw std::invalid_argument("Times are not sorted; use forEachBlock");
+    }
+    if (end <= start){return {};}
+    // The first time at or after t is in the first block whose maximum is
+    // at or after t
+    auto lowerBound = [this](const int64_t time) -> size_t
+    {
+        auto blocks = getBlocks();
+        auto block = static_cast<size_t> (
+            std::partition_point(blocks.begin(), blocks.end(),
+                                 [time](const EpochFileBlock &b)
+                                 {
+                                     return b.maximum < time;
+                                 }) - blocks.begin());
+        if (block == blocks.size()){return mSize;}
+        auto epochs = getBlock(block);
+        return block*mBlockSize
+             + static_cast<size_t> (std::lower_bound(epochs.begin(),
+                                                     epochs.end(), time)
+                                  - epochs.begin());
+    };
+    auto first = lowerBound(start);
+    auto last = lowerBound(end);
+    return getEpochs().subspan(first, last - first);
+}
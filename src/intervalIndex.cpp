@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <stdexcept>
+#include "time/intervalIndex.hpp"
+
+using namespace Time;
+
+/// C'tor
+IntervalIndex::IntervalIndex() :
+    mOffsets(1, 0)
+{
+}
+
+IntervalIndex::IntervalIndex(const std::span<const Interval> intervals) :
+    mIntervals(intervals.begin(), intervals.end())
+{
+    if (intervals.size() >= std::numeric_limits<uint32_t>::max())
+    {
+        throw std::invalid_argument("Too many intervals");
+    }
+    for (size_t i = 0; i < intervals.size(); ++i)
+    {
+        if (intervals[i].end < intervals[i].start)
+        {
+            throw std::invalid_argument("Interval " + std::to_string(i)
+                                      + " ends before it starts");
+        }
+    }
+    // The elementary segments
+    mBoundaries.reserve(2*intervals.size());
+    for (const auto &interval : intervals)
+    {
+        if (interval.start == interval.end){continue;}
+        mBoundaries.push_back(interval.start);
+        mBoundaries.push_back(interval.end);
+    }
+    std::sort(mBoundaries.begin(), mBoundaries.end());
+    mBoundaries.erase(std::unique(mBoundaries.begin(), mBoundaries.end()),
+                      mBoundaries.end());
+    // Visit the intervals in order of increasing start so each segment
+    // lists its intervals in that order
+    std::vector<uint32_t> order(intervals.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](const uint32_t lhs, const uint32_t rhs)
+                     {
+                         return intervals[lhs].start < intervals[rhs].start;
+                     });
+    auto getSegmentRange = [&](const Interval &interval)
+    {
+        auto first = std::lower_bound(mBoundaries.begin(), mBoundaries.end(),
+                                      interval.start) - mBoundaries.begin();
+        auto last = std::lower_bound(mBoundaries.begin(), mBoundaries.end(),
+                                     interval.end) - mBoundaries.begin();
+        return std::pair{static_cast<size_t> (first),
+                         static_cast<size_t> (last)};
+    };
+    // Count then fill the intervals covering each segment
+    mOffsets.assign(mBoundaries.size() + 1, 0);
+    for (const auto &interval : intervals)
+    {
+        if (interval.start == interval.end){continue;}
+        auto [first, last] = getSegmentRange(interval);
+        for (auto j = first; j < last; ++j){mOffsets[j + 1] += 1;}
+    }
+    std::partial_sum(mOffsets.begin(), mOffsets.end(), mOffsets.begin());
+    mIdentifiers.resize(mOffsets.back());
+    std::vector<size_t> next(mOffsets.begin(), mOffsets.end() - 1);
+    for (const auto &identifier : order)
+    {
+        const auto &interval = intervals[identifier];
+        if (interval.start == interval.end){continue;}
+        auto [first, last] = getSegmentRange(interval);
+        for (auto j = first; j < last; ++j)
+        {
+            mIdentifiers[next[j]] = identifier;
+            next[j] = next[j] + 1;
+        }
+    }
+}
+
+/// Size
+size_t IntervalIndex::size() const noexcept
+{
+    return mIntervals.size();
+}
+
+/// Empty?
+bool IntervalIndex::empty() const noexcept
+{
+    return mIntervals.empty();
+}
+
+/// Interval
+IntervalIndex::Interval IntervalIndex::at(const size_t identifier) const
+{
+    if (identifier >= mIntervals.size())
+    {
+        throw std::out_of_range("Identifier "  + std::to_string(identifier)
+                              + " must be less than "
+                              + std::to_string(mIntervals.size()));
+    }
+    return mIntervals[identifier];
+}
+
+/// The segment containing the time or -1 if the time precedes all
+/// boundaries
+int64_t IntervalIndex::findSegment(const int64_t time) const noexcept
+{
+    return (std::upper_bound(mBoundaries.begin(), mBoundaries.end(), time)
+          - mBoundaries.begin()) - 1;
+}
+
+/// Stabbing query
+std::span<const uint32_t> IntervalIndex::stab(const int64_t time) const noexcept
+{
+    return getSegment(findSegment(time));
+}
+
+/// Batch stabbing query
+void IntervalIndex::stab(const std::span<const int64_t> times,
+                         std::span<int64_t> identifiers) const
+{
+    if (identifiers.size() < times.size())
+    {
+        throw std::invalid_argument("identifiers must have length at least "
+                                  + std::to_string(times.size()));
+    }
+    Cursor cursor{*this};
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        auto result = cursor.stab(times[i]);
+        identifiers[i] = result.empty() ?
+                         -1 : static_cast<int64_t> (result.back());
+    }
+}
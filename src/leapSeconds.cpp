@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include "time/leapSeconds.hpp"
+#include "time/calendar.hpp"
+
+using namespace Time;
+
+namespace
+{
+/// A leap second takes effect at 00:00:00 UTC on the first of the month.
+struct LeapSecond
+{
+    int year;
+    int month;
+    int taiMinusUTC;
+};
+
+/// The IERS Bulletin C leap seconds since TAI - UTC became an integer.
+constexpr std::array<LeapSecond, 28> LEAP_SECONDS
+{{
+    {1972, 1, 10}, {1972, 7, 11}, {1973, 1, 12}, {1974, 1, 13},
+    {1975, 1, 14}, {1976, 1, 15}, {1977, 1, 16}, {1978, 1, 17},
+    {1979, 1, 18}, {1980, 1, 19}, {1981, 7, 20}, {1982, 7, 21},
+    {1983, 7, 22}, {1985, 7, 23}, {1988, 1, 24}, {1990, 1, 25},
+    {1991, 1, 26}, {1992, 7, 27}, {1993, 7, 28}, {1994, 7, 29},
+    {1996, 1, 30}, {1997, 7, 31}, {1999, 1, 32}, {2006, 1, 33},
+    {2009, 1, 34}, {2012, 7, 35}, {2015, 7, 36}, {2017, 1, 37}
+}};
+
+/// The UTC times in nanoseconds at which each leap second takes effect.
+constexpr std::array<int64_t, LEAP_SECONDS.size()> createUTCStart()
+{
+    std::array<int64_t, LEAP_SECONDS.size()> result{};
+    for (size_t i = 0; i < LEAP_SECONDS.size(); ++i)
+    {
+        result[i] = Calendar::daysFromCivil(LEAP_SECONDS[i].year,
+                                            LEAP_SECONDS[i].month, 1)
+                   *Calendar::NANOSECONDS_PER_DAY;
+    }
+    return result;
+}
+constexpr auto UTC_START = createUTCStart();
+static_assert(UTC_START.back() == 1483228800*Calendar::NANOSECONDS_PER_SECOND);
+
+/// The NTP epoch, 1900-01-01, precedes the UTC epoch by 2208988800 s.
+constexpr int64_t NTP_TO_UTC_SECONDS{2208988800};
+
+constexpr int64_t MINIMUM_TIME{std::numeric_limits<int64_t>::lowest()};
+constexpr int64_t MAXIMUM_TIME{std::numeric_limits<int64_t>::max()};
+
+/// Parses a leading integer from the view and advances past it.
+bool parseInteger(std::string_view &line, int64_t &value)
+{
+    auto begin = line.find_first_not_of(" \t");
+    if (begin == std::string_view::npos){return false;}
+    line.remove_prefix(begin);
+    auto [pointer, errorCode]
+        = std::from_chars(line.data(), line.data() + line.size(), value);
+    if (errorCode != std::errc{}){return false;}
+    line.remove_prefix(static_cast<size_t> (pointer - line.data()));
+    return true;
+}
+
+template<typename T>
+void checkOutput(const std::span<T> &output, const size_t n,
+                 const char *name)
+{
+    if (output.size() < n)
+    {
+        throw std::invalid_argument(std::string {name}
+                                  + " must have length at least "
+                                  + std::to_string(n));
+    }
+}
+}
+
+/// C'tor
+LeapSeconds::LeapSeconds()
+{
+    loadDefault();
+}
+
+/// Restores the compiled-in table
+void LeapSeconds::loadDefault()
+{
+    std::vector<int64_t> utcStart(UTC_START.begin(), UTC_START.end());
+    std::vector<int64_t> offset(LEAP_SECONDS.size());
+    for (size_t i = 0; i < LEAP_SECONDS.size(); ++i)
+    {
+        offset[i] = LEAP_SECONDS[i].taiMinusUTC
+                   *Calendar::NANOSECONDS_PER_SECOND;
+    }
+    setTable(std::move(utcStart), std::move(offset));
+}
+
+/// Loads a leap-seconds.list file
+void LeapSeconds::load(const std::filesystem::path &fileName)
+{
+    if (!std::filesystem::exists(fileName))
+    {
+        throw std::invalid_argument(fileName.string() + " does not exist");
+    }
+    std::ifstream file(fileName);
+    std::vector<int64_t> utcStart;
+    std::vector<int64_t> offset;
+    std::string line;
+    int lineNumber{0};
+    while (std::getline(file, line))
+    {
+        lineNumber = lineNumber + 1;
+        std::string_view view{line};
+        auto begin = view.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos || view[begin] == '#'){continue;}
+        int64_t ntpSeconds{0};
+        int64_t taiMinusUTC{0};
+        if (!parseInteger(view, ntpSeconds) || !parseInteger(view, taiMinusUTC))
+        {
+            throw std::invalid_argument("Malformed line "
+                                      + std::to_string(lineNumber)
+                                      + " in " + fileName.string());
+        }
+        auto start = (ntpSeconds - NTP_TO_UTC_SECONDS)
+                    *Calendar::NANOSECONDS_PER_SECOND;
+        if (!utcStart.empty() && start <= utcStart.back())
+        {
+            throw std::invalid_argument("Line "
+                                      + std::to_string(lineNumber)
+                                      + " in " + fileName.string()
+                                      + " is out of order");
+        }
+        utcStart.push_back(start);
+        offset.push_back(taiMinusUTC*Calendar::NANOSECONDS_PER_SECOND);
+    }
+    if (utcStart.empty())
+    {
+        throw std::invalid_argument("No leap seconds in "
+                                  + fileName.string());
+    }
+    setTable(std::move(utcStart), std::move(offset));
+}
+
+/// Sets the table and invalidates the cached segments
+void LeapSeconds::setTable(std::vector<int64_t> &&utcStart,
+                           std::vector<int64_t> &&offset)
+{
+    mUTCStart = std::move(utcStart);
+    mOffset = std::move(offset);
+    mTAIStart.resize(mUTCStart.size());
+    for (size_t i = 0; i < mUTCStart.size(); ++i)
+    {
+        mTAIStart[i] = mUTCStart[i] + mOffset[i];
+    }
+    updateUTCSegment(mUTCStart.back());
+    static_cast<void> (updateTAISegment(mTAIStart.back()));
+}
+
+/// Number of entries
+int LeapSeconds::getNumberOfEntries() const noexcept
+{
+    return static_cast<int> (mUTCStart.size());
+}
+
+/// TAI - UTC
+int LeapSeconds::getTAIMinusUTC(const int64_t utc) noexcept
+{
+    return static_cast<int> ((utcToTAI(utc) - utc)
+                            /Calendar::NANOSECONDS_PER_SECOND);
+}
+
+/// Finds the segment containing the UTC time
+void LeapSeconds::updateUTCSegment(const int64_t utc) noexcept
+{
+    auto i = std::distance(mUTCStart.begin(),
+                           std::upper_bound(mUTCStart.begin(),
+                                            mUTCStart.end(), utc));
+    auto n = static_cast<ptrdiff_t> (mUTCStart.size());
+    // Before the table the first offset applies
+    mUTCSegmentStart = i > 0 ? mUTCStart[i - 1] : MINIMUM_TIME;
+    mUTCSegmentEnd = i < n ? mUTCStart[i] : MAXIMUM_TIME;
+    mUTCSegmentOffset = mOffset[i > 0 ? i - 1 : 0];
+}
+
+/// Finds the segment containing the TAI time and converts the time
+int64_t LeapSeconds::updateTAISegment(const int64_t tai) noexcept
+{
+    auto i = std::distance(mTAIStart.begin(),
+                           std::upper_bound(mTAIStart.begin(),
+                                            mTAIStart.end(), tai));
+    auto n = static_cast<ptrdiff_t> (mTAIStart.size());
+    auto offset = mOffset[i > 0 ? i - 1 : 0];
+    mTAISegmentStart = i > 0 ? mTAIStart[i - 1] : MINIMUM_TIME;
+    mTAISegmentEnd = MAXIMUM_TIME;
+    mTAISegmentOffset = offset;
+    if (i < n)
+    {
+        // An inserted leap second precedes the next segment
+        mTAISegmentEnd = std::min(mTAIStart[i], mUTCStart[i] + offset);
+        if (tai >= mTAISegmentEnd){return mUTCStart[i] - 1;}
+    }
+    return tai - offset;
+}
+
+/// Batch conversions.  The segment is held in locals since the outputs
+/// could otherwise alias it.
+void LeapSeconds::utcToTAI(const std::span<const int64_t> utc,
+                           std::span<int64_t> tai)
+{
+    utcToTAI(utc, tai, 0);
+}
+
+void LeapSeconds::utcToGPS(const std::span<const int64_t> utc,
+                           std::span<int64_t> gps)
+{
+    utcToTAI(utc, gps, GPS_EPOCH_IN_TAI);
+}
+
+void LeapSeconds::taiToUTC(const std::span<const int64_t> tai,
+                           std::span<int64_t> utc)
+{
+    taiToUTC(tai, utc, 0);
+}
+
+void LeapSeconds::gpsToUTC(const std::span<const int64_t> gps,
+                           std::span<int64_t> utc)
+{
+    taiToUTC(gps, utc, GPS_EPOCH_IN_TAI);
+}
+
+void LeapSeconds::utcToTAI(const std::span<const int64_t> utc,
+                           std::span<int64_t> tai, const int64_t shift)
+{
+    checkOutput(tai, utc.size(), shift == 0 ? "tai" : "gps");
+    auto start = mUTCSegmentStart;
+    auto end = mUTCSegmentEnd;
+    auto offset = mUTCSegmentOffset - shift;
+    for (size_t i = 0; i < utc.size(); ++i)
+    {
+        auto time = utc[i];
+        if (time < start || time >= end) [[unlikely]]
+        {
+            updateUTCSegment(time);
+            start = mUTCSegmentStart;
+            end = mUTCSegmentEnd;
+            offset = mUTCSegmentOffset - shift;
+        }
+        tai[i] = time + offset;
+    }
+}
+
+void LeapSeconds::taiToUTC(const std::span<const int64_t> tai,
+                           std::span<int64_t> utc, const int64_t shift)
+{
+    checkOutput(utc, tai.size(), "utc");
+    auto start = mTAISegmentStart;
+    auto end = mTAISegmentEnd;
+    auto offset = mTAISegmentOffset;
+    for (size_t i = 0; i < tai.size(); ++i)
+    {
+        auto time = tai[i] + shift;
+        if (time < start || time >= end) [[unlikely]]
+        {
+            utc[i] = updateTAISegment(time);
+            start = mTAISegmentStart;
+            end = mTAISegmentEnd;
+            offset = mTAISegmentOffset;
+            continue;
+        }
+        utc[i] = time - offset;
+    }
+}
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include "time/sac.hpp"
+#include "time/batch.hpp"
+#include "time/calendar.hpp"
+
+using namespace Time;
+
+namespace
+{
+
+/// The headers are converted in blocks so the calendar fields fit in cache.
+constexpr size_t BLOCK_SIZE{512};
+constexpr int64_t NANOSECONDS_PER_MILLISECOND{1000000};
+/// The words of the reference time fields, i.e., nzyear, nzjday, nzhour,
+/// nzmin, nzsec, and nzmsec.
+constexpr size_t NZYEAR{70};
+constexpr size_t NZJDAY{71};
+constexpr size_t NZHOUR{72};
+constexpr size_t NZMIN{73};
+constexpr size_t NZSEC{74};
+constexpr size_t NZMSEC{75};
+/// The words of the markers in the order of SAC::Marker.
+constexpr std::array<size_t, SAC::NUMBER_OF_MARKERS> MARKER_WORDS
+{
+    5, 6, 7, 8, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20
+};
+/// Offsets at least this many nanoseconds cannot be represented.
+constexpr double MAXIMUM_OFFSET{9.2e18};
+
+uint32_t getWord(const std::byte *header, const size_t word,
+                 const SAC::ByteOrder byteOrder) noexcept
+{
+    uint32_t result;
+    std::memcpy(&result, header + 4*word, sizeof(uint32_t));
+    auto native = std::endian::native == std::endian::little ?
+                  SAC::ByteOrder::LittleEndian : SAC::ByteOrder::BigEndian;
+    return byteOrder == native ? result : __builtin_bswap32(result);
+}
+
+void putWord(std::byte *header, const size_t word, const uint32_t value,
+             const SAC::ByteOrder byteOrder) noexcept
+{
+    auto native = std::endian::native == std::endian::little ?
+                  SAC::ByteOrder::LittleEndian : SAC::ByteOrder::BigEndian;
+    auto result = byteOrder == native ? value : __builtin_bswap32(value);
+    std::memcpy(header + 4*word, &result, sizeof(uint32_t));
+}
+
+int32_t getInteger(const std::byte *header, const size_t word,
+                   const SAC::ByteOrder byteOrder) noexcept
+{
+    return static_cast<int32_t> (getWord(header, word, byteOrder));
+}
+
+float getFloat(const std::byte *header, const size_t word,
+               const SAC::ByteOrder byteOrder) noexcept
+{
+    return std::bit_cast<float> (getWord(header, word, byteOrder));
+}
+
+size_t getNumberOfHeaders(const std::span<const std::byte> headers)
+{
+    if (headers.size() % SAC::HEADER_LENGTH != 0)
+    {
+        throw std::invalid_argument("Headers must be a multiple of "
+                                  + std::to_string(SAC::HEADER_LENGTH)
+                                  + " bytes");
+    }
+    return headers.size()/SAC::HEADER_LENGTH;
+}
+
+/// Adds the marker offsets of a header to its reference time.
+/// @result False indicates an offset is not finite or too large.
+bool decodeMarkers(const std::byte *header, const int64_t referenceTime,
+                   const SAC::ByteOrder byteOrder,
+                   int64_t *markerTimes) noexcept
+{
+    bool valid{true};
+    for (size_t j = 0; j < SAC::NUMBER_OF_MARKERS; ++j)
+    {
+        auto offset = getFloat(header, MARKER_WORDS[j], byteOrder);
+        if (offset == SAC::UNDEFINED_FLOAT)
+        {
+            markerTimes[j] = SAC::UNDEFINED_TIME;
+            continue;
+        }
+        auto nanoSeconds = static_cast<double> (offset)*1.e9;
+        // This is false for NaN
+        bool inRange = std::abs(nanoSeconds) < MAXIMUM_OFFSET;
+        // Round half away from zero as std::llround, which is a library call
+        auto rounded = inRange ?
+            static_cast<int64_t> (nanoSeconds + std::copysign(0.5, nanoSeconds))
+            : 0;
+        valid = valid && inRange
+             && !__builtin_add_overflow(referenceTime, rounded,
+                                        &markerTimes[j]);
+    }
+    return valid;
+}
+
+/// Computes the marker offsets of a header from its stored reference time.
+/// @result False indicates a marker is too far from the reference time.
+bool encodeMarkers(const int64_t *markerTimes, const int64_t referenceTime,
+                   std::array<float, SAC::NUMBER_OF_MARKERS> &offsets)
+    noexcept
+{
+    bool valid{true};
+    for (size_t j = 0; j < SAC::NUMBER_OF_MARKERS; ++j)
+    {
+        if (markerTimes[j] == SAC::UNDEFINED_TIME)
+        {
+            offsets[j] = SAC::UNDEFINED_FLOAT;
+            continue;
+        }
+        int64_t nanoSeconds{0};
+        valid = valid
+             && !__builtin_sub_overflow(markerTimes[j], referenceTime,
+                                        &nanoSeconds);
+        offsets[j] = static_cast<float> (static_cast<double> (nanoSeconds)
+                                        *1.e-9);
+    }
+    return valid;
+}
+
+}
+
+size_t SAC::getTimes(const std::span<const std::byte> headers,
+                     std::span<int64_t> referenceTimes,
+                     std::span<int64_t> markerTimes,
+                     std::span<uint8_t> invalid,
+                     const ByteOrder byteOrder)
+{
+    auto nHeaders = ::getNumberOfHeaders(headers);
+    if (referenceTimes.size() < nHeaders || invalid.size() < nHeaders ||
+        markerTimes.size() < nHeaders*NUMBER_OF_MARKERS)
+    {
+        throw std::invalid_argument("Outputs must have length at least "
+                                  + std::to_string(nHeaders)
+                                  + " or, for the markers, "
+                                  + std::to_string(nHeaders*NUMBER_OF_MARKERS));
+    }
+    std::array<int32_t, BLOCK_SIZE> year;
+    std::array<int32_t, BLOCK_SIZE> dayOfYear;
+    std::array<int32_t, BLOCK_SIZE> hour;
+    std::array<int32_t, BLOCK_SIZE> minute;
+    std::array<int32_t, BLOCK_SIZE> second;
+    std::array<int32_t, BLOCK_SIZE> microSecond;
+    size_t nInvalid{0};
+    for (size_t i0 = 0; i0 < nHeaders; i0 = i0 + BLOCK_SIZE)
+    {
+        auto nBlock = std::min(BLOCK_SIZE, nHeaders - i0);
+        // Gather the reference time fields then validate and convert them
+        // together.  An undefined field is out of range.
+        for (size_t i = 0; i < nBlock; ++i)
+        {
+            const auto *header = headers.data() + (i0 + i)*HEADER_LENGTH;
+            year[i] = ::getInteger(header, NZYEAR, byteOrder);
+            dayOfYear[i] = ::getInteger(header, NZJDAY, byteOrder);
+            hour[i] = ::getInteger(header, NZHOUR, byteOrder);
+            minute[i] = ::getInteger(header, NZMIN, byteOrder);
+            second[i] = ::getInteger(header, NZSEC, byteOrder);
+            auto milliSecond = ::getInteger(header, NZMSEC, byteOrder);
+            microSecond[i] = (milliSecond >= 0 && milliSecond <= 999) ?
+                             milliSecond*1000 : -1;
+        }
+        Batch::ConstCalendarColumns calendar;
+        calendar.year = std::span<const int32_t> (year.data(), nBlock);
+        calendar.dayOfYear
+            = std::span<const int32_t> (dayOfYear.data(), nBlock);
+        calendar.hour = std::span<const int32_t> (hour.data(), nBlock);
+        calendar.minute = std::span<const int32_t> (minute.data(), nBlock);
+        calendar.second = std::span<const int32_t> (second.data(), nBlock);
+        calendar.microSecond
+            = std::span<const int32_t> (microSecond.data(), nBlock);
+        Batch::fromDayOfYear(calendar, referenceTimes.subspan(i0, nBlock),
+                             invalid.subspan(i0, nBlock));
+        for (size_t i = i0; i < i0 + nBlock; ++i)
+        {
+            auto *markers = markerTimes.data() + i*NUMBER_OF_MARKERS;
+            if (invalid[i] == 0 &&
+                !::decodeMarkers(headers.data() + i*HEADER_LENGTH,
+                                 referenceTimes[i], byteOrder, markers))
+            {
+                invalid[i] = 1;
+                referenceTimes[i] = 0;
+            }
+            if (invalid[i] != 0)
+            {
+                std::fill(markers, markers + NUMBER_OF_MARKERS, 0);
+                nInvalid = nInvalid + 1;
+            }
+        }
+    }
+    return nInvalid;
+}
+
+size_t SAC::setTimes(const std::span<const int64_t> referenceTimes,
+                     const std::span<const int64_t> markerTimes,
+                     std::span<std::byte> headers,
+                     std::span<uint8_t> invalid,
+                     const ByteOrder byteOrder)
+{
+    auto nHeaders = ::getNumberOfHeaders(headers);
+    if (referenceTimes.size() < nHeaders || invalid.size() < nHeaders ||
+        markerTimes.size() < nHeaders*NUMBER_OF_MARKERS)
+    {
+        throw std::invalid_argument("Inputs must have length at least "
+                                  + std::to_string(nHeaders)
+                                  + " or, for the markers, "
+                                  + std::to_string(nHeaders*NUMBER_OF_MARKERS));
+    }
+    std::array<int32_t, BLOCK_SIZE> year;
+    std::array<int32_t, BLOCK_SIZE> dayOfYear;
+    std::array<int32_t, BLOCK_SIZE> month;
+    std::array<int32_t, BLOCK_SIZE> dayOfMonth;
+    std::array<int32_t, BLOCK_SIZE> hour;
+    std::array<int32_t, BLOCK_SIZE> minute;
+    std::array<int32_t, BLOCK_SIZE> second;
+    std::array<int32_t, BLOCK_SIZE> nanoSecond;
+    size_t nInvalid{0};
+    for (size_t i0 = 0; i0 < nHeaders; i0 = i0 + BLOCK_SIZE)
+    {
+        auto nBlock = std::min(BLOCK_SIZE, nHeaders - i0);
+        Batch::CalendarColumns calendar{
+            std::span<int32_t> (year.data(), nBlock),
+            std::span<int32_t> (dayOfYear.data(), nBlock),
+            std::span<int32_t> (month.data(), nBlock),
+            std::span<int32_t> (dayOfMonth.data(), nBlock),
+            std::span<int32_t> (hour.data(), nBlock),
+            std::span<int32_t> (minute.data(), nBlock),
+            std::span<int32_t> (second.data(), nBlock),
+            std::span<int32_t> (nanoSecond.data(), nBlock)};
+        Batch::toCalendar(referenceTimes.subspan(i0, nBlock), calendar);
+        for (size_t i = 0; i < nBlock; ++i)
+        {
+            auto row = i0 + i;
+            // Only the extremes of int64 are outside of the years
+            auto valid = year[i] >= Calendar::MINIMUM_YEAR
+                      && year[i] <= Calendar::MAXIMUM_YEAR;
+            auto milliSecond = nanoSecond[i]/NANOSECONDS_PER_MILLISECOND;
+            // The rounded reference time of an invalid year may overflow
+            auto referenceTime = valid ?
+                referenceTimes[row] - nanoSecond[i]%NANOSECONDS_PER_MILLISECOND
+                : 0;
+            std::array<float, NUMBER_OF_MARKERS> offsets;
+            valid = valid
+                 && ::encodeMarkers(markerTimes.data() + row*NUMBER_OF_MARKERS,
+                                    referenceTime, offsets);
+            invalid[row] = valid ? 0 : 1;
+            if (!valid)
+            {
+                nInvalid = nInvalid + 1;
+                continue;
+            }
+            auto *header = headers.data() + row*HEADER_LENGTH;
+            auto putInteger = [&](const size_t word, const int64_t value)
+            {
+                ::putWord(header, word, static_cast<uint32_t> (value),
+                          byteOrder);
+            };
+            putInteger(NZYEAR, year[i]);
+            putInteger(NZJDAY, dayOfYear[i]);
+            putInteger(NZHOUR, hour[i]);
+            putInteger(NZMIN, minute[i]);
+            putInteger(NZSEC, second[i]);
+            putInteger(NZMSEC, milliSecond);
+            for (size_t j = 0; j < NUMBER_OF_MARKERS; ++j)
+            {
+                ::putWord(header, MARKER_WORDS[j],
+                          std::bit_cast<uint32_t> (offsets[j]), byteOrder);
+            }
+        }
+    }
+    return nInvalid;
+}
@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <stdexcept>
+#include "time/sampleAxis.hpp"
+#include "time/calendar.hpp"
+#include "simd.hpp"
+
+using namespace Time;
+
+namespace
+{
+/// floor(a/b) for b > 0 without overflowing the intermediate products.
+int64_t floorDivide(const __int128 a, const int64_t b) noexcept
+{
+    // The 128-bit division is a slow library call
+    if (a >= std::numeric_limits<int64_t>::lowest() &&
+        a <= std::numeric_limits<int64_t>::max())
+    {
+        return Calendar::floorDivide(static_cast<int64_t> (a), b);
+    }
+    auto q = a/b;
+    if (a % b != 0 && a < 0){q = q - 1;}
+    return static_cast<int64_t> (q);
+}
+
+/// The offset of sample i, floor((i*num + den/2)/den).
+int64_t sampleOffset(const int64_t i, const int64_t numerator,
+                     const int64_t denominator) noexcept
+{
+    if (denominator == 1){return i*numerator;}
+    return floorDivide(static_cast<__int128> (i)*numerator + denominator/2,
+                       denominator);
+}
+
+/// The exact sample index at or before the time offset d.  Sample i is at
+/// floor((i*num + den/2)/den) so this is the largest i for which
+/// i*num + den/2 < (d + 1)*den.
+int64_t floorIndex(const int64_t d, const int64_t numerator,
+                   const int64_t denominator) noexcept
+{
+    if (denominator == 1){return Calendar::floorDivide(d, numerator);}
+    auto half = static_cast<__int128> (denominator/2);
+    return floorDivide((static_cast<__int128> (d) + 1)*denominator - half - 1,
+                       numerator);
+}
+
+/// The exact nearest sample index to the time offset d.  Ties go to the
+/// later sample.
+int64_t nearestIndex(const int64_t d, const int64_t numerator,
+                     const int64_t denominator) noexcept
+{
+    if (denominator == 1)
+    {
+        return Calendar::floorDivide(d + numerator/2, numerator);
+    }
+    auto i = floorIndex(d, numerator, denominator);
+    auto lower = sampleOffset(i, numerator, denominator);
+    auto upper = sampleOffset(i + 1, numerator, denominator);
+    return (upper - d <= d - lower) ? i + 1 : i;
+}
+
+/// Recurrence for the sample times: times[j] = times[j - m] + step.  Since
+/// m is at least the number of lanes the loads never overlap the stores.
+template<typename I>
+[[gnu::always_inline]] inline
+void generateLoop(int64_t *times, const size_t m, const int64_t step,
+                  const size_t n) noexcept
+{
+    constexpr auto lanes = static_cast<size_t> (SIMD::LANES<I>);
+    size_t j = m;
+    for ( ; j + lanes <= n; j = j + lanes)
+    {
+        SIMD::store(SIMD::load<I>(times + j - m) + step, times + j);
+    }
+    for ( ; j < n; ++j){times[j] = times[j - m] + step;}
+}
+
+/// floor((times[i] - origin)/numerator) for LANES<I> times at index i.
+/// The quotient is estimated with the reciprocal then corrected with the
+/// remainder.  Lanes whose remainder still is out of range, which happens
+/// only for enormous quotients, are counted in bad.
+template<typename I>
+[[gnu::always_inline]] inline
+void floorDivideKernel(const int64_t *times, int64_t *indices,
+                       const size_t i, const int64_t origin,
+                       const int64_t numerator, const double inverse,
+                       I &bad) noexcept
+{
+    using F = typename SIMD::FloatOf<I>::type;
+    // Offsets beyond 2^62 in magnitude are left to the exact division
+    // since their estimate can round to 2^63, which does not convert
+    constexpr int64_t MAXIMUM_OFFSET{int64_t {1} << 62};
+    auto d = SIMD::load<I>(times + i) - origin;
+    auto outOfRange = (d < -MAXIMUM_OFFSET) | (d > MAXIMUM_OFFSET);
+    d = SIMD::select<I>(outOfRange, SIMD::broadcast<I>(int64_t {0}), d);
+    bad = bad + SIMD::toOne<I>(outOfRange);
+    auto x = SIMD::convert<F>(d)*inverse;
+    auto q = SIMD::convert<I>(x);
+    q = q - SIMD::toOne<I>(SIMD::convert<F>(q) > x);
+    auto r = d - q*numerator;
+    q = q - SIMD::toOne<I>(r < 0) + SIMD::toOne<I>(r >= numerator);
+    r = d - q*numerator;
+    bad = bad + SIMD::toOne<I>(r < 0) + SIMD::toOne<I>(r >= numerator);
+    SIMD::store(q, indices + i);
+}
+
+/// Runs the kernel over n elements with vectors of type I and finishes
+/// the remainder with scalars.
+/// @result False if any quotient could not be verified.
+template<typename I>
+[[gnu::always_inline]] inline
+bool floorDivideLoop(const int64_t *times, int64_t *indices, const size_t n,
+                     const int64_t origin, const int64_t numerator) noexcept
+{
+    constexpr auto lanes = static_cast<size_t> (SIMD::LANES<I>);
+    const double inverse = 1.0/static_cast<double> (numerator);
+    auto bad = SIMD::broadcast<I>(int64_t {0});
+    size_t i = 0;
+    for ( ; i + lanes <= n; i = i + lanes)
+    {
+        floorDivideKernel<I>(times, indices, i, origin, numerator, inverse,
+                             bad);
+    }
+    int64_t nBad{0};
+    for ( ; i < n; ++i)
+    {
+        floorDivideKernel<int64_t>(times, indices, i, origin, numerator,
+                                   inverse, nBad);
+    }
+    for (int lane = 0; lane < SIMD::LANES<I>; ++lane)
+    {
+        if constexpr (std::is_integral_v<I>)
+        {
+            nBad = nBad + bad;
+        }
+        else
+        {
+            nBad = nBad + bad[lane];
+        }
+    }
+    return nBad == 0;
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+[[gnu::target("avx512f,avx512dq")]]
+void generateAVX512(int64_t *times, const size_t m, const int64_t step,
+                    const size_t n) noexcept
+{
+    generateLoop<SIMD::Int64x8>(times, m, step, n);
+}
+
+[[gnu::target("avx2")]]
+void generateAVX2(int64_t *times, const size_t m, const int64_t step,
+                  const size_t n) noexcept
+{
+    generateLoop<SIMD::Int64x4>(times, m, step, n);
+}
+
+[[gnu::target("avx512f,avx512dq")]]
+bool floorDivideAVX512(const int64_t *times, int64_t *indices,
+                       const size_t n, const int64_t origin,
+                       const int64_t numerator) noexcept
+{
+    return floorDivideLoop<SIMD::Int64x8>(times, indices, n, origin,
+                                          numerator);
+}
+#endif
+
+void generateScalar(int64_t *times, const size_t m, const int64_t step,
+                    const size_t n) noexcept
+{
+    generateLoop<int64_t>(times, m, step, n);
+}
+
+bool floorDivideScalar(const int64_t *times, int64_t *indices,
+                       const size_t n, const int64_t origin,
+                       const int64_t numerator) noexcept
+{
+    return floorDivideLoop<int64_t>(times, indices, n, origin, numerator);
+}
+
+/// Computes floor((times[i] - origin)/numerator) for all i.
+void floorDivide(const std::span<const int64_t> times,
+                 std::span<int64_t> indices,
+                 const int64_t origin, const int64_t numerator) noexcept
+{
+    auto n = times.size();
+    bool verified{false};
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    // AVX2 has no 64-bit integer to double conversion or multiply so only
+    // AVX-512 is vectorized
+    if (SIMD::getInstructionSet() == SIMD::InstructionSet::AVX512)
+    {
+        verified = floorDivideAVX512(times.data(), indices.data(), n,
+                                     origin, numerator);
+    }
+    else
+    {
+        verified = floorDivideScalar(times.data(), indices.data(), n,
+                                     origin, numerator);
+    }
+#else
+    verified = floorDivideScalar(times.data(), indices.data(), n,
+                                 origin, numerator);
+#endif
+    if (!verified)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            indices[i] = Calendar::floorDivide(times[i] - origin, numerator);
+        }
+    }
+}
+
+void checkIndices(const std::span<const int64_t> &times,
+                  const std::span<int64_t> &indices)
+{
+    if (indices.size() < times.size())
+    {
+        throw std::invalid_argument("indices must have length at least "
+                                  + std::to_string(times.size()));
+    }
+}
+}
+
+/// C'tor
+SamplingPeriod::SamplingPeriod(const int64_t nanoSeconds) :
+    SamplingPeriod(nanoSeconds, 1)
+{
+}
+
+SamplingPeriod::SamplingPeriod(const int64_t numerator,
+                               const int64_t denominator)
+{
+    if (numerator < 1)
+    {
+        throw std::invalid_argument("Numerator must be positive");
+    }
+    if (denominator < 1)
+    {
+        throw std::invalid_argument("Denominator must be positive");
+    }
+    auto divisor = std::gcd(numerator, denominator);
+    mNumerator = numerator/divisor;
+    mDenominator = denominator/divisor;
+}
+
+/// Period from a sampling rate
+SamplingPeriod SamplingPeriod::fromSamplingRate(const int64_t numerator,
+                                                const int64_t denominator)
+{
+    if (numerator < 1)
+    {
+        throw std::invalid_argument("Numerator must be positive");
+    }
+    if (denominator < 1)
+    {
+        throw std::invalid_argument("Denominator must be positive");
+    }
+    if (denominator > std::numeric_limits<int64_t>::max()
+                     /Calendar::NANOSECONDS_PER_SECOND)
+    {
+        throw std::invalid_argument("Sampling period is too large");
+    }
+    return SamplingPeriod{denominator*Calendar::NANOSECONDS_PER_SECOND,
+                          numerator};
+}
+
+/// Numerator
+int64_t SamplingPeriod::getNumerator() const noexcept
+{
+    return mNumerator;
+}
+
+/// Denominator
+int64_t SamplingPeriod::getDenominator() const noexcept
+{
+    return mDenominator;
+}
+
+/// Integer?
+bool SamplingPeriod::isInteger() const noexcept
+{
+    return mDenominator == 1;
+}
+
+/// Offset of a sample rounded to the nearest nanosecond
+int64_t SamplingPeriod::getOffset(const int64_t sample) const noexcept
+{
+    return sampleOffset(sample, mNumerator, mDenominator);
+}
+
+/// Generates the sample times
+void SampleAxis::generate(const int64_t startTime,
+                          const SamplingPeriod &period,
+                          std::span<int64_t> times) noexcept
+{
+    auto n = times.size();
+    // The pattern of offsets repeats every denominator samples.  Compute
+    // enough whole repetitions exactly to fill a vector.
+    constexpr int64_t maximumLanes{8};
+    auto denominator = period.getDenominator();
+    auto nRepeats = (maximumLanes + denominator - 1)/denominator;
+    auto m = static_cast<size_t> (nRepeats*denominator);
+    auto step = nRepeats*period.getNumerator();
+    for (size_t i = 0; i < std::min(m, n); ++i)
+    {
+        times[i] = startTime + period.getOffset(static_cast<int64_t> (i));
+    }
+    if (n <= m){return;}
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    auto instructionSet = SIMD::getInstructionSet();
+    if (instructionSet == SIMD::InstructionSet::AVX512)
+    {
+        generateAVX512(times.data(), m, step, n);
+        return;
+    }
+    if (instructionSet == SIMD::InstructionSet::AVX2)
+    {
+        generateAVX2(times.data(), m, step, n);
+        return;
+    }
+#endif
+    generateScalar(times.data(), m, step, n);
+}
+
+/// Floor index
+int64_t SampleAxis::toFloorIndex(const int64_t startTime,
+                                 const SamplingPeriod &period,
+                                 const int64_t time) noexcept
+{
+    return floorIndex(time - startTime, period.getNumerator(),
+                      period.getDenominator());
+}
+
+/// Nearest index
+int64_t SampleAxis::toNearestIndex(const int64_t startTime,
+                                   const SamplingPeriod &period,
+                                   const int64_t time) noexcept
+{
+    return nearestIndex(time - startTime, period.getNumerator(),
+                        period.getDenominator());
+}
+
+/// Floor indices
+void SampleAxis::toFloorIndices(const int64_t startTime,
+                                const SamplingPeriod &period,
+                                const std::span<const int64_t> times,
+                                std::span<int64_t> indices)
+{
+    checkIndices(times, indices);
+    if (period.isInteger())
+    {
+        ::floorDivide(times, indices, startTime, period.getNumerator());
+        return;
+    }
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        indices[i] = floorIndex(times[i] - startTime, period.getNumerator(),
+                                period.getDenominator());
+    }
+}
+
+/// Nearest indices
+void SampleAxis::toNearestIndices(const int64_t startTime,
+                                  const SamplingPeriod &period,
+                                  const std::span<const int64_t> times,
+                                  std::span<int64_t> indices)
+{
+    checkIndices(times, indices);
+    if (period.isInteger())
+    {
+        // Shifting the origin back by half a period rounds to the nearest
+        auto numerator = period.getNumerator();
+        ::floorDivide(times, indices, startTime - numerator/2, numerator);
+        return;
+    }
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        indices[i] = nearestIndex(times[i] - startTime, period.getNumerator(),
+                                  period.getDenominator());
+    }
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "time/sds.hpp"
+#include "time/calendar.hpp"
+
+using namespace Time;
+
+namespace
+{
+
+/// The name is only copied to a string when throwing so valid codes never
+/// allocate.
+void checkCode(const std::string_view code, const char *name,
+               const bool required)
+{
+    if (required && code.empty())
+    {
+        throw std::invalid_argument(std::string {name} + " code is empty");
+    }
+    if (code.size() > SDS::MAXIMUM_CODE_LENGTH)
+    {
+        throw std::invalid_argument(std::string {name}
+                                  + " code must have at most "
+                                  + std::to_string(SDS::MAXIMUM_CODE_LENGTH)
+                                  + " characters");
+    }
+    // Anything else, e.g., / or ., would change the layout of the path
+    auto valid = std::all_of(code.begin(), code.end(), [](const char c)
+                 {
+                     return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                            (c >= '0' && c <= '9') || c == '-' || c == '_';
+                 });
+    if (!valid)
+    {
+        throw std::invalid_argument(std::string {name}
+                                  + " code has an invalid character");
+    }
+}
+
+/// Writes the value as exactly width digits.
+char *putDigits(char *buffer, int value, const int width) noexcept
+{
+    for (int i = width - 1; i >= 0; --i)
+    {
+        buffer[i] = static_cast<char> ('0' + value%10);
+        value = value/10;
+    }
+    return buffer + width;
+}
+
+char *putCode(char *buffer, const std::string_view code,
+              const char delimiter) noexcept
+{
+    buffer = std::copy(code.begin(), code.end(), buffer);
+    *buffer = delimiter;
+    return buffer + 1;
+}
+
+}
+
+size_t SDS::formatPath(const std::string_view network,
+                       const std::string_view station,
+                       const std::string_view location,
+                       const std::string_view channel,
+                       const int year, const int dayOfYear,
+                       const std::span<char> path)
+{
+    ::checkCode(network, "Network", true);
+    ::checkCode(station, "Station", true);
+    ::checkCode(location, "Location", false);
+    ::checkCode(channel, "Channel", true);
+    if (year < Calendar::MINIMUM_YEAR || year > Calendar::MAXIMUM_YEAR)
+    {
+        throw std::invalid_argument("Year must be in range [1678,2261]");
+    }
+    auto nDays = Calendar::isLeapYear(year) ? 366 : 365;
+    if (dayOfYear < 1 || dayOfYear > nDays)
+    {
+        throw std::invalid_argument("Day of year must be in range [1,"
+                                  + std::to_string(nDays) + "]");
+    }
+    auto length = 24 + 2*network.size() + 2*station.size() + location.size()
+                + 2*channel.size();
+    if (path.size() < length)
+    {
+        throw std::invalid_argument("Path must have length at least "
+                                  + std::to_string(length));
+    }
+    auto *buffer = path.data();
+    buffer = ::putDigits(buffer, year, 4);
+    *buffer++ = '/';
+    buffer = ::putCode(buffer, network, '/');
+    buffer = ::putCode(buffer, station, '/');
+    buffer = ::putCode(buffer, channel, '.');
+    *buffer++ = 'D';
+    *buffer++ = '/';
+    buffer = ::putCode(buffer, network, '.');
+    buffer = ::putCode(buffer, station, '.');
+    buffer = ::putCode(buffer, location, '.');
+    buffer = ::putCode(buffer, channel, '.');
+    *buffer++ = 'D';
+    *buffer++ = '.';
+    buffer = ::putDigits(buffer, year, 4);
+    *buffer++ = '.';
+    ::putDigits(buffer, dayOfYear, 3);
+    return length;
+}
+
+size_t SDS::formatPath(const std::string_view network,
+                       const std::string_view station,
+                       const std::string_view location,
+                       const std::string_view channel,
+                       const Boundary &day,
+                       const std::span<char> path)
+{
+    return formatPath(network, station, location, channel,
+                      day.year, day.dayOfYear, path);
+}
@@ -0,0 +1,169 @@
+#include <string>
+#include <stdexcept>
+#include "time/seed.hpp"
+#include "time/calendar.hpp"
+
+using namespace Time;
+
+namespace
+{
+
+constexpr int64_t NANOSECONDS_PER_TICK{100000};
+/// The offsets of the activity flags and the time correction in the fixed
+/// section of the data header.
+constexpr size_t ACTIVITY_FLAGS_OFFSET{36};
+constexpr size_t TIME_CORRECTION_OFFSET{40};
+/// The activity flag indicating the time correction was applied.
+constexpr uint8_t TIME_CORRECTION_APPLIED{0x02};
+
+uint32_t getByte(const std::byte *buffer) noexcept
+{
+    return static_cast<uint32_t> (std::to_integer<uint8_t> (*buffer));
+}
+
+uint32_t getUInt16(const std::byte *buffer,
+                   const SEED::ByteOrder byteOrder) noexcept
+{
+    if (byteOrder == SEED::ByteOrder::BigEndian)
+    {
+        return (getByte(buffer) << 8) | getByte(buffer + 1);
+    }
+    return getByte(buffer) | (getByte(buffer + 1) << 8);
+}
+
+int32_t getInt32(const std::byte *buffer,
+                 const SEED::ByteOrder byteOrder) noexcept
+{
+    uint32_t result{0};
+    if (byteOrder == SEED::ByteOrder::BigEndian)
+    {
+        result = (getByte(buffer) << 24) | (getByte(buffer + 1) << 16)
+               | (getByte(buffer + 2) << 8) | getByte(buffer + 3);
+    }
+    else
+    {
+        result = getByte(buffer) | (getByte(buffer + 1) << 8)
+               | (getByte(buffer + 2) << 16) | (getByte(buffer + 3) << 24);
+    }
+    return static_cast<int32_t> (result);
+}
+
+/// Decodes a BTIME.  Every field is checked before branching once on the
+/// result.
+/// @result False indicates a field is out of range.
+bool decode(const std::byte *btime, const SEED::ByteOrder byteOrder,
+            int64_t &epoch) noexcept
+{
+    auto year = static_cast<int> (getUInt16(btime, byteOrder));
+    auto dayOfYear = static_cast<int> (getUInt16(btime + 2, byteOrder));
+    auto hour = getByte(btime + 4);
+    auto minute = getByte(btime + 5);
+    auto second = getByte(btime + 6);
+    auto ticks = getUInt16(btime + 8, byteOrder);
+    bool valid = (year >= Calendar::MINIMUM_YEAR)
+               & (year <= Calendar::MAXIMUM_YEAR)
+               & (dayOfYear >= 1)
+               & (dayOfYear <= 365 + static_cast<int> (Calendar::isLeapYear(year)))
+               & (hour <= 23) & (minute <= 59) & (second <= 60)
+               & (ticks <= 9999);
+    if (!valid){return false;}
+    auto days = Calendar::daysFromCivil(year, 1, 1) + dayOfYear - 1;
+    epoch = days*Calendar::NANOSECONDS_PER_DAY
+          + static_cast<int64_t> (hour*3600 + minute*60 + second)
+           *Calendar::NANOSECONDS_PER_SECOND
+          + static_cast<int64_t> (ticks)*NANOSECONDS_PER_TICK;
+    return true;
+}
+
+/// Decodes the start time of a record.
+bool decodeRecord(const std::byte *record, const SEED::ByteOrder byteOrder,
+                  int64_t &epoch) noexcept
+{
+    if (!decode(record + SEED::START_TIME_OFFSET, byteOrder, epoch))
+    {
+        return false;
+    }
+    auto activityFlags = getByte(record + ACTIVITY_FLAGS_OFFSET);
+    if ((activityFlags & TIME_CORRECTION_APPLIED) == 0)
+    {
+        epoch = epoch
+              + static_cast<int64_t> (getInt32(record + TIME_CORRECTION_OFFSET,
+                                               byteOrder))
+               *NANOSECONDS_PER_TICK;
+    }
+    return true;
+}
+
+}
+
+/// BTIME
+int64_t SEED::fromBTIME(const std::span<const std::byte> btime,
+                        const ByteOrder byteOrder)
+{
+    if (btime.size() < BTIME_LENGTH)
+    {
+        throw std::invalid_argument("BTIME must have at least "
+                                  + std::to_string(BTIME_LENGTH) + " bytes");
+    }
+    int64_t epoch{0};
+    if (!::decode(btime.data(), byteOrder, epoch))
+    {
+        throw std::invalid_argument("BTIME has a field out of range");
+    }
+    return epoch;
+}
+
+/// Record start time
+int64_t SEED::getRecordStartTime(const std::span<const std::byte> record,
+                                 const ByteOrder byteOrder)
+{
+    if (record.size() < FIXED_HEADER_LENGTH)
+    {
+        throw std::invalid_argument("Record must have at least "
+                                  + std::to_string(FIXED_HEADER_LENGTH)
+                                  + " bytes");
+    }
+    int64_t epoch{0};
+    if (!::decodeRecord(record.data(), byteOrder, epoch))
+    {
+        throw std::invalid_argument("Start time has a field out of range");
+    }
+    return epoch;
+}
+
+/// Record start times
+size_t SEED::getRecordStartTimes(const std::span<const std::byte> records,
+                                 const size_t recordLength,
+                                 std::span<int64_t> startTimes,
+                                 std::span<uint8_t> invalid,
+                                 const ByteOrder byteOrder)
+{
+    if (recordLength < FIXED_HEADER_LENGTH)
+    {
+        throw std::invalid_argument("Record length must be at least "
+                                  + std::to_string(FIXED_HEADER_LENGTH));
+    }
+    if (records.size() % recordLength != 0)
+    {
+        throw std::invalid_argument("Records must be a multiple of "
+                                  + std::to_string(recordLength) + " bytes");
+    }
+    auto nRecords = records.size()/recordLength;
+    if (startTimes.size() < nRecords || invalid.size() < nRecords)
+    {
+        throw std::invalid_argument("Outputs must have length at least "
+                                  + std::to_string(nRecords));
+    }
+    size_t nInvalid{0};
+    const auto *record = records.data();
+    for (size_t i = 0; i < nRecords; ++i)
+    {
+        int64_t epoch{0};
+        auto valid = ::decodeRecord(record, byteOrder, epoch);
+        startTimes[i] = valid ? epoch : 0;
+        invalid[i] = valid ? 0 : 1;
+        nInvalid = nInvalid + (valid ? 0 : 1);
+        record = record + recordLength;
+    }
+    return nInvalid;
+}
@@ -0,0 +1,15 @@
+#include "time/sort.hpp"
+
+using namespace Time;
+
+/// Sort nanoseconds
+void Sort::sort(const std::span<int64_t> times)
+{
+    Internal::radixSort(times, [](const int64_t time){return time;});
+}
+
+/// Sort times
+void Sort::sort(const std::span<UTC> times)
+{
+    Internal::radixSort(times, [](const UTC &time){return time;});
+}
@@ -2,492 +2,567 @@
 #ifdef WITH_DATE
 #include <date/date.h>
 #endif
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <cmath>
 #include <chrono>
-#include <cassert>
+#include <stdexcept>
 #include "time/utc.hpp"
+#include "time/clock.hpp"
+#include "time/calendar.hpp"
+#include "iso8601.hpp"
+#include "dayCacheEntry.hpp"
 
 using namespace Time;
 
-class UTC::UTCImpl
-{
-public:
-    /// Sets a date based on the epochal time
-    void updateEpoch(const double timeStamp)
-    {   
-        // Figure out the fractional second 
-        auto iUTCStamp = static_cast<int64_t> (timeStamp);
-        auto fraction = timeStamp - static_cast<double> (iUTCStamp);
-        mMicroSecond = static_cast<int> (std::lround(fraction*1.e6));
-        // Create the epochal time
-        std::chrono::seconds chronoSeconds(iUTCStamp);
-        std::chrono::system_clock::time_point timePoint{chronoSeconds};
-        // Set the year/month/day
-        auto dayPoint = std::chrono::floor<std::chrono::days> (timePoint);
-        std::chrono::year_month_day ymd{dayPoint};
-        auto year = static_cast<int> (ymd.year());
-        auto month = static_cast<int> (unsigned(ymd.month()));
-        auto dom = static_cast<int> (unsigned(ymd.day()));
-        updateYear(year);
-        updateMonth(month);
-        updateDayOfMonth(dom);
-        // Update hour/minute/second        
-        std::chrono::hh_mm_ss tod{timePoint - dayPoint};
-        auto hour = static_cast<int> (tod.hours().count());
-        auto minute = static_cast<int> (tod.minutes().count());
-        auto second = static_cast<int> (tod.seconds().count());
-        updateHour(hour);
-        updateMinute(minute);
-        updateSecond(second);
-        // I have the epoch
-        mEpoch = timeStamp;
-        mHaveEpoch = true;
-    }   
-    /// Updates the year
-    void updateYear(const int year)
-    {
-        mYear = std::chrono::year{year};
-        mYMD = std::chrono::year_month_day{mYear, mMonth, mDay};
-#ifndef NDEBUG
-        assert(mYMD.ok());
-#endif
-        updateDayOfYear();
-    }
-    void updateMonth(const int month)
-    {
-        mMonth = std::chrono::month{static_cast<unsigned int> (month)};
-        mYMD = std::chrono::year_month_day{mYear, mMonth, mDay};
-#ifndef NDEBUG
-        assert(mYMD.ok());
-#endif
-        updateDayOfYear();
-    }
-    void updateDayOfMonth(const int day)
-    {
-        mDay = std::chrono::day{static_cast<unsigned int> (day)};
-        mYMD = std::chrono::year_month_day{mYear, mMonth, mDay}; 
-#ifndef NDEBUG
-        assert(mYMD.ok());
-#endif
-        updateDayOfYear();
-    }
-    // Updates the hour
-    void updateHour(const int hour)
-    {
-        mHour = std::chrono::hours{hour};
-        mHMS = std::chrono::hh_mm_ss<std::chrono::seconds> {mHour + mMinute + mSecond};
-        mHaveEpoch = false;
-    }
-    // Updates the minute
-    void updateMinute(const int minute)
-    {
-        mMinute = std::chrono::minutes{minute};
-        mHMS = std::chrono::hh_mm_ss<std::chrono::seconds> {mHour + mMinute + mSecond};
-        mHaveEpoch = false;
-    }
-    // Updates the second
-    void updateSecond(const int second)
-    {
-        mSecond = std::chrono::seconds{second};
-        mHMS = std::chrono::hh_mm_ss<std::chrono::seconds> {mHour + mMinute + mSecond};
-        mHaveEpoch = false;
-    }
-    // Updates the microsecond
-    void updateMicroSecond(const int muSec)
-    {
-        mMicroSecond = muSec;
-        mHaveEpoch = false;
-    }
-    // Updates the day of the year
-    void updateDayOfYear()
-    {
-        mStartOfYear = std::chrono::year_month_day{mYear, std::chrono::month{1}, std::chrono::day{1}};
-#ifndef NDEBUG
-        assert(mStartOfYear.ok());
-#endif
-        auto jday = std::chrono::sys_days{mYMD} - std::chrono::sys_days{mStartOfYear};
-        mDayOfYear = static_cast<int> (jday.count()) + 1;
-        mHaveEpoch = false;
-    }
-    // Update the the month and day of month given the day of the year
-    void updateMonthAndDay(int doy)
-    {
-        mYMD = std::chrono::year_month_day{std::chrono::days{doy - 1}
-                                         + std::chrono::sys_days{mStartOfYear}};
-#ifndef NDEBUG
-        assert(mYMD.ok());
-#endif
-        mMonth = mYMD.month();
-        mDay   = mYMD.day();
-        mDayOfYear = doy;
-        mHaveEpoch = false;
-    }
+namespace
+{
+/// Times set from seconds must be in the years [1678,2261].
+constexpr double MINIMUM_EPOCH{static_cast<double> (
+    Calendar::toEpoch(Calendar::MINIMUM_YEAR, 1, 1, 0, 0, 0, 0)
+   /Calendar::NANOSECONDS_PER_SECOND)};
+constexpr double MAXIMUM_EPOCH{static_cast<double> (
+    Calendar::toEpoch(Calendar::MAXIMUM_YEAR + 1, 1, 1, 0, 0, 0, 0)
+   /Calendar::NANOSECONDS_PER_SECOND)};
+/// Offsets in seconds must be less than this in magnitude.
+constexpr double MAXIMUM_OFFSET{9.2e9};
 
-    std::chrono::year mYear{1970};
-    std::chrono::month mMonth{1};
-    std::chrono::day mDay{1};
-    std::chrono::year_month_day mYMD{mYear, mMonth, mDay};
-    std::chrono::year_month_day mStartOfYear{mYear, mMonth, mDay};
-    std::chrono::hours mHour{0};
-    std::chrono::minutes mMinute{0};
-    std::chrono::seconds mSecond{0};
-    std::chrono::hh_mm_ss<std::chrono::seconds> mHMS{mHour + mMinute + mSecond};
-    double mEpoch = 0;
-    int mDayOfYear = 1;
-    int mMicroSecond = 0;
-    bool mHaveEpoch = true;
-};
+/// Converts seconds to nanoseconds rounded to the nearest microsecond.  A
+/// fraction that rounds up to 1000000 microseconds carries into the second.
+/// @note The seconds must be finite and less than MAXIMUM_OFFSET in
+///       magnitude.
+int64_t toNanoSeconds(const double seconds) noexcept
+{
+    auto wholeSeconds = std::floor(seconds);
+    auto microSeconds = std::llround((seconds - wholeSeconds)*1.e6);
+    return static_cast<int64_t> (wholeSeconds)*Calendar::NANOSECONDS_PER_SECOND
+         + microSeconds*Calendar::NANOSECONDS_PER_MICROSECOND;
+}
 
-/// C'tor
-UTC::UTC() :
-    pImpl(std::make_unique<UTCImpl> ())
+/// @result The offset in nanoseconds rounded to the nearest microsecond.
+/// @throws std::invalid_argument if the offset is not finite or too large.
+Duration toOffset(const double seconds)
 {
+    // This is false for NaN
+    if (!(std::abs(seconds) < MAXIMUM_OFFSET))
+    {
+        throw std::invalid_argument("Offset must be finite and less than "
+                                    "9.2e9 seconds in magnitude");
+    }
+    return Duration {::toNanoSeconds(seconds)};
 }
 
-UTC::UTC(const double epoch) :
-    pImpl(std::make_unique<UTCImpl> ())
+/// The calendar fields of a time.
+struct Fields
 {
-    setEpoch(epoch);
+    int year{1970};
+    int month{1};
+    int dayOfMonth{1};
+    int dayOfYear{1};
+    int hour{0};
+    int minute{0};
+    int second{0};
+};
+
+/// Packs the fields into a single word.  Bit 0 flags the word as valid.
+uint64_t pack(const Fields &fields) noexcept
+{
+    return 1
+         | (static_cast<uint64_t> (fields.hour)       << 1)
+         | (static_cast<uint64_t> (fields.minute)     << 6)
+         | (static_cast<uint64_t> (fields.second)     << 12)
+         | (static_cast<uint64_t> (fields.dayOfMonth) << 18)
+         | (static_cast<uint64_t> (fields.month)      << 23)
+         | (static_cast<uint64_t> (fields.dayOfYear)  << 27)
+         | (static_cast<uint64_t> (static_cast<uint16_t> (fields.year)) << 36);
 }
 
-UTC::UTC(const std::chrono::microseconds &epoch) :
-    pImpl(std::make_unique<UTCImpl> ())
+/// Unpacks the fields from a word created by pack().
+Fields unpack(const uint64_t word) noexcept
 {
-    setEpoch(epoch);
+    Fields fields;
+    fields.hour       = static_cast<int> ((word >> 1)  & 0x1F);
+    fields.minute     = static_cast<int> ((word >> 6)  & 0x3F);
+    fields.second     = static_cast<int> ((word >> 12) & 0x3F);
+    fields.dayOfMonth = static_cast<int> ((word >> 18) & 0x1F);
+    fields.month      = static_cast<int> ((word >> 23) & 0x0F);
+    fields.dayOfYear  = static_cast<int> ((word >> 27) & 0x1FF);
+    fields.year = static_cast<int16_t> (static_cast<uint16_t> (word >> 36));
+    return fields;
 }
 
-UTC::UTC(const std::string &time) :
-    pImpl(std::make_unique<UTCImpl> ())
+/// Sets the date fields from the days since the epoch.  If the calling
+/// thread enabled the day cache then the last day is memoized.
+void setDate(const int64_t days, Fields &fields) noexcept
 {
-    int year;
-    int month;
-    int dom;
-    int hour;
-    int minute;
-    int second;
-    int microSecond = 0;
-    if (time.size() == 26)
+    auto cache = Internal::getDayCacheEntry();
+    if (cache != nullptr && cache->day == days)
     {
-        sscanf(time.c_str(),
-               "%04d-%02d-%02dT%02d:%02d:%02d.%06d",
-               &year, &month, &dom, &hour, &minute, &second, &microSecond); 
+        cache->hits = cache->hits + 1;
+        fields.year = cache->year;
+        fields.month = cache->month;
+        fields.dayOfMonth = cache->dayOfMonth;
+        fields.dayOfYear = cache->dayOfYear;
+        return;
     }
-    else if (time.size() == 19)
+    auto date = Calendar::civilFromDays(days);
+    fields.year = date.year;
+    fields.month = date.month;
+    fields.dayOfMonth = date.dayOfMonth;
+    fields.dayOfYear = static_cast<int> (days
+                     - Calendar::daysFromCivil(date.year, 1, 1)) + 1;
+    if (cache != nullptr)
     {
-        sscanf(time.c_str(),
-               "%04d-%02d-%02dT%02d:%02d:%02d",
-               &year, &month, &dom, &hour, &minute, &second); 
+        cache->misses = cache->misses + 1;
+        cache->day = days;
+        cache->year = fields.year;
+        cache->month = fields.month;
+        cache->dayOfMonth = fields.dayOfMonth;
+        cache->dayOfYear = fields.dayOfYear;
     }
-    else
+}
+
+/// Decomposes the nanoseconds since the epoch into calendar fields.
+Fields decompose(const int64_t epoch) noexcept
+{
+    auto days = Calendar::floorDivide(epoch, Calendar::NANOSECONDS_PER_DAY);
+    // Wraps at the extremes of int64 but the remainder is exact
+    auto nanoSecondOfDay
+        = static_cast<uint64_t> (epoch)
+        - static_cast<uint64_t> (days)
+         *static_cast<uint64_t> (Calendar::NANOSECONDS_PER_DAY);
+    auto secondOfDay
+        = static_cast<int> (nanoSecondOfDay
+                           /static_cast<uint64_t> (Calendar::NANOSECONDS_PER_SECOND));
+    Fields fields;
+    setDate(days, fields);
+    fields.hour = secondOfDay/3600;
+    fields.minute = (secondOfDay % 3600)/60;
+    fields.second = secondOfDay % 60;
+    return fields;
+}
+
+/// Returns the calendar fields.  These are computed only if the cache
+/// is empty.  Const getters on several threads may race to fill the cache
+/// but they all store the same word, so relaxed atomics suffice.
+Fields getFields(const int64_t epoch, uint64_t &calendar) noexcept
+{
+    std::atomic_ref<uint64_t> cache{calendar};
+    auto word = cache.load(std::memory_order_relaxed);
+    if (word == 0)
     {
-        std::string errmsg = "Cannot parse " + time + " with length = "
-                           + std::to_string(time.size());
-        throw std::invalid_argument(errmsg);
+        word = pack(decompose(epoch));
+        cache.store(word, std::memory_order_relaxed);
     }
-    UTC temp;
-    temp.setYear(year);
-    temp.setMonthAndDay(std::pair<int, int> (month, dom));
-    temp.setHour(hour);
-    temp.setMinute(minute);
-    temp.setSecond(second);
-    temp.setMicroSecond(microSecond);
-    *this = std::move(temp);
+    return unpack(word);
 }
 
+/// Returns the nanoseconds past the second.
+int64_t getSubSecond(const int64_t epoch) noexcept
+{
+    return Calendar::floorModulo(epoch, Calendar::NANOSECONDS_PER_SECOND);
+}
 
+/// Replaces the time of day in a packed calendar word.
+uint64_t setTimeOfDay(const uint64_t word, const int secondOfDay) noexcept
+{
+    constexpr uint64_t timeOfDayMask{0x3FFFE}; // Bits 1 through 17
+    auto hour = static_cast<uint64_t> (secondOfDay/3600);
+    auto minute = static_cast<uint64_t> ((secondOfDay % 3600)/60);
+    auto second = static_cast<uint64_t> (secondOfDay % 60);
+    return (word & ~timeOfDayMask) | (hour << 1) | (minute << 6)
+         | (second << 12);
+}
 
-/// Copy assignment
-UTC::UTC(const UTC &time)
+/// Advances the epoch and, if the day does not change, the time of day
+/// in the calendar cache.  Otherwise the cache is invalidated.
+void advance(const int64_t duration, int64_t &epoch, uint64_t &calendar) noexcept
 {
-    *this = time;
+    auto newEpoch = epoch + duration;
+    if (calendar != 0)
+    {
+        auto startOfDay = epoch - Calendar::floorModulo(epoch,
+                                                Calendar::NANOSECONDS_PER_DAY);
+        auto offset = newEpoch - startOfDay;
+        if (offset >= 0 && offset < Calendar::NANOSECONDS_PER_DAY)
+        {
+            auto secondOfDay = static_cast<int>
+                               (offset/Calendar::NANOSECONDS_PER_SECOND);
+            calendar = setTimeOfDay(calendar, secondOfDay);
+        }
+        else
+        {
+            calendar = 0;
+        }
+    }
+    epoch = newEpoch;
 }
 
-/// Move assignment
-UTC::UTC(UTC &&time) noexcept
+/// Recomposes the epoch from the calendar fields, the day of the year
+/// is ignored, and updates the cache.
+void compose(const Fields &fields, const int64_t subSecond,
+             int64_t &epoch, uint64_t &calendar) noexcept
 {
-    *this = std::move(time);
+    auto days = Calendar::daysFromCivil(fields.year, fields.month,
+                                        fields.dayOfMonth);
+    auto secondOfDay = static_cast<int64_t> (fields.hour*3600
+                                           + fields.minute*60
+                                           + fields.second);
+    epoch = days*Calendar::NANOSECONDS_PER_DAY
+          + secondOfDay*Calendar::NANOSECONDS_PER_SECOND
+          + subSecond;
+    // The date may have normalized, e.g., Feb 29 in a non-leap year
+    Fields result{fields};
+    setDate(days, result);
+    calendar = pack(result);
+}
 }
 
-/// Copy assignment
-UTC& UTC::operator=(const UTC &time)
+/// C'tor
+UTC::UTC(const double epoch)
 {
-    if (&time == this){return *this;}
-    pImpl = std::make_unique<UTCImpl> (*time.pImpl);
-    return *this;
+    setEpoch(epoch);
 }
 
-/// Move assignment
-UTC& UTC::operator=(UTC &&time) noexcept
+/// Parse a time stamp
+int64_t UTC::parse(const std::string_view time)
 {
-    if (&time == this){return *this;}
-    pImpl = std::move(time.pImpl);
-    return *this;
-} 
+    int64_t epoch{0};
+    if (!ISO8601::parse(time, epoch))
+    {
+        throw std::invalid_argument("Cannot parse " + std::string {time});
+    }
+    return epoch;
+}
 
-/// Destructor
-UTC::~UTC() = default;
+Expected<UTC> UTC::tryParse(const std::string_view time) noexcept
+{
+    int64_t epoch{0};
+    if (!ISO8601::parse(time, epoch)){return Error::InvalidTimeStamp;}
+    return UTC{std::chrono::nanoseconds {epoch}};
+}
 
-/// Reset class by reconstituting initial implementation 
+/// Create from components
+Expected<UTC> UTC::fromComponents(const int year, const int month,
+                                  const int dayOfMonth,
+                                  const int hour, const int minute,
+                                  const int second,
+                                  const int nanoSecond) noexcept
+{
+    if (year < Calendar::MINIMUM_YEAR || year > Calendar::MAXIMUM_YEAR)
+    {
+        return Error::YearOutOfRange;
+    }
+    if (month < 1 || month > 12){return Error::MonthOutOfRange;}
+    if (dayOfMonth < 1 || dayOfMonth > Calendar::daysInMonth(year, month))
+    {
+        return Error::DayOfMonthOutOfRange;
+    }
+    if (hour < 0 || hour > 23){return Error::HourOutOfRange;}
+    if (minute < 0 || minute > 59){return Error::MinuteOutOfRange;}
+    if (second < 0 || second > 59){return Error::SecondOutOfRange;}
+    if (nanoSecond < 0 || nanoSecond > 999999999)
+    {
+        return Error::NanoSecondOutOfRange;
+    }
+    return UTC{std::chrono::nanoseconds {
+        Calendar::toEpoch(year, month, dayOfMonth,
+                          hour, minute, second, nanoSecond)}};
+}
+
+/// Reset class
 void UTC::clear() noexcept
 {
-    pImpl = std::make_unique<UTCImpl> ();
+    *this = UTC{};
 }
 
 /// Set time to now
 void UTC::now() noexcept
 {
-    auto time = std::chrono::system_clock::now().time_since_epoch();
-    auto timeStamp
-        = static_cast<double>
-          (std::chrono::duration_cast<std::chrono::microseconds> (time).count())
-         *1.e-6;
-    setEpoch(timeStamp);
+    setEpoch(Clock::now());
+}
+
+std::chrono::nanoseconds UTC::nowEpoch() noexcept
+{
+    return Clock::now();
 }
 
 /// Get epochal time
 double UTC::getEpoch() const noexcept
 {
-    if (!pImpl->mHaveEpoch)
-    {
-        std::chrono::sys_days daysPassed{pImpl->mYMD};
-        auto t = daysPassed.time_since_epoch() + pImpl->mHMS.to_duration();
-        auto integralEpoch = static_cast<int64_t> (t.count());
-        pImpl->mEpoch = integralEpoch + getMicroSecond()*1.e-6;
-        pImpl->mHaveEpoch = true;
-    }
-    return pImpl->mEpoch;
+    auto seconds = Calendar::floorDivide(mEpoch,
+                                         Calendar::NANOSECONDS_PER_SECOND);
+    return static_cast<double> (seconds)
+         + static_cast<double> (getSubSecond(mEpoch))*1.e-9;
 }
 
-void UTC::setEpoch(const std::chrono::microseconds &timeStampMuSeconds) noexcept
+void UTC::setEpoch(const std::chrono::nanoseconds &timeStamp) noexcept
 {
-    auto timeStamp = static_cast<double> (timeStampMuSeconds.count())*1.e-6;
-    setEpoch(timeStamp);
+    mEpoch = timeStamp.count();
+    mCalendar = 0;
 }
 
-void UTC::setEpoch(const double timeStamp) noexcept
+Expected<void> UTC::trySetEpoch(const double timeStamp) noexcept
 {
-    pImpl->updateEpoch(timeStamp);
+    // This is false for NaN
+    if (!(timeStamp >= MINIMUM_EPOCH && timeStamp < MAXIMUM_EPOCH))
+    {
+        return Error::EpochOutOfRange;
+    }
+    mEpoch = ::toNanoSeconds(timeStamp);
+    mCalendar = 0;
+    return {};
 }
 
-std::chrono::microseconds UTC::getEpochInMicroSeconds() const noexcept
+void UTC::setEpoch(const double timeStamp)
 {
-    auto epoch = getEpoch(); 
-    std::chrono::microseconds
-        result{static_cast<int64_t> (std::round(epoch*1.e6))};
-    return result;
+    trySetEpoch(timeStamp).value();
 }
 
 /// Year
-void UTC::setYear(const int year)
+Expected<void> UTC::trySetYear(const int year) noexcept
 {
-    if (year < -1000 || year > 2999)
+    if (year < Calendar::MINIMUM_YEAR || year > Calendar::MAXIMUM_YEAR)
     {
-        throw std::invalid_argument("Year must be in range [-1000,2999]");
+        return Error::YearOutOfRange;
     }
-    pImpl->updateYear(year);
+    auto fields = ::getFields(mEpoch, mCalendar);
+    fields.year = year;
+    ::compose(fields, ::getSubSecond(mEpoch), mEpoch, mCalendar);
+    return {};
+}
+
+void UTC::setYear(const int year)
+{
+    trySetYear(year).value();
 }
 
 int UTC::getYear() const noexcept
 {
-    return int(pImpl->mYear);
+    return ::getFields(mEpoch, mCalendar).year;
 }
 
 bool UTC::isLeapYear() const noexcept
 {
-    return pImpl->mYear.is_leap();
+    return Calendar::isLeapYear(getYear());
 }
 
 /// Month and day of month
-void UTC::setMonthAndDay(const std::pair<int, int> &monthAndDay)
+Expected<void>
+UTC::trySetMonthAndDay(const std::pair<int, int> &monthAndDay) noexcept
 {
     auto month = monthAndDay.first;
     auto dayOfMonth = monthAndDay.second;
-    if (month < 1 || month > 12) 
-    {   
-        throw std::invalid_argument("Month must be in range [1,12]");
+    if (month < 1 || month > 12){return Error::MonthOutOfRange;}
+    auto fields = ::getFields(mEpoch, mCalendar);
+    if (dayOfMonth < 1 || dayOfMonth > Calendar::daysInMonth(fields.year, month))
+    {
+        return Error::DayOfMonthOutOfRange;
     }
-    if (dayOfMonth < 1 || dayOfMonth > 31)
+    fields.month = month;
+    fields.dayOfMonth = dayOfMonth;
+    ::compose(fields, ::getSubSecond(mEpoch), mEpoch, mCalendar);
+    return {};
+}
+
+void UTC::setMonthAndDay(const std::pair<int, int> &monthAndDay)
+{
+    auto result = trySetMonthAndDay(monthAndDay);
+    if (!result && result.error() == Error::DayOfMonthOutOfRange)
     {
-        throw std::invalid_argument("Day of month must be in range [1,31]");
+        auto maxDay = Calendar::daysInMonth(getYear(), monthAndDay.first);
+        throw std::invalid_argument("Day of month must be in range [1,"
+                                  + std::to_string(maxDay) + "]");
     }
-    pImpl->updateMonth(month);
-    pImpl->updateDayOfMonth(dayOfMonth);
+    result.value();
 }
 
 std::pair<int, int> UTC::getMonthAndDay() const noexcept
 {
-    return std::make_pair<int, int> (getMonth(), getDayOfMonth());
+    auto fields = ::getFields(mEpoch, mCalendar);
+    return std::pair<int, int> (fields.month, fields.dayOfMonth);
 }
 
 int UTC::getMonth() const noexcept
 {
-    return static_cast<int> (unsigned(pImpl->mMonth));
+    return ::getFields(mEpoch, mCalendar).month;
 }
 
 int UTC::getDayOfMonth() const noexcept
 {
-    return static_cast<int> (unsigned(pImpl->mDay));
+    return ::getFields(mEpoch, mCalendar).dayOfMonth;
 }
 
 /// Day of the year
+Expected<void> UTC::trySetDayOfYear(const int doy) noexcept
+{
+    auto fields = ::getFields(mEpoch, mCalendar);
+    auto nDays = Calendar::isLeapYear(fields.year) ? 366 : 365;
+    if (doy < 1 || doy > nDays){return Error::DayOfYearOutOfRange;}
+    auto date = Calendar::civilFromDays(
+        Calendar::daysFromCivil(fields.year, 1, 1) + doy - 1);
+    fields.month = date.month;
+    fields.dayOfMonth = date.dayOfMonth;
+    ::compose(fields, ::getSubSecond(mEpoch), mEpoch, mCalendar);
+    return {};
+}
+
 void UTC::setDayOfYear(const int doy)
 {
-    if (isLeapYear())
+    if (!trySetDayOfYear(doy))
     {
-        if (doy < 1 || doy > 366)
-        {
-            throw std::invalid_argument("Day of year must be in range [1,366]");
-        }
-    }
-    else
-    {
-        if (doy < 1 || doy > 365)
-        {
-            throw std::invalid_argument("Day of year must be in range [1,365]");
-        }
+        throw std::invalid_argument(isLeapYear() ?
+                                    "Day of year must be in range [1,366]" :
+                                    "Day of year must be in range [1,365]");
     }
-    pImpl->updateMonthAndDay(doy);
 }
 
 int UTC::getDayOfYear() const noexcept
 {
-    return pImpl->mDayOfYear;
+    return ::getFields(mEpoch, mCalendar).dayOfYear;
 }
 
 /// Hour
+Expected<void> UTC::trySetHour(const int hour) noexcept
+{
+    if (hour < 0 || hour > 23){return Error::HourOutOfRange;}
+    auto fields = ::getFields(mEpoch, mCalendar);
+    fields.hour = hour;
+    ::compose(fields, ::getSubSecond(mEpoch), mEpoch, mCalendar);
+    return {};
+}
+
 void UTC::setHour(const int hour)
 {
-    if (hour < 0 || hour > 23)
-    {
-       throw std::invalid_argument("Hour must be in range [0,23]");
-    }
-    pImpl->updateHour(hour);
+    trySetHour(hour).value();
 }
 
 int UTC::getHour() const noexcept
 {
-    return static_cast<int> (pImpl->mHMS.hours().count());
+    return ::getFields(mEpoch, mCalendar).hour;
 }
 
 /// Minute
+Expected<void> UTC::trySetMinute(const int minute) noexcept
+{
+    if (minute < 0 || minute > 59){return Error::MinuteOutOfRange;}
+    auto fields = ::getFields(mEpoch, mCalendar);
+    fields.minute = minute;
+    ::compose(fields, ::getSubSecond(mEpoch), mEpoch, mCalendar);
+    return {};
+}
+
 void UTC::setMinute(const int minute)
 {
-    if (minute < 0 || minute > 59)
-    {
-        throw std::invalid_argument("Minute must be in range [0,59]");
-    }
-    pImpl->updateMinute(minute);
+    trySetMinute(minute).value();
 }
 
 int UTC::getMinute() const noexcept
 {
-    return static_cast<int> (pImpl->mHMS.minutes().count());
+    return ::getFields(mEpoch, mCalendar).minute;
 }
 
 /// Second
+Expected<void> UTC::trySetSecond(const int second) noexcept
+{
+    if (second < 0 || second > 59){return Error::SecondOutOfRange;}
+    auto fields = ::getFields(mEpoch, mCalendar);
+    fields.second = second;
+    ::compose(fields, ::getSubSecond(mEpoch), mEpoch, mCalendar);
+    return {};
+}
+
 void UTC::setSecond(const int second)
 {
-    if (second < 0 || second > 59)
-    {
-        throw std::invalid_argument("Second must be in range [0,59]");
-    }
-    pImpl->updateSecond(second);
+    trySetSecond(second).value();
 }
 
 int UTC::getSecond() const noexcept
 {
-    return static_cast<int> (pImpl->mHMS.seconds().count());
+    return ::getFields(mEpoch, mCalendar).second;
 } 
 
 /// Microsecond
-void UTC::setMicroSecond(const int muSec)
+Expected<void> UTC::trySetMicroSecond(const int muSec) noexcept
 {
-    if (muSec < 0 || muSec > 999999)
-    {
-        throw std::invalid_argument("Microsecond must be in range [0,999999]");
-    }
-    pImpl->mMicroSecond = muSec;
+    if (muSec < 0 || muSec > 999999){return Error::MicroSecondOutOfRange;}
+    mEpoch = mEpoch - ::getSubSecond(mEpoch)
+           + muSec*Calendar::NANOSECONDS_PER_MICROSECOND;
+    return {};
 }
 
-int UTC::getMicroSecond() const noexcept
+void UTC::setMicroSecond(const int muSec)
 {
-    return pImpl->mMicroSecond;
+    trySetMicroSecond(muSec).value();
 }
 
-/// Swap times
-void Time::swap(UTC &lhs, UTC &rhs)
+int UTC::getMicroSecond() const noexcept
 {
-    std::swap(lhs.pImpl, rhs.pImpl);
+    return static_cast<int> (::getSubSecond(mEpoch)
+                            /Calendar::NANOSECONDS_PER_MICROSECOND);
 }
 
-/// Add times
-UTC Time::operator+(const UTC &x, const UTC &y) 
+/// Nanosecond
+Expected<void> UTC::trySetNanoSecond(const int nanoSec) noexcept
 {
-    return x + y.getEpoch();
+    if (nanoSec < 0 || nanoSec > 999999999)
+    {
+        return Error::NanoSecondOutOfRange;
+    }
+    mEpoch = mEpoch - ::getSubSecond(mEpoch) + nanoSec;
+    return {};
 }
 
-UTC Time::operator+(const UTC &x, const double y)
+void UTC::setNanoSecond(const int nanoSec)
 {
-    auto t = x.getEpoch() + y;
-    UTC tout(t);
-    return tout;
+    trySetNanoSecond(nanoSec).value();
 }
 
-/// Subtract times
-UTC Time::operator-(const UTC &x, const UTC &y) 
+int UTC::getNanoSecond() const noexcept
 {
-    return x - y.getEpoch();
+    return static_cast<int> (::getSubSecond(mEpoch));
 }
 
-UTC Time::operator-(const UTC &x, const double y)
+/// Advance in place
+UTC& UTC::operator+=(const Duration duration) noexcept
 {
-    auto t = x.getEpoch() - y;
-    UTC tout(t);
-    return tout;
+    ::advance(duration.count(), mEpoch, mCalendar);
+    return *this;
 }
 
-/// lhs == rhs
-bool Time::operator==(const UTC &lhs, const UTC &rhs)
+UTC& UTC::operator-=(const Duration duration) noexcept
 {
-    if (lhs.getYear()       != rhs.getYear()){return false;}
-    if (lhs.getMonth()      != rhs.getMonth()){return false;}
-    if (lhs.getDayOfYear()  != rhs.getDayOfYear()){return false;}
-    if (lhs.getDayOfMonth() != rhs.getDayOfMonth()){return false;}
-    if (lhs.getHour()       != rhs.getHour()){return false;}
-    if (lhs.getMinute()     != rhs.getMinute()){return false;}
-    if (lhs.getSecond()     != rhs.getSecond()){return false;}
-    return lhs.getMicroSecond() == rhs.getMicroSecond();
+    ::advance(-duration.count(), mEpoch, mCalendar);
+    return *this;
 }
 
-/// lhs != rhs
-bool Time::operator!=(const UTC &lhs, const UTC &rhs)
+/// Add times
+UTC Time::operator+(const UTC &x, const double y)
 {
-    return !(lhs == rhs);
+    return x + ::toOffset(y);
 }
 
-/// lhs > rhs
-bool Time::operator>(const UTC &lhs, const UTC &rhs)
+/// Subtract times
+UTC Time::operator-(const UTC &x, const double y)
 {
-    return lhs.getEpoch() > rhs.getEpoch();
+    return x - ::toOffset(y);
 }
 
-/// lhs < rhs
-bool Time::operator<(const UTC &lhs, const UTC &rhs)
+/// Write the time to a buffer
+char *UTC::toChars(char *buffer) const noexcept
 {
-    return lhs.getEpoch() < rhs.getEpoch();
+    auto fields = ::getFields(mEpoch, mCalendar);
+    return ISO8601::format(buffer, fields.year, fields.month,
+                           fields.dayOfMonth, fields.hour, fields.minute,
+                           fields.second, getMicroSecond());
 }
 
 /// Std out
 std::ostream&
 Time::operator<<(std::ostream &os, const UTC &time)
 {
-    char result[27];
-    std::fill(result, result+27, '\0');
-    sprintf(result, "%04d-%02d-%02dT%02d:%02d:%02d.%06d",
-            time.getYear(), time.getMonth(), time.getDayOfMonth(),
-            time.getHour(), time.getMinute(), time.getSecond(),
-            time.getMicroSecond());
-    return os << result;
+    char result[UTC::ISO8601_LENGTH];
+    time.toChars(result);
+    return os << std::string_view(result, UTC::ISO8601_LENGTH);
 }
@@ -0,0 +1,499 @@
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include "time/batch.hpp"
+#include "time/calendar.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct Columns
+{
+    explicit Columns(const size_t n) :
+        year(n), dayOfYear(n), month(n), dayOfMonth(n),
+        hour(n), minute(n), second(n), nanoSecond(n)
+    {
+    }
+    Time::Batch::CalendarColumns view()
+    {
+        return Time::Batch::CalendarColumns{year, dayOfYear, month,
+                                            dayOfMonth, hour, minute,
+                                            second, nanoSecond};
+    }
+    std::vector<int32_t> year;
+    std::vector<int32_t> dayOfYear;
+    std::vector<int32_t> month;
+    std::vector<int32_t> dayOfMonth;
+    std::vector<int32_t> hour;
+    std::vector<int32_t> minute;
+    std::vector<int32_t> second;
+    std::vector<int32_t> nanoSecond;
+};
+
+void checkAgainstUTC(const std::vector<int64_t> &epochs)
+{
+    Columns columns(epochs.size());
+    Time::Batch::toCalendar(epochs, columns.view());
+    for (size_t i = 0; i < epochs.size(); ++i)
+    {
+        Time::UTC time{std::chrono::nanoseconds {epochs[i]}};
+        ASSERT_EQ(columns.year[i], time.getYear()) << epochs[i];
+        ASSERT_EQ(columns.dayOfYear[i], time.getDayOfYear()) << epochs[i];
+        ASSERT_EQ(columns.month[i], time.getMonth()) << epochs[i];
+        ASSERT_EQ(columns.dayOfMonth[i], time.getDayOfMonth()) << epochs[i];
+        ASSERT_EQ(columns.hour[i], time.getHour()) << epochs[i];
+        ASSERT_EQ(columns.minute[i], time.getMinute()) << epochs[i];
+        ASSERT_EQ(columns.second[i], time.getSecond()) << epochs[i];
+        ASSERT_EQ(columns.nanoSecond[i], time.getNanoSecond()) << epochs[i];
+    }
+}
+
+TEST(Batch, ToCalendarEveryDay)
+{
+    // Every day representable in int64 nanoseconds at a varying time of day
+    constexpr int64_t nanoSecondsPerDay{86400000000000};
+    constexpr int64_t firstDay{-106751};
+    constexpr int64_t lastDay{106750};
+    std::vector<int64_t> epochs;
+    epochs.reserve(lastDay - firstDay + 1);
+    for (int64_t day = firstDay; day <= lastDay; ++day)
+    {
+        auto offset = ((day*7919) % 86400)*1000000000 + (day & 1023);
+        if (offset < 0){offset = offset + nanoSecondsPerDay;}
+        epochs.push_back(day*nanoSecondsPerDay + offset);
+    }
+    checkAgainstUTC(epochs);
+}
+
+TEST(Batch, ToCalendarRandom)
+{
+    std::mt19937_64 generator(8675309);
+    std::uniform_int_distribution<int64_t> distribution(
+        std::numeric_limits<int64_t>::lowest(),
+        std::numeric_limits<int64_t>::max());
+    std::vector<int64_t> epochs(1003); // Exercise the scalar remainder
+    for (auto &epoch : epochs){epoch = distribution(generator);}
+    epochs.at(0) = std::numeric_limits<int64_t>::lowest();
+    epochs.at(1) = std::numeric_limits<int64_t>::max();
+    epochs.at(2) = 0;
+    epochs.at(3) = -1;
+    checkAgainstUTC(epochs);
+}
+
+TEST(Batch, ToCalendar)
+{
+    std::vector<int64_t> epochs{1336403638000100000, 1408117832844000000,
+                                951782400000000000}; // 2000-02-29
+    Columns columns(epochs.size());
+    Time::Batch::toCalendar(epochs, columns.view());
+    EXPECT_EQ(columns.year[0], 2012);
+    EXPECT_EQ(columns.dayOfYear[0], 128);
+    EXPECT_EQ(columns.month[0], 5);
+    EXPECT_EQ(columns.dayOfMonth[0], 7);
+    EXPECT_EQ(columns.hour[0], 15);
+    EXPECT_EQ(columns.minute[0], 13);
+    EXPECT_EQ(columns.second[0], 58);
+    EXPECT_EQ(columns.nanoSecond[0], 100000);
+    EXPECT_EQ(columns.year[1], 2014);
+    EXPECT_EQ(columns.dayOfYear[1], 227);
+    EXPECT_EQ(columns.nanoSecond[1], 844000000);
+    EXPECT_EQ(columns.year[2], 2000);
+    EXPECT_EQ(columns.month[2], 2);
+    EXPECT_EQ(columns.dayOfMonth[2], 29);
+    EXPECT_EQ(columns.dayOfYear[2], 60);
+    // Undersized columns
+    Columns small(epochs.size() - 1);
+    EXPECT_THROW(Time::Batch::toCalendar(epochs, small.view()),
+                 std::invalid_argument);
+}
+
+TEST(Batch, FromCalendarRoundTrip)
+{
+    std::mt19937_64 generator(5551212);
+    // Every time in [1678,2261]
+    std::uniform_int_distribution<int64_t> distribution(-9214560000000000000,
+                                                        9214646399999999999);
+    std::vector<int64_t> epochs(2051);
+    for (auto &epoch : epochs){epoch = distribution(generator);}
+    Columns columns(epochs.size());
+    Time::Batch::toCalendar(epochs, columns.view());
+    Time::Batch::ConstCalendarColumns calendar{columns.year,
+                                               columns.dayOfYear,
+                                               columns.month,
+                                               columns.dayOfMonth,
+                                               columns.hour,
+                                               columns.minute,
+                                               columns.second,
+                                               {},
+                                               columns.nanoSecond};
+    std::vector<int64_t> result(epochs.size(), 1);
+    std::vector<uint8_t> invalid(epochs.size(), 1);
+    EXPECT_EQ(Time::Batch::fromMonthAndDay(calendar, result, invalid), 0);
+    EXPECT_EQ(result, epochs);
+    EXPECT_EQ(std::count(invalid.begin(), invalid.end(), 0),
+              static_cast<int64_t> (epochs.size()));
+    std::fill(result.begin(), result.end(), 1);
+    EXPECT_EQ(Time::Batch::fromDayOfYear(calendar, result, invalid), 0);
+    EXPECT_EQ(result, epochs);
+}
+
+TEST(Batch, FromCalendarInvalid)
+{
+    //                               good  Feb29  month  hour  year   musec
+    std::vector<int32_t> year       {2012, 2013,  2012,  2012, 1677,  2012};
+    std::vector<int32_t> dayOfYear  {128,  366,   1,     1,    1,     1};
+    std::vector<int32_t> month      {5,    2,     13,    5,    5,     5};
+    std::vector<int32_t> dayOfMonth {7,    29,    7,     7,    7,     7};
+    std::vector<int32_t> hour       {15,   0,     0,     24,   0,     0};
+    std::vector<int32_t> minute     {13,   0,     0,     0,    0,     0};
+    std::vector<int32_t> second     {58,   0,     0,     0,    0,     0};
+    std::vector<int32_t> microSecond{100,  0,     0,     0,    0,     1000000};
+    Time::Batch::ConstCalendarColumns calendar{year, dayOfYear, month,
+                                               dayOfMonth, hour, minute,
+                                               second, microSecond, {}};
+    std::vector<int64_t> epochs(year.size(), 1);
+    std::vector<uint8_t> invalid(year.size(), 0);
+    EXPECT_EQ(Time::Batch::fromMonthAndDay(calendar, epochs, invalid), 5);
+    EXPECT_EQ(epochs[0], 1336403638000100000);
+    EXPECT_EQ(invalid, std::vector<uint8_t> ({0, 1, 1, 1, 1, 1}));
+    for (size_t i = 1; i < epochs.size(); ++i){EXPECT_EQ(epochs[i], 0);}
+    // Day 366 of a non-leap year is invalid but the month column is unused
+    EXPECT_EQ(Time::Batch::fromDayOfYear(calendar, epochs, invalid), 4);
+    EXPECT_EQ(epochs[0], 1336403638000100000);
+    EXPECT_EQ(invalid, std::vector<uint8_t> ({0, 1, 0, 1, 1, 1}));
+    EXPECT_EQ(epochs[2], 1325376000000000000);
+    // Can't specify both sub-second columns
+    calendar.nanoSecond = microSecond;
+    EXPECT_THROW(Time::Batch::fromMonthAndDay(calendar, epochs, invalid),
+                 std::invalid_argument);
+    // Undersized outputs
+    calendar.nanoSecond = {};
+    std::vector<uint8_t> smallInvalid(year.size() - 1);
+    EXPECT_THROW(Time::Batch::fromMonthAndDay(calendar, epochs, smallInvalid),
+                 std::invalid_argument);
+}
+
+TEST(Batch, FromStrings)
+{
+    std::vector<std::string_view> times{"2020-03-17T08:01:33.009000",
+                                        "2020-03-17 08:01:33.123456789Z",
+                                        "2020-03-17T08:01:33",
+                                        "2020-03-17T08:01:33.",
+                                        "garbage"};
+    std::vector<int64_t> epochs(times.size(), 1);
+    std::vector<uint8_t> invalid(times.size(), 0);
+    EXPECT_EQ(Time::Batch::fromStrings(times, epochs, invalid), 2);
+    EXPECT_EQ(epochs, std::vector<int64_t> ({1584432093009000000,
+                                             1584432093123456789,
+                                             1584432093000000000,
+                                             0, 0}));
+    EXPECT_EQ(invalid, std::vector<uint8_t> ({0, 0, 0, 1, 1}));
+}
+
+TEST(Batch, FromColumn)
+{
+    std::string_view column{"2020-03-17T08:01:33.009000\r\n"
+                            "\n"
+                            "2020-03-17T08:01:33Z\n"};
+    std::vector<int64_t> epochs(3, 1);
+    std::vector<uint8_t> invalid(3, 1);
+    EXPECT_EQ(Time::Batch::fromColumn(column, '\n', epochs, invalid), 3);
+    EXPECT_EQ(epochs, std::vector<int64_t> ({1584432093009000000, 0,
+                                             1584432093000000000}));
+    EXPECT_EQ(invalid, std::vector<uint8_t> ({0, 1, 0}));
+    std::vector<int64_t> smallEpochs(2);
+    EXPECT_THROW(Time::Batch::fromColumn(column, '\n', smallEpochs, invalid),
+                 std::invalid_argument);
+}
+
+TEST(Batch, ToColumn)
+{
+    std::vector<int64_t> epochs{1584432093009000000, 1584432093123456789,
+                                -1000};
+    std::string buffer(27*epochs.size(), '\0');
+    auto nWritten = Time::Batch::toColumn(epochs, '\n', buffer);
+    EXPECT_EQ(nWritten, buffer.size());
+    EXPECT_EQ(buffer, "2020-03-17T08:01:33.009000\n"
+                      "2020-03-17T08:01:33.123456\n"
+                      "1969-12-31T23:59:59.999999\n");
+    // Round trip
+    std::vector<int64_t> epochsBack(epochs.size());
+    std::vector<uint8_t> invalid(epochs.size());
+    EXPECT_EQ(Time::Batch::fromColumn(buffer, '\n', epochsBack, invalid),
+              epochs.size());
+    EXPECT_EQ(epochsBack[0], epochs[0]);
+    EXPECT_EQ(epochsBack[1], 1584432093123456000);
+    std::string smallBuffer(27*epochs.size() - 1, '\0');
+    EXPECT_THROW(Time::Batch::toColumn(epochs, '\n', smallBuffer),
+                 std::invalid_argument);
+}
+
+/// Random times from 1678 to 2261 and the edges of days and periods.
+std::vector<int64_t> createBinningTimes()
+{
+    std::mt19937_64 generator(4093);
+    std::uniform_int_distribution<int64_t>
+        distribution(-9100000000000000000, 9100000000000000000);
+    std::vector<int64_t> epochs{0, -1, 1, 86399999999999, 86400000000000,
+                                -86400000000000, 951782400000000000,
+                                951868799999999999, 1583020800000000000};
+    for (int i = 0; i < 100000; ++i)
+    {
+        epochs.push_back(distribution(generator));
+    }
+    return epochs;
+}
+
+TEST(Batch, RoundToPeriod)
+{
+    auto epochs = createBinningTimes();
+    std::vector<int64_t> result(epochs.size());
+    for (int64_t p : {int64_t {1}, int64_t {10}, int64_t {1000},
+                      int64_t {10000000}, int64_t {1000000000},
+                      int64_t {60000000000}, int64_t {3600000000000},
+                      int64_t {86400000000000}, int64_t {604800000000000}})
+    {
+        std::chrono::nanoseconds period{p};
+        Time::Batch::floor(epochs, period, result);
+        for (size_t i = 0; i < epochs.size(); ++i)
+        {
+            auto lower = Time::Calendar::floorDivide(epochs[i], p)*p;
+            ASSERT_EQ(result[i], lower) << epochs[i] << " " << p;
+        }
+        Time::Batch::ceil(epochs, period, result);
+        for (size_t i = 0; i < epochs.size(); ++i)
+        {
+            auto lower = Time::Calendar::floorDivide(epochs[i], p)*p;
+            auto upper = lower == epochs[i] ? lower : lower + p;
+            ASSERT_EQ(result[i], upper) << epochs[i] << " " << p;
+        }
+        Time::Batch::round(epochs, period, result);
+        for (size_t i = 0; i < epochs.size(); ++i)
+        {
+            auto lower = Time::Calendar::floorDivide(epochs[i], p)*p;
+            auto nearest = 2*(epochs[i] - lower) >= p ? lower + p : lower;
+            ASSERT_EQ(result[i], nearest) << epochs[i] << " " << p;
+        }
+    }
+    // In place
+    std::vector<int64_t> inPlace{-1, 0, 59999999999, 60000000000, 89999999999,
+                                 90000000000};
+    Time::Batch::round(inPlace, std::chrono::minutes {1}, inPlace);
+    EXPECT_EQ(inPlace, std::vector<int64_t> ({0, 0, 60000000000, 60000000000,
+                                              60000000000, 120000000000}));
+    // Every int64 is valid and unrepresentable multiples saturate.  These
+    // are in the same block as ordinary times.
+    constexpr auto minimum = std::numeric_limits<int64_t>::lowest();
+    constexpr auto maximum = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> extremes{minimum, minimum + 1, -1, 0, 1,
+                                  maximum - 1, maximum};
+    std::vector<int64_t> extremeResult(extremes.size());
+    for (int64_t p : {int64_t {1000}, int64_t {1000000000},
+                      int64_t {60000000000}, maximum/3, maximum})
+    {
+        std::chrono::nanoseconds period{p};
+        auto reference = [&](const int64_t x, const int rounding)
+        {
+            auto lower = static_cast<__int128> (
+                Time::Calendar::floorDivide(x, p))*p;
+            auto r = static_cast<__int128> (x) - lower;
+            auto y = lower;
+            if ((rounding == 1 && r > 0) || (rounding == 2 && 2*r >= p))
+            {
+                y = lower + p;
+            }
+            y = std::max<__int128> (y, minimum);
+            return static_cast<int64_t> (std::min<__int128> (y, maximum));
+        };
+        Time::Batch::floor(extremes, period, extremeResult);
+        for (size_t i = 0; i < extremes.size(); ++i)
+        {
+            EXPECT_EQ(extremeResult[i], reference(extremes[i], 0)) << p;
+        }
+        Time::Batch::ceil(extremes, period, extremeResult);
+        for (size_t i = 0; i < extremes.size(); ++i)
+        {
+            EXPECT_EQ(extremeResult[i], reference(extremes[i], 1)) << p;
+        }
+        Time::Batch::round(extremes, period, extremeResult);
+        for (size_t i = 0; i < extremes.size(); ++i)
+        {
+            EXPECT_EQ(extremeResult[i], reference(extremes[i], 2)) << p;
+        }
+    }
+    std::vector<int64_t> maximumTime{maximum};
+    Time::Batch::floor(maximumTime, std::chrono::seconds {1}, maximumTime);
+    EXPECT_EQ(maximumTime[0], 9223372036000000000);
+    EXPECT_THROW(Time::Batch::floor(epochs, std::chrono::nanoseconds {0},
+                                    result),
+                 std::invalid_argument);
+    std::vector<int64_t> small(epochs.size() - 1);
+    EXPECT_THROW(Time::Batch::ceil(epochs, std::chrono::seconds {1}, small),
+                 std::invalid_argument);
+}
+
+TEST(Batch, RoundToCalendarPeriod)
+{
+    using Time::Batch::CalendarPeriod;
+    auto epochs = createBinningTimes();
+    std::vector<int64_t> floors(epochs.size());
+    std::vector<int64_t> ceils(epochs.size());
+    std::vector<int64_t> rounds(epochs.size());
+    for (auto period : {CalendarPeriod::Day, CalendarPeriod::Month,
+                        CalendarPeriod::Year})
+    {
+        Time::Batch::floor(epochs, period, floors);
+        Time::Batch::ceil(epochs, period, ceils);
+        Time::Batch::round(epochs, period, rounds);
+        for (size_t i = 0; i < epochs.size(); ++i)
+        {
+            Time::UTC time{std::chrono::nanoseconds {epochs[i]}};
+            auto year = time.getYear();
+            auto month = period == CalendarPeriod::Year ? 1 : time.getMonth();
+            auto day = period == CalendarPeriod::Day ?
+                       time.getDayOfMonth() : 1;
+            auto start = Time::UTC::fromComponents(year, month, day);
+            ASSERT_TRUE(start);
+            auto lower = start->getEpochInNanoSeconds().count();
+            int64_t upper{0};
+            if (period == CalendarPeriod::Day)
+            {
+                upper = lower + Time::Calendar::NANOSECONDS_PER_DAY;
+            }
+            else if (period == CalendarPeriod::Month && month < 12)
+            {
+                upper = Time::Calendar::toEpoch(year, month + 1, 1, 0, 0, 0, 0);
+            }
+            else
+            {
+                upper = Time::Calendar::toEpoch(year + 1, 1, 1, 0, 0, 0, 0);
+            }
+            ASSERT_EQ(floors[i], lower) << epochs[i];
+            ASSERT_EQ(ceils[i], epochs[i] == lower ? lower : upper)
+                << epochs[i];
+            ASSERT_EQ(rounds[i],
+                      epochs[i] - lower >= upper - epochs[i] ? upper : lower)
+                << epochs[i];
+        }
+    }
+    // In place; Feb 15 2020 12:00 is half way through February
+    std::vector<int64_t> inPlace{1581768000000000000, 1581767999999999999};
+    Time::Batch::round(inPlace, CalendarPeriod::Month, inPlace);
+    EXPECT_EQ(inPlace, std::vector<int64_t> ({1583020800000000000,
+                                              1580515200000000000}));
+    // The periods containing the extreme times are saturated
+    constexpr auto minimum = std::numeric_limits<int64_t>::lowest();
+    constexpr auto maximum = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> extremes{minimum, maximum};
+    std::vector<int64_t> extremeResult(extremes.size());
+    Time::Batch::floor(extremes, CalendarPeriod::Year, extremeResult);
+    EXPECT_EQ(extremeResult, std::vector<int64_t> ({minimum,
+        Time::Calendar::toEpoch(2262, 1, 1, 0, 0, 0, 0)}));
+    Time::Batch::ceil(extremes, CalendarPeriod::Year, extremeResult);
+    EXPECT_EQ(extremeResult, std::vector<int64_t> ({
+        Time::Calendar::toEpoch(1678, 1, 1, 0, 0, 0, 0), maximum}));
+    Time::Batch::floor(extremes, CalendarPeriod::Month, extremeResult);
+    EXPECT_EQ(extremeResult, std::vector<int64_t> ({minimum,
+        Time::Calendar::toEpoch(2262, 4, 1, 0, 0, 0, 0)}));
+    Time::Batch::ceil(extremes, CalendarPeriod::Month, extremeResult);
+    EXPECT_EQ(extremeResult, std::vector<int64_t> ({
+        Time::Calendar::toEpoch(1677, 10, 1, 0, 0, 0, 0), maximum}));
+    Time::Batch::round(extremes, CalendarPeriod::Day, extremeResult);
+    EXPECT_EQ(extremeResult, std::vector<int64_t> ({minimum, maximum}));
+    std::vector<int64_t> small(epochs.size() - 1);
+    EXPECT_THROW(Time::Batch::floor(epochs, CalendarPeriod::Year, small),
+                 std::invalid_argument);
+}
+
+TEST(Batch, GroupBy)
+{
+    using Time::Batch::CalendarPeriod;
+    auto check = [](const std::vector<int64_t> &epochs,
+                    const std::vector<int64_t> &bins,
+                    const std::vector<Time::Batch::Group> &groups)
+    {
+        // Every time is in exactly one group and the groups are the runs of
+        // equal bins
+        size_t begin{0};
+        for (const auto &group : groups)
+        {
+            ASSERT_EQ(group.begin, begin);
+            ASSERT_LT(group.begin, group.end);
+            for (size_t i = group.begin; i < group.end; ++i)
+            {
+                ASSERT_EQ(bins[i], group.start);
+            }
+            if (group.end < epochs.size())
+            {
+                ASSERT_NE(bins[group.end], group.start);
+            }
+            begin = group.end;
+        }
+        ASSERT_EQ(begin, epochs.size());
+    };
+    auto epochs = createBinningTimes();
+    std::sort(epochs.begin(), epochs.end());
+    // Dense runs too
+    std::vector<int64_t> samples(100000);
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        samples[i] = 1577836795000000000 + static_cast<int64_t> (i)*10000000;
+    }
+    std::vector<int64_t> bins(std::max(epochs.size(), samples.size()));
+    for (const auto *times : {&epochs, &samples})
+    {
+        bins.resize(times->size());
+        for (auto period : {std::chrono::nanoseconds {std::chrono::seconds {1}},
+                            std::chrono::nanoseconds {std::chrono::hours {1}}})
+        {
+            Time::Batch::floor(*times, period, bins);
+            check(*times, bins, Time::Batch::groupBy(*times, period));
+        }
+        for (auto period : {CalendarPeriod::Day, CalendarPeriod::Month,
+                            CalendarPeriod::Year})
+        {
+            Time::Batch::floor(*times, period, bins);
+            check(*times, bins, Time::Batch::groupBy(*times, period));
+        }
+    }
+    auto minutes = Time::Batch::groupBy(samples, std::chrono::minutes {1});
+    ASSERT_EQ(minutes.size(), 18);
+    EXPECT_EQ(minutes[0].start, 1577836740000000000);
+    EXPECT_EQ(minutes[0].end, 500);
+    EXPECT_EQ(minutes[1].start, 1577836800000000000);
+    EXPECT_EQ(minutes[1].end, 6500);
+    // The bins containing the extreme times
+    constexpr auto minimum = std::numeric_limits<int64_t>::lowest();
+    constexpr auto maximum = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> extremes{minimum, minimum + 1, maximum - 1, maximum};
+    for (auto period : {CalendarPeriod::Day, CalendarPeriod::Month,
+                        CalendarPeriod::Year})
+    {
+        auto groups = Time::Batch::groupBy(extremes, period);
+        ASSERT_EQ(groups.size(), 2);
+        EXPECT_EQ(groups[0].start, minimum);
+        EXPECT_EQ(groups[0].end, 2);
+        EXPECT_EQ(groups[1].begin, 2);
+        EXPECT_EQ(groups[1].end, 4);
+    }
+    EXPECT_EQ(Time::Batch::groupBy(extremes, CalendarPeriod::Year)[1].start,
+              Time::Calendar::toEpoch(2262, 1, 1, 0, 0, 0, 0));
+    auto seconds = Time::Batch::groupBy(extremes, std::chrono::seconds {1});
+    ASSERT_EQ(seconds.size(), 2);
+    EXPECT_EQ(seconds[0].start, minimum);
+    EXPECT_EQ(seconds[1].start, 9223372036000000000);
+    EXPECT_EQ(seconds[1].end, 4);
+    EXPECT_TRUE(Time::Batch::groupBy(std::vector<int64_t> {},
+                                     CalendarPeriod::Month).empty());
+    EXPECT_THROW(auto groups = Time::Batch::groupBy(
+                     samples, std::chrono::nanoseconds {-1}),
+                 std::invalid_argument);
+}
+
+}
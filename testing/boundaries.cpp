@@ -0,0 +1,199 @@
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <vector>
+#include "time/boundaries.hpp"
+#include "time/calendar.hpp"
+#include "time/sampleAxis.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using Time::BoundaryPeriod;
+
+static_assert(std::forward_iterator<Time::BoundaryRange::Iterator>);
+static_assert(std::ranges::forward_range<Time::BoundaryRange>);
+static_assert(std::ranges::view<Time::BoundaryRange>);
+
+constexpr int64_t NANOSECONDS_PER_HOUR{3600000000000};
+
+/// Checks the calendar fields against a fresh decomposition of the start.
+void checkFields(const Time::Boundary &boundary, const BoundaryPeriod period)
+{
+    Time::UTC time{std::chrono::nanoseconds {boundary.start}};
+    ASSERT_EQ(boundary.year, time.getYear()) << boundary.start;
+    ASSERT_EQ(boundary.month, time.getMonth()) << boundary.start;
+    ASSERT_EQ(boundary.dayOfMonth, time.getDayOfMonth()) << boundary.start;
+    ASSERT_EQ(boundary.dayOfYear, time.getDayOfYear()) << boundary.start;
+    ASSERT_EQ(boundary.hour, time.getHour()) << boundary.start;
+    ASSERT_EQ(time.getMinute(), 0);
+    ASSERT_EQ(time.getSecond(), 0);
+    ASSERT_EQ(time.getNanoSecond(), 0);
+    if (period == BoundaryPeriod::Hour)
+    {
+        ASSERT_EQ(boundary.end - boundary.start, NANOSECONDS_PER_HOUR);
+    }
+    else if (period == BoundaryPeriod::Day)
+    {
+        ASSERT_EQ(boundary.hour, 0);
+        ASSERT_EQ(boundary.end - boundary.start,
+                  Time::Calendar::NANOSECONDS_PER_DAY);
+    }
+    else
+    {
+        ASSERT_EQ(boundary.hour, 0);
+        ASSERT_EQ(boundary.dayOfMonth, 1);
+        ASSERT_EQ(boundary.end - boundary.start,
+                  Time::Calendar::daysInMonth(boundary.year, boundary.month)
+                 *Time::Calendar::NANOSECONDS_PER_DAY);
+    }
+}
+
+TEST(Boundaries, GetBoundary)
+{
+    // 2024-02-29T13:45:10.5
+    auto time = Time::Calendar::toEpoch(2024, 2, 29, 13, 45, 10, 500000000);
+    auto hour = Time::getBoundary(time, BoundaryPeriod::Hour);
+    EXPECT_EQ(hour.start, Time::Calendar::toEpoch(2024, 2, 29, 13, 0, 0, 0));
+    EXPECT_EQ(hour.end, Time::Calendar::toEpoch(2024, 2, 29, 14, 0, 0, 0));
+    EXPECT_EQ(hour.year, 2024);
+    EXPECT_EQ(hour.month, 2);
+    EXPECT_EQ(hour.dayOfMonth, 29);
+    EXPECT_EQ(hour.dayOfYear, 60);
+    EXPECT_EQ(hour.hour, 13);
+    auto day = Time::getBoundary(time, BoundaryPeriod::Day);
+    EXPECT_EQ(day.start, Time::Calendar::toEpoch(2024, 2, 29, 0, 0, 0, 0));
+    EXPECT_EQ(day.end, Time::Calendar::toEpoch(2024, 3, 1, 0, 0, 0, 0));
+    EXPECT_EQ(day.dayOfYear, 60);
+    EXPECT_EQ(day.hour, 0);
+    auto month = Time::getBoundary(time, BoundaryPeriod::Month);
+    EXPECT_EQ(month.start, Time::Calendar::toEpoch(2024, 2, 1, 0, 0, 0, 0));
+    EXPECT_EQ(month.end, Time::Calendar::toEpoch(2024, 3, 1, 0, 0, 0, 0));
+    EXPECT_EQ(month.dayOfMonth, 1);
+    EXPECT_EQ(month.dayOfYear, 32);
+    // Before the epoch
+    auto beforeEpoch = Time::getBoundary(-1, BoundaryPeriod::Hour);
+    EXPECT_EQ(beforeEpoch.start, -NANOSECONDS_PER_HOUR);
+    EXPECT_EQ(beforeEpoch.year, 1969);
+    EXPECT_EQ(beforeEpoch.dayOfYear, 365);
+    EXPECT_EQ(beforeEpoch.hour, 23);
+    // The first and last supported days
+    auto first = Time::getBoundary(Time::Calendar::toEpoch(1678, 1, 1,
+                                                           0, 0, 0, 0),
+                                   BoundaryPeriod::Day);
+    EXPECT_EQ(first.year, 1678);
+    EXPECT_EQ(first.dayOfYear, 1);
+    auto last = Time::getBoundary(Time::Calendar::toEpoch(2261, 12, 31,
+                                                          23, 59, 59, 0),
+                                  BoundaryPeriod::Day);
+    EXPECT_EQ(last.start, Time::Calendar::toEpoch(2261, 12, 31, 0, 0, 0, 0));
+    EXPECT_EQ(last.dayOfYear, 365);
+    EXPECT_THROW(static_cast<void> (Time::getBoundary(
+                     Time::Calendar::toEpoch(1677, 12, 31, 0, 0, 0, 0),
+                     BoundaryPeriod::Day)),
+                 std::invalid_argument);
+    EXPECT_THROW(static_cast<void> (Time::getBoundary(
+                     Time::Calendar::toEpoch(2262, 1, 1, 0, 0, 0, 0),
+                     BoundaryPeriod::Day)),
+                 std::invalid_argument);
+}
+
+TEST(Boundaries, Range)
+{
+    // Every hour, day, and month across several leap and non-leap years
+    auto t0 = Time::Calendar::toEpoch(1999, 12, 30, 22, 30, 0, 0);
+    auto t1 = Time::Calendar::toEpoch(2005, 3, 1, 0, 0, 0, 1);
+    for (auto period : {BoundaryPeriod::Hour, BoundaryPeriod::Day,
+                        BoundaryPeriod::Month})
+    {
+        Time::BoundaryRange range(t0, t1, period);
+        auto previous = range.front();
+        EXPECT_LE(previous.start, t0);
+        EXPECT_GT(previous.end, t0);
+        size_t count{0};
+        for (const auto &boundary : range)
+        {
+            checkFields(boundary, period);
+            if (count > 0){ASSERT_EQ(boundary.start, previous.end);}
+            ASSERT_LT(boundary.start, t1);
+            previous = boundary;
+            count = count + 1;
+        }
+        EXPECT_GE(previous.end, t1);
+        auto expected = period == BoundaryPeriod::Hour ?
+                        static_cast<size_t> (
+                            (Time::Calendar::toEpoch(2005, 3, 1, 1, 0, 0, 0)
+                           - Time::Calendar::toEpoch(1999, 12, 30, 22, 0, 0, 0))
+                            /NANOSECONDS_PER_HOUR) :
+                        period == BoundaryPeriod::Day ?
+                        static_cast<size_t> (
+                            Time::Calendar::daysFromCivil(2005, 3, 2)
+                          - Time::Calendar::daysFromCivil(1999, 12, 30)) :
+                        size_t {64};
+        EXPECT_EQ(count, expected);
+        EXPECT_EQ(static_cast<size_t> (std::ranges::distance(range)),
+                  expected);
+    }
+    // Random days
+    std::mt19937_64 generator(2718);
+    std::uniform_int_distribution<int64_t>
+        distribution(Time::Calendar::toEpoch(1678, 1, 1, 0, 0, 0, 0),
+                     Time::Calendar::toEpoch(2261, 1, 1, 0, 0, 0, 0));
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto start = distribution(generator);
+        auto end = start + 40*Time::Calendar::NANOSECONDS_PER_DAY;
+        for (auto period : {BoundaryPeriod::Day, BoundaryPeriod::Month})
+        {
+            for (const auto &boundary : Time::BoundaryRange(start, end, period))
+            {
+                checkFields(boundary, period);
+            }
+        }
+    }
+    // The last day
+    auto last = Time::Calendar::toEpoch(2262, 1, 1, 0, 0, 0, 0);
+    Time::BoundaryRange lastDay(last - 1, last, BoundaryPeriod::Day);
+    EXPECT_EQ(std::ranges::distance(lastDay), 1);
+    EXPECT_EQ(lastDay.front().year, 2261);
+    EXPECT_EQ(lastDay.front().dayOfYear, 365);
+    // Empty ranges
+    EXPECT_TRUE(Time::BoundaryRange().empty());
+    EXPECT_TRUE(Time::BoundaryRange(t0, t0, BoundaryPeriod::Day).empty());
+    EXPECT_TRUE(Time::BoundaryRange(t1, t0, BoundaryPeriod::Day).empty());
+    EXPECT_THROW(Time::BoundaryRange(t0, last + 1, BoundaryPeriod::Day),
+                 std::invalid_argument);
+}
+
+TEST(Boundaries, FindBoundarySample)
+{
+    // 100 Hz packet starting 0.255 s before midnight
+    auto midnight = Time::Calendar::toEpoch(2023, 6, 1, 0, 0, 0, 0);
+    Time::SamplingPeriod period{10000000};
+    auto start = midnight - 255000000;
+    EXPECT_EQ(Time::findBoundarySample(start, period, 100,
+                                       BoundaryPeriod::Day), 26);
+    EXPECT_EQ(Time::findBoundarySample(start, period, 20,
+                                       BoundaryPeriod::Day), 20);
+    EXPECT_EQ(Time::findBoundarySample(start, period, 100,
+                                       BoundaryPeriod::Hour), 26);
+    // A sample on the boundary starts the next day
+    EXPECT_EQ(Time::findBoundarySample(midnight - 250000000, period, 100,
+                                       BoundaryPeriod::Day), 25);
+    // Rational period of 3 Hz
+    auto rate3 = Time::SamplingPeriod::fromSamplingRate(3);
+    auto index = Time::findBoundarySample(midnight - 1000000000, rate3, 10,
+                                          BoundaryPeriod::Day);
+    EXPECT_EQ(index, 3);
+    EXPECT_GE(midnight - 1000000000 + rate3.getOffset(index), midnight);
+    EXPECT_LT(midnight - 1000000000 + rate3.getOffset(index - 1), midnight);
+    EXPECT_THROW(static_cast<void> (Time::findBoundarySample(
+                     start, period, -1, BoundaryPeriod::Day)),
+                 std::invalid_argument);
+}
+
+}
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "time/clock.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+int64_t getSystemTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+           (std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/// Checks the clock brackets the system clock to within the tolerance.
+void checkSource(const int64_t tolerance)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        auto before = getSystemTime();
+        auto now = Time::UTC::nowEpoch().count();
+        auto after = getSystemTime();
+        EXPECT_GE(now, before - tolerance);
+        EXPECT_LE(now, after + tolerance);
+    }
+    auto before = getSystemTime();
+    Time::UTC time;
+    time.now();
+    auto after = getSystemTime();
+    EXPECT_GE(time.getEpochInNanoSeconds().count(), before - tolerance);
+    EXPECT_LE(time.getEpochInNanoSeconds().count(), after + tolerance);
+}
+
+TEST(Clock, Realtime)
+{
+    EXPECT_EQ(Time::Clock::getSource(), Time::Clock::Source::Realtime);
+    checkSource(0);
+}
+
+TEST(Clock, CoarseRealtime)
+{
+    Time::Clock::setSource(Time::Clock::Source::CoarseRealtime);
+    EXPECT_EQ(Time::Clock::getSource(), Time::Clock::Source::CoarseRealtime);
+    // The resolution is the scheduler tick
+    checkSource(20000000);
+    Time::Clock::setSource(Time::Clock::Source::Realtime);
+}
+
+TEST(Clock, TSC)
+{
+    EXPECT_THROW(Time::Clock::setResynchronizationInterval(
+                     std::chrono::nanoseconds {0}),
+                 std::invalid_argument);
+    if (!Time::Clock::isTSCAvailable())
+    {
+        EXPECT_THROW(Time::Clock::setSource(Time::Clock::Source::TSC),
+                     std::invalid_argument);
+        GTEST_SKIP() << "An invariant TSC is not available";
+    }
+    Time::Clock::setSource(Time::Clock::Source::TSC);
+    EXPECT_EQ(Time::Clock::getSource(), Time::Clock::Source::TSC);
+    checkSource(1000000);
+    // Force frequent resynchronizations from several threads
+    Time::Clock::setResynchronizationInterval(std::chrono::microseconds {50});
+    EXPECT_EQ(Time::Clock::getResynchronizationInterval(),
+              std::chrono::microseconds {50});
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([]()
+        {
+            for (int j = 0; j < 20000; ++j)
+            {
+                auto before = getSystemTime();
+                auto now = Time::UTC::nowEpoch().count();
+                auto after = getSystemTime();
+                EXPECT_GE(now, before - 1000000);
+                EXPECT_LE(now, after + 1000000);
+            }
+        });
+    }
+    for (auto &thread : threads){thread.join();}
+    Time::Clock::setResynchronizationInterval(std::chrono::seconds {1});
+    Time::Clock::setSource(Time::Clock::Source::Realtime);
+}
+
+}
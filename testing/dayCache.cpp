@@ -0,0 +1,92 @@
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include "time/dayCache.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+TEST(DayCache, DisabledByDefault)
+{
+    EXPECT_FALSE(Time::DayCache::isEnabled());
+    Time::DayCache::resetCounters();
+    Time::UTC time{1336403638.0001};
+    EXPECT_EQ(time.getYear(), 2012);
+    EXPECT_EQ(Time::DayCache::getHits(), 0);
+    EXPECT_EQ(Time::DayCache::getMisses(), 0);
+}
+
+TEST(DayCache, ConsecutiveConversions)
+{
+    Time::DayCache::enable();
+    EXPECT_TRUE(Time::DayCache::isEnabled());
+    Time::DayCache::resetCounters();
+    // A day of ten-second samples starting at 2012-05-06 12:00:00
+    const int64_t t0{1336305600};
+    const int nSamples{8640};
+    for (int i = 0; i < nSamples; ++i)
+    {
+        Time::UTC time{std::chrono::nanoseconds {(t0 + 10*i)*1000000000LL}};
+        int secondOfDay = (12*3600 + 10*i) % 86400;
+        auto dayOfMonth = (12*3600 + 10*i) < 86400 ? 6 : 7;
+        EXPECT_EQ(time.getYear(), 2012);
+        EXPECT_EQ(time.getMonthAndDay().first, 5);
+        EXPECT_EQ(time.getMonthAndDay().second, dayOfMonth);
+        EXPECT_EQ(time.getDayOfYear(), 121 + dayOfMonth);
+        EXPECT_EQ(time.getHour(), secondOfDay/3600);
+        EXPECT_EQ(time.getMinute(), (secondOfDay % 3600)/60);
+        EXPECT_EQ(time.getSecond(), secondOfDay % 60);
+    }
+    // Only the first sample of each day misses
+    EXPECT_EQ(Time::DayCache::getMisses(), 2);
+    EXPECT_EQ(Time::DayCache::getHits(), nSamples - 2);
+    // Setters that stay on the same day are served by the cache
+    Time::DayCache::resetCounters();
+    Time::UTC time{std::chrono::nanoseconds {t0*1000000000LL}};
+    time.setHour(23);
+    EXPECT_EQ(time.getHour(), 23);
+    EXPECT_EQ(time.getMonthAndDay().second, 6);
+    EXPECT_EQ(Time::DayCache::getMisses(), 1);
+    EXPECT_EQ(Time::DayCache::getHits(), 1);
+    // Across a year boundary the day of year must be correct
+    Time::UTC newYear{std::chrono::nanoseconds {1356998399LL*1000000000}};
+    EXPECT_EQ(newYear.getYear(), 2012);
+    EXPECT_EQ(newYear.getDayOfYear(), 366);
+    newYear = Time::UTC {std::chrono::nanoseconds {1356998400LL*1000000000}};
+    EXPECT_EQ(newYear.getYear(), 2013);
+    EXPECT_EQ(newYear.getDayOfYear(), 1);
+    Time::DayCache::resetCounters();
+    EXPECT_EQ(Time::DayCache::getHits(), 0);
+    EXPECT_EQ(Time::DayCache::getMisses(), 0);
+    Time::DayCache::disable();
+    EXPECT_FALSE(Time::DayCache::isEnabled());
+}
+
+TEST(DayCache, PerThread)
+{
+    Time::DayCache::enable();
+    Time::DayCache::resetCounters();
+    Time::UTC time{1336403638.0};
+    EXPECT_EQ(time.getYear(), 2012);
+    uint64_t otherHits{1};
+    uint64_t otherMisses{1};
+    bool otherEnabled{true};
+    std::thread thread([&]()
+    {
+        otherEnabled = Time::DayCache::isEnabled();
+        Time::UTC other{1336403639.0};
+        static_cast<void> (other.getYear());
+        otherHits = Time::DayCache::getHits();
+        otherMisses = Time::DayCache::getMisses();
+    });
+    thread.join();
+    EXPECT_FALSE(otherEnabled);
+    EXPECT_EQ(otherHits, 0);
+    EXPECT_EQ(otherMisses, 0);
+    EXPECT_EQ(Time::DayCache::getMisses(), 1);
+    Time::DayCache::disable();
+}
+
+}
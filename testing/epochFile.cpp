@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+#include "time/epochFile.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::filesystem::path getFileName(const std::string &name)
+{
+    return std::filesystem::temp_directory_path()
+         / ("timeEpochFile_" + name + ".bin");
+}
+
+TEST(EpochFile, SortedRoundTrip)
+{
+    auto fileName = getFileName("sorted");
+    // 100 Hz packet times with a gap
+    std::vector<int64_t> epochs;
+    for (int64_t i = 0; i < 10000; ++i)
+    {
+        auto gap = i >= 5000 ? int64_t {3600000000000} : 0;
+        epochs.push_back(1577836800000000000 + i*10000000 + gap);
+    }
+    {
+    Time::EpochFileWriter writer(fileName, 128);
+    writer.append(std::span<const int64_t> {epochs}.first(1000));
+    for (size_t i = 1000; i < 1003; ++i){writer.append(epochs[i]);}
+    writer.append(std::span<const int64_t> {epochs}.subspan(1003));
+    EXPECT_EQ(writer.size(), epochs.size());
+    }
+    Time::EpochFileReader reader(fileName);
+    ASSERT_TRUE(reader.isOpen());
+    EXPECT_TRUE(reader.isSorted());
+    EXPECT_EQ(reader.size(), epochs.size());
+    EXPECT_EQ(reader.getBlockSize(), 128);
+    EXPECT_TRUE(std::ranges::equal(reader.getEpochs(), epochs));
+    auto blocks = reader.getBlocks();
+    ASSERT_EQ(blocks.size(), (epochs.size() + 127)/128);
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        auto block = reader.getBlock(i);
+        EXPECT_EQ(blocks[i].minimum, *std::ranges::min_element(block));
+        EXPECT_EQ(blocks[i].maximum, *std::ranges::max_element(block));
+    }
+    EXPECT_EQ(reader.getBlock(blocks.size() - 1).size(), epochs.size() % 128);
+    EXPECT_THROW(auto block = reader.getBlock(blocks.size()),
+                 std::out_of_range);
+    EXPECT_EQ(reader.at(5), Time::UTC{std::chrono::nanoseconds {epochs[5]}});
+    EXPECT_THROW(auto time = reader.at(epochs.size()), std::out_of_range);
+
+    std::mt19937 generator(4093);
+    std::uniform_int_distribution<int64_t>
+        times(epochs.front() - 1000000000, epochs.back() + 1000000000);
+    for (int k = 0; k < 1000; ++k)
+    {
+        auto t0 = times(generator);
+        auto t1 = times(generator);
+        if (k == 0){t0 = epochs[200]; t1 = epochs[300];}
+        auto first = std::ranges::lower_bound(epochs, t0);
+        auto last = std::ranges::lower_bound(epochs, t1);
+        auto result = reader.find(t0, t1);
+        if (t1 <= t0)
+        {
+            EXPECT_TRUE(result.empty());
+            continue;
+        }
+        ASSERT_EQ(result.size(), static_cast<size_t> (last - first));
+        if (!result.empty()){EXPECT_EQ(result.front(), *first);}
+        size_t nVisited{0};
+        reader.forEachBlock(t0, t1,
+                            [&](const size_t, std::span<const int64_t> block)
+                            {
+                                nVisited = nVisited
+                                  + static_cast<size_t> (std::ranges::count_if(
+                                      block, [&](const int64_t t)
+                                      {
+                                          return t >= t0 && t < t1;
+                                      }));
+                            });
+        EXPECT_EQ(nVisited, result.size());
+    }
+    // Moving transfers the mapping
+    Time::EpochFileReader moved(std::move(reader));
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_EQ(moved.size(), epochs.size());
+    moved.close();
+    EXPECT_FALSE(moved.isOpen());
+    EXPECT_TRUE(moved.getEpochs().empty());
+    std::filesystem::remove(fileName);
+}
+
+TEST(EpochFile, UnsortedBlocks)
+{
+    auto fileName = getFileName("unsorted");
+    std::mt19937 generator(86);
+    std::uniform_int_distribution<int64_t> times(0, 1000000000000);
+    std::vector<int64_t> epochs(5000);
+    for (auto &epoch : epochs){epoch = times(generator);}
+    {
+    Time::EpochFileWriter writer(fileName, 256);
+    writer.append(epochs);
+    writer.close();
+    writer.close();
+    EXPECT_THROW(writer.append(1), std::invalid_argument);
+    }
+    Time::EpochFileReader reader(fileName);
+    EXPECT_FALSE(reader.isSorted());
+    EXPECT_THROW(auto result = reader.find(0, 1), std::invalid_argument);
+    int64_t t0{250000000000};
+    int64_t t1{250500000000};
+    auto expected = std::ranges::count_if(epochs, [&](const int64_t t)
+                                          {
+                                              return t >= t0 && t < t1;
+                                          });
+    int64_t found{0};
+    reader.forEachBlock(t0, t1,
+                        [&](const size_t block, std::span<const int64_t> values)
+                        {
+                            EXPECT_LE(reader.getBlocks()[block].minimum, t1);
+                            found = found + std::ranges::count_if(
+                                values, [&](const int64_t t)
+                                {
+                                    return t >= t0 && t < t1;
+                                });
+                        });
+    EXPECT_EQ(found, expected);
+    std::filesystem::remove(fileName);
+}
+
+TEST(EpochFile, Invalid)
+{
+    auto fileName = getFileName("invalid");
+    EXPECT_THROW(Time::EpochFileWriter(fileName, 0), std::invalid_argument);
+    {
+    Time::EpochFileWriter writer(fileName);
+    }
+    // An empty file is valid
+    {
+    Time::EpochFileReader reader(fileName);
+    EXPECT_TRUE(reader.empty());
+    EXPECT_TRUE(reader.getBlocks().empty());
+    EXPECT_TRUE(reader.find(0, 10).empty());
+    }
+    // Truncated
+    std::filesystem::resize_file(fileName, 32);
+    EXPECT_THROW(Time::EpochFileReader reader(fileName), std::invalid_argument);
+    // Wrong magic
+    {
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    std::string junk(128, 'x');
+    file.write(junk.data(), static_cast<std::streamsize> (junk.size()));
+    }
+    EXPECT_THROW(Time::EpochFileReader reader(fileName), std::invalid_argument);
+    std::filesystem::remove(fileName);
+    EXPECT_THROW(Time::EpochFileReader reader(fileName), std::invalid_argument);
+}
+
+}
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "time/intervalIndex.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using Interval = Time::IntervalIndex::Interval;
+
+/// The containing intervals by brute force in order of increasing start.
+std::vector<uint32_t> referenceStab(const std::vector<Interval> &intervals,
+                                    const int64_t time)
+{
+    std::vector<uint32_t> result;
+    for (uint32_t i = 0; i < intervals.size(); ++i)
+    {
+        if (intervals[i].start <= time && time < intervals[i].end)
+        {
+            result.push_back(i);
+        }
+    }
+    std::stable_sort(result.begin(), result.end(),
+                     [&](const uint32_t lhs, const uint32_t rhs)
+                     {
+                         return intervals[lhs].start < intervals[rhs].start;
+                     });
+    return result;
+}
+
+TEST(IntervalIndex, Empty)
+{
+    Time::IntervalIndex index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_TRUE(index.stab(0).empty());
+    Time::IntervalIndex::Cursor cursor{index};
+    EXPECT_TRUE(cursor.stab(10).empty());
+    EXPECT_THROW(static_cast<void> (index.at(0)), std::out_of_range);
+    std::vector<Interval> bad{{0, 10}, {5, 4}};
+    EXPECT_THROW(Time::IntervalIndex {bad}, std::invalid_argument);
+}
+
+TEST(IntervalIndex, ChannelEpochs)
+{
+    // Consecutive channel epochs with a gap and an open-ended last epoch
+    std::vector<Interval> epochs{{100, 200}, {200, 350}, {400, 500},
+                                 {500, std::numeric_limits<int64_t>::max()},
+                                 {450, 450}};
+    Time::IntervalIndex index{epochs};
+    EXPECT_EQ(index.size(), 5);
+    EXPECT_EQ(index.at(2).start, 400);
+    EXPECT_EQ(index.at(2).end, 500);
+    EXPECT_TRUE(index.stab(99).empty());
+    ASSERT_EQ(index.stab(100).size(), 1);
+    EXPECT_EQ(index.stab(100)[0], 0);
+    EXPECT_EQ(index.stab(199)[0], 0);
+    EXPECT_EQ(index.stab(200)[0], 1);
+    EXPECT_TRUE(index.stab(350).empty());
+    EXPECT_EQ(index.stab(450).size(), 1);
+    EXPECT_EQ(index.stab(450)[0], 2);
+    EXPECT_EQ(index.stab(1000000)[0], 3);
+    std::vector<int64_t> times{0, 100, 150, 200, 360, 400, 499, 500, 600};
+    std::vector<int64_t> identifiers(times.size());
+    index.stab(times, identifiers);
+    EXPECT_EQ(identifiers,
+              (std::vector<int64_t> {-1, 0, 0, 1, -1, 2, 2, 3, 3}));
+    std::vector<int64_t> tooSmall(1);
+    EXPECT_THROW(index.stab(times, tooSmall), std::invalid_argument);
+}
+
+TEST(IntervalIndex, Overlapping)
+{
+    std::mt19937 generator(4082);
+    std::uniform_int_distribution<int64_t> startDistribution(0, 10000);
+    std::uniform_int_distribution<int64_t> lengthDistribution(0, 500);
+    std::vector<Interval> intervals(300);
+    for (auto &interval : intervals)
+    {
+        interval.start = startDistribution(generator);
+        interval.end = interval.start + lengthDistribution(generator);
+    }
+    Time::IntervalIndex index{intervals};
+    Time::IntervalIndex::Cursor cursor{index};
+    std::vector<int64_t> times;
+    for (int64_t time = -10; time < 10600; time = time + 3)
+    {
+        times.push_back(time);
+    }
+    for (const auto &time : times)
+    {
+        auto reference = referenceStab(intervals, time);
+        auto result = index.stab(time);
+        ASSERT_EQ(result.size(), reference.size());
+        EXPECT_TRUE(std::equal(result.begin(), result.end(),
+                               reference.begin()));
+        auto cursorResult = cursor.stab(time);
+        EXPECT_TRUE(std::equal(cursorResult.begin(), cursorResult.end(),
+                               reference.begin(), reference.end()));
+    }
+    // The cursor also handles unordered queries
+    std::shuffle(times.begin(), times.end(), generator);
+    std::vector<int64_t> identifiers(times.size());
+    index.stab(times, identifiers);
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        auto reference = referenceStab(intervals, times[i]);
+        auto cursorResult = cursor.stab(times[i]);
+        EXPECT_TRUE(std::equal(cursorResult.begin(), cursorResult.end(),
+                               reference.begin(), reference.end()));
+        EXPECT_EQ(identifiers[i], reference.empty() ?
+                                  -1 : static_cast<int64_t> (reference.back()));
+    }
+}
+
+}
@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "time/leapSeconds.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+constexpr int64_t NS{1000000000};
+// 2017-01-01T00:00:00 UTC
+constexpr int64_t LEAP_2017{1483228800*NS};
+
+TEST(LeapSeconds, TAIMinusUTC)
+{
+    Time::LeapSeconds leapSeconds;
+    EXPECT_EQ(leapSeconds.getNumberOfEntries(), 28);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(0), 10);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(63072000*NS - 1), 10);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(78796800*NS - 1), 10);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(78796800*NS), 11);
+    Time::UTC time{"2012-06-30T23:59:59.999999"};
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(time.getEpochInNanoSeconds().count()), 34);
+    time = Time::UTC {"2012-07-01T00:00:00"};
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(time.getEpochInNanoSeconds().count()), 35);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(LEAP_2017 - 1), 36);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(LEAP_2017), 37);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(4102444800*NS), 37);
+}
+
+TEST(LeapSeconds, UTCToTAI)
+{
+    Time::LeapSeconds leapSeconds;
+    EXPECT_EQ(leapSeconds.utcToTAI(LEAP_2017 - NS), LEAP_2017 + 35*NS);
+    EXPECT_EQ(leapSeconds.utcToTAI(LEAP_2017), LEAP_2017 + 37*NS);
+    // TAI runs through the leap second whereas UTC repeats
+    EXPECT_EQ(leapSeconds.taiToUTC(LEAP_2017 + 35*NS), LEAP_2017 - NS);
+    EXPECT_EQ(leapSeconds.taiToUTC(LEAP_2017 + 36*NS), LEAP_2017 - 1);
+    EXPECT_EQ(leapSeconds.taiToUTC(LEAP_2017 + 37*NS - 1), LEAP_2017 - 1);
+    EXPECT_EQ(leapSeconds.taiToUTC(LEAP_2017 + 37*NS), LEAP_2017);
+    // Round trip across all the leap seconds at an odd spacing
+    for (int64_t utc = 0; utc < 1600000000*NS; utc = utc + 86399*NS + 123)
+    {
+        EXPECT_EQ(leapSeconds.taiToUTC(leapSeconds.utcToTAI(utc)), utc);
+    }
+    for (int64_t utc = 1600000000*NS; utc > -NS*86400*365; utc = utc - 86401*NS - 7)
+    {
+        EXPECT_EQ(leapSeconds.taiToUTC(leapSeconds.utcToTAI(utc)), utc);
+    }
+}
+
+TEST(LeapSeconds, GPS)
+{
+    Time::LeapSeconds leapSeconds;
+    // The GPS epoch
+    EXPECT_EQ(leapSeconds.utcToGPS(315964800*NS), 0);
+    EXPECT_EQ(leapSeconds.gpsToUTC(0), 315964800*NS);
+    EXPECT_EQ(Time::LeapSeconds::taiToGPS(Time::LeapSeconds::gpsToTAI(17)), 17);
+    // GPS - UTC is 18 s after 2017
+    EXPECT_EQ(leapSeconds.utcToGPS(LEAP_2017), LEAP_2017 - 315964800*NS + 18*NS);
+    EXPECT_EQ(leapSeconds.gpsToUTC(LEAP_2017 - 315964800*NS + 18*NS), LEAP_2017);
+    EXPECT_EQ(leapSeconds.utcToGPS(LEAP_2017 - 1), LEAP_2017 - 315964800*NS + 17*NS - 1);
+}
+
+TEST(LeapSeconds, Batch)
+{
+    Time::LeapSeconds leapSeconds;
+    std::vector<int64_t> utc;
+    for (int64_t t = LEAP_2017 - 20*NS; t < LEAP_2017 + 20*NS; t = t + NS/4)
+    {
+        utc.push_back(t);
+    }
+    utc.push_back(0);
+    utc.push_back(LEAP_2017);
+    std::vector<int64_t> tai(utc.size());
+    std::vector<int64_t> gps(utc.size());
+    std::vector<int64_t> back(utc.size());
+    Time::LeapSeconds reference;
+    leapSeconds.utcToTAI(utc, tai);
+    leapSeconds.utcToGPS(utc, gps);
+    for (size_t i = 0; i < utc.size(); ++i)
+    {
+        EXPECT_EQ(tai[i], reference.utcToTAI(utc[i]));
+        EXPECT_EQ(gps[i], reference.utcToGPS(utc[i]));
+    }
+    leapSeconds.taiToUTC(tai, back);
+    EXPECT_EQ(back, utc);
+    leapSeconds.gpsToUTC(gps, back);
+    EXPECT_EQ(back, utc);
+    // In place
+    leapSeconds.utcToTAI(utc, utc);
+    EXPECT_EQ(utc, tai);
+    // Every TAI time in a leap second maps to just before the leap second
+    std::vector<int64_t> leap{LEAP_2017 + 36*NS, LEAP_2017 + 36*NS + NS/2};
+    leapSeconds.taiToUTC(leap, leap);
+    EXPECT_EQ(leap[0], LEAP_2017 - 1);
+    EXPECT_EQ(leap[1], LEAP_2017 - 1);
+    std::vector<int64_t> tooSmall(1);
+    EXPECT_THROW(leapSeconds.utcToTAI(tai, tooSmall), std::invalid_argument);
+}
+
+TEST(LeapSeconds, Load)
+{
+    auto fileName = std::filesystem::temp_directory_path()
+                  / "timeLeapSecondsTest.list";
+    {
+    std::ofstream file(fileName);
+    file << "#  A truncated leap-seconds.list\n"
+         << "#$	 3676924800\n"
+         << "2272060800	10	# 1 Jan 1972\n"
+         << "2287785600	11	# 1 Jul 1972\n"
+         << "\n"
+         << "3692217600	37	# 1 Jan 2017\n"
+         << "4102444800	38	# A hypothetical leap second\n";
+    }
+    Time::LeapSeconds leapSeconds;
+    leapSeconds.load(fileName);
+    EXPECT_EQ(leapSeconds.getNumberOfEntries(), 4);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(78796800*NS), 11);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(LEAP_2017 - 1), 11);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(LEAP_2017), 37);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(1893456000*NS), 38);
+    leapSeconds.loadDefault();
+    EXPECT_EQ(leapSeconds.getNumberOfEntries(), 28);
+    EXPECT_EQ(leapSeconds.getTAIMinusUTC(1893456000*NS), 37);
+    {
+    std::ofstream file(fileName);
+    file << "2287785600	11\n"
+         << "2272060800	10\n";
+    }
+    EXPECT_THROW(leapSeconds.load(fileName), std::invalid_argument);
+    {
+    std::ofstream file(fileName);
+    file << "2287785600	eleven\n";
+    }
+    EXPECT_THROW(leapSeconds.load(fileName), std::invalid_argument);
+    {
+    std::ofstream file(fileName);
+    file << "# Nothing\n";
+    }
+    EXPECT_THROW(leapSeconds.load(fileName), std::invalid_argument);
+    std::filesystem::remove(fileName);
+    EXPECT_THROW(leapSeconds.load(fileName), std::invalid_argument);
+    // A failed load leaves the table alone
+    EXPECT_EQ(leapSeconds.getNumberOfEntries(), 28);
+}
+
+}
@@ -0,0 +1,267 @@
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "time/calendar.hpp"
+#include "time/sac.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using ByteOrder = Time::SAC::ByteOrder;
+using Marker = Time::SAC::Marker;
+constexpr auto NUMBER_OF_MARKERS = Time::SAC::NUMBER_OF_MARKERS;
+constexpr auto HEADER_LENGTH = Time::SAC::HEADER_LENGTH;
+
+void putWord(std::byte *header, const size_t word, const uint32_t value,
+             const ByteOrder byteOrder)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto shift = byteOrder == ByteOrder::BigEndian ? 24 - 8*i : 8*i;
+        header[4*word + i] = static_cast<std::byte> ((value >> shift) & 0xFF);
+    }
+}
+
+uint32_t getWord(const std::byte *header, const size_t word,
+                 const ByteOrder byteOrder)
+{
+    uint32_t value{0};
+    for (size_t i = 0; i < 4; ++i)
+    {
+        auto shift = byteOrder == ByteOrder::BigEndian ? 24 - 8*i : 8*i;
+        value = value | (std::to_integer<uint32_t> (header[4*word + i])
+                         << shift);
+    }
+    return value;
+}
+
+/// Creates a header with every float undefined and the given reference time.
+void putHeader(std::byte *header,
+               const int year, const int dayOfYear, const int hour,
+               const int minute, const int second, const int milliSecond,
+               const ByteOrder byteOrder)
+{
+    for (size_t word = 0; word < 70; ++word)
+    {
+        putWord(header, word,
+                std::bit_cast<uint32_t> (Time::SAC::UNDEFINED_FLOAT),
+                byteOrder);
+    }
+    for (size_t word = 70; word < 110; ++word)
+    {
+        putWord(header, word,
+                static_cast<uint32_t> (Time::SAC::UNDEFINED_INTEGER),
+                byteOrder);
+    }
+    putWord(header, 70, static_cast<uint32_t> (year), byteOrder);
+    putWord(header, 71, static_cast<uint32_t> (dayOfYear), byteOrder);
+    putWord(header, 72, static_cast<uint32_t> (hour), byteOrder);
+    putWord(header, 73, static_cast<uint32_t> (minute), byteOrder);
+    putWord(header, 74, static_cast<uint32_t> (second), byteOrder);
+    putWord(header, 75, static_cast<uint32_t> (milliSecond), byteOrder);
+}
+
+void putFloat(std::byte *header, const size_t word, const float value,
+              const ByteOrder byteOrder)
+{
+    putWord(header, word, std::bit_cast<uint32_t> (value), byteOrder);
+}
+
+float getFloat(const std::byte *header, const size_t word,
+               const ByteOrder byteOrder)
+{
+    return std::bit_cast<float> (getWord(header, word, byteOrder));
+}
+
+int64_t toEpoch(const int year, const int dayOfYear, const int hour,
+                const int minute, const int second, const int milliSecond)
+{
+    Time::UTC time;
+    time.setYear(year);
+    time.setDayOfYear(dayOfYear);
+    time.setHour(hour);
+    time.setMinute(minute);
+    time.setSecond(second);
+    time.setMicroSecond(milliSecond*1000);
+    return time.getEpochInNanoSeconds().count();
+}
+
+TEST(SAC, GetTimes)
+{
+    for (auto byteOrder : {ByteOrder::LittleEndian, ByteOrder::BigEndian})
+    {
+        constexpr size_t nHeaders{6};
+        std::vector<std::byte> headers(nHeaders*HEADER_LENGTH);
+        auto *header = headers.data();
+        // Reference time with b, o, and t0
+        putHeader(header, 2024, 60, 13, 45, 10, 500, byteOrder);
+        putFloat(header, 5, -10.25f, byteOrder);
+        putFloat(header, 7, 0.0f, byteOrder);
+        putFloat(header, 10, 3.125f, byteOrder);
+        // Before the epoch with only b
+        header = header + HEADER_LENGTH;
+        putHeader(header, 1969, 365, 23, 59, 59, 999, byteOrder);
+        putFloat(header, 5, 0.001f, byteOrder);
+        // Undefined reference time
+        header = header + HEADER_LENGTH;
+        putHeader(header, -12345, -12345, -12345, -12345, -12345, -12345,
+                  byteOrder);
+        // Invalid millisecond
+        header = header + HEADER_LENGTH;
+        putHeader(header, 2024, 60, 13, 45, 10, 1000, byteOrder);
+        // Non-finite offset
+        header = header + HEADER_LENGTH;
+        putHeader(header, 2024, 60, 13, 45, 10, 0, byteOrder);
+        putFloat(header, 19, std::numeric_limits<float>::quiet_NaN(),
+                 byteOrder);
+        // Offset too large
+        header = header + HEADER_LENGTH;
+        putHeader(header, 2024, 60, 13, 45, 10, 0, byteOrder);
+        putFloat(header, 20, 1.e12f, byteOrder);
+
+        std::vector<int64_t> referenceTimes(nHeaders, -1);
+        std::vector<int64_t> markerTimes(nHeaders*NUMBER_OF_MARKERS, -1);
+        std::vector<uint8_t> invalid(nHeaders, 2);
+        auto nInvalid = Time::SAC::getTimes(headers, referenceTimes,
+                                            markerTimes, invalid, byteOrder);
+        EXPECT_EQ(nInvalid, 4);
+        EXPECT_EQ(invalid, (std::vector<uint8_t> {0, 0, 1, 1, 1, 1}));
+        auto reference = toEpoch(2024, 60, 13, 45, 10, 500);
+        EXPECT_EQ(referenceTimes[0], reference);
+        auto marker = [&](const size_t row, const Marker m)
+        {
+            return markerTimes[Time::SAC::getMarkerIndex(row, m)];
+        };
+        EXPECT_EQ(marker(0, Marker::B), reference - 10250000000);
+        EXPECT_EQ(marker(0, Marker::O), reference);
+        EXPECT_EQ(marker(0, Marker::T0), reference + 3125000000);
+        for (auto m : {Marker::E, Marker::A, Marker::T1, Marker::T9,
+                       Marker::F})
+        {
+            EXPECT_EQ(marker(0, m), Time::SAC::UNDEFINED_TIME);
+        }
+        EXPECT_EQ(referenceTimes[1], -1000000);
+        EXPECT_EQ(marker(1, Marker::B),
+                  -1000000 + std::llround(static_cast<double> (0.001f)*1.e9));
+        for (size_t row = 2; row < nHeaders; ++row)
+        {
+            EXPECT_EQ(referenceTimes[row], 0);
+            for (size_t j = 0; j < NUMBER_OF_MARKERS; ++j)
+            {
+                EXPECT_EQ(markerTimes[row*NUMBER_OF_MARKERS + j], 0);
+            }
+        }
+    }
+    std::vector<std::byte> headers(2*HEADER_LENGTH);
+    std::vector<int64_t> referenceTimes(2);
+    std::vector<int64_t> markerTimes(2*NUMBER_OF_MARKERS);
+    std::vector<uint8_t> invalid(2);
+    EXPECT_THROW(Time::SAC::getTimes(
+                     std::span<const std::byte> (headers.data(), 631),
+                     referenceTimes, markerTimes, invalid),
+                 std::invalid_argument);
+    EXPECT_THROW(Time::SAC::getTimes(
+                     headers, referenceTimes,
+                     std::span<int64_t> (markerTimes.data(),
+                                         2*NUMBER_OF_MARKERS - 1),
+                     invalid),
+                 std::invalid_argument);
+    EXPECT_THROW(Time::SAC::getTimes(
+                     headers, std::span<int64_t> (referenceTimes.data(), 1),
+                     markerTimes, invalid),
+                 std::invalid_argument);
+}
+
+TEST(SAC, RoundTrip)
+{
+    // More than one block of headers
+    constexpr size_t nHeaders{1500};
+    std::mt19937_64 generator(5150);
+    std::uniform_int_distribution<int64_t>
+        times(Time::Calendar::toEpoch(1700, 1, 1, 0, 0, 0, 0),
+              Time::Calendar::toEpoch(2200, 1, 1, 0, 0, 0, 0));
+    std::uniform_int_distribution<int64_t> offsets(-100000000000,
+                                                   100000000000);
+    std::bernoulli_distribution isDefined(0.7);
+    std::vector<int64_t> referenceTimes(nHeaders);
+    std::vector<int64_t> markerTimes(nHeaders*NUMBER_OF_MARKERS);
+    for (size_t i = 0; i < nHeaders; ++i)
+    {
+        referenceTimes[i] = times(generator);
+        for (size_t j = 0; j < NUMBER_OF_MARKERS; ++j)
+        {
+            markerTimes[i*NUMBER_OF_MARKERS + j] = isDefined(generator) ?
+                referenceTimes[i] + offsets(generator) :
+                Time::SAC::UNDEFINED_TIME;
+        }
+    }
+    // Too far from the reference time and out of range
+    markerTimes[Time::SAC::getMarkerIndex(3, Marker::T5)]
+        = std::numeric_limits<int64_t>::max();
+    referenceTimes[7] = Time::SAC::UNDEFINED_TIME;
+    for (auto byteOrder : {ByteOrder::LittleEndian, ByteOrder::BigEndian})
+    {
+        std::vector<std::byte> headers(nHeaders*HEADER_LENGTH);
+        for (size_t i = 0; i < nHeaders; ++i)
+        {
+            putHeader(headers.data() + i*HEADER_LENGTH,
+                      -12345, -12345, -12345, -12345, -12345, -12345,
+                      byteOrder);
+        }
+        std::vector<uint8_t> invalid(nHeaders);
+        auto nInvalid = Time::SAC::setTimes(referenceTimes, markerTimes,
+                                            headers, invalid, byteOrder);
+        EXPECT_EQ(nInvalid, 2);
+        EXPECT_EQ(invalid[3], 1);
+        EXPECT_EQ(invalid[7], 1);
+
+        std::vector<int64_t> referenceTimesBack(nHeaders);
+        std::vector<int64_t> markerTimesBack(nHeaders*NUMBER_OF_MARKERS);
+        std::vector<uint8_t> invalidBack(nHeaders);
+        nInvalid = Time::SAC::getTimes(headers, referenceTimesBack,
+                                       markerTimesBack, invalidBack,
+                                       byteOrder);
+        // Invalid rows were not written so their reference is undefined
+        EXPECT_EQ(nInvalid, 2);
+        EXPECT_EQ(invalidBack, invalid);
+        for (size_t i = 0; i < nHeaders; ++i)
+        {
+            if (invalid[i] != 0){continue;}
+            // The reference is stored to the millisecond
+            auto reference = Time::Calendar::floorDivide(referenceTimes[i],
+                                                         1000000)*1000000;
+            ASSERT_EQ(referenceTimesBack[i], reference);
+            const auto *header = headers.data() + i*HEADER_LENGTH;
+            for (size_t j = 0; j < NUMBER_OF_MARKERS; ++j)
+            {
+                auto expected = markerTimes[i*NUMBER_OF_MARKERS + j];
+                auto actual = markerTimesBack[i*NUMBER_OF_MARKERS + j];
+                if (expected == Time::SAC::UNDEFINED_TIME)
+                {
+                    ASSERT_EQ(actual, expected);
+                    continue;
+                }
+                // Offsets of up to 100 s are stored as floats
+                ASSERT_NEAR(static_cast<double> (actual - expected), 0, 5.e3);
+            }
+            ASSERT_EQ(getFloat(header, 9, byteOrder),
+                      Time::SAC::UNDEFINED_FLOAT);
+        }
+    }
+    std::vector<std::byte> headers(HEADER_LENGTH);
+    std::vector<uint8_t> invalid(1);
+    EXPECT_THROW(Time::SAC::setTimes(
+                     referenceTimes,
+                     std::span<const int64_t> (markerTimes.data(),
+                                               NUMBER_OF_MARKERS - 1),
+                     headers, invalid),
+                 std::invalid_argument);
+}
+
+}
@@ -0,0 +1,164 @@
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "time/calendar.hpp"
+#include "time/sampleAxis.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+// 2020-01-01T00:00:00
+constexpr int64_t START_TIME{1577836800000000000};
+
+/// Brute force floor index using the sample times.
+int64_t referenceFloorIndex(const Time::SamplingPeriod &period,
+                            const int64_t d)
+{
+    auto i = static_cast<int64_t> (std::floor(static_cast<long double> (d)
+           *period.getDenominator()/period.getNumerator())) - 2;
+    while (period.getOffset(i + 1) <= d){i = i + 1;}
+    return i;
+}
+
+TEST(SampleAxis, SamplingPeriod)
+{
+    Time::SamplingPeriod period{10000000};
+    EXPECT_EQ(period.getNumerator(), 10000000);
+    EXPECT_EQ(period.getDenominator(), 1);
+    EXPECT_TRUE(period.isInteger());
+    auto hundredHertz = Time::SamplingPeriod::fromSamplingRate(100);
+    EXPECT_EQ(hundredHertz.getNumerator(), 10000000);
+    EXPECT_TRUE(hundredHertz.isInteger());
+    auto threeHertz = Time::SamplingPeriod::fromSamplingRate(3);
+    EXPECT_EQ(threeHertz.getNumerator(), 1000000000);
+    EXPECT_EQ(threeHertz.getDenominator(), 3);
+    EXPECT_FALSE(threeHertz.isInteger());
+    EXPECT_EQ(threeHertz.getOffset(1), 333333333);
+    EXPECT_EQ(threeHertz.getOffset(2), 666666667);
+    EXPECT_EQ(threeHertz.getOffset(3), 1000000000);
+    EXPECT_EQ(threeHertz.getOffset(-1), -333333333);
+    Time::SamplingPeriod reduced{20, 8};
+    EXPECT_EQ(reduced.getNumerator(), 5);
+    EXPECT_EQ(reduced.getDenominator(), 2);
+    EXPECT_THROW(Time::SamplingPeriod {0}, std::invalid_argument);
+    EXPECT_THROW(Time::SamplingPeriod(1, 0), std::invalid_argument);
+    EXPECT_THROW(static_cast<void> (Time::SamplingPeriod::fromSamplingRate(0)),
+                 std::invalid_argument);
+}
+
+TEST(SampleAxis, Generate)
+{
+    // A day at 100 Hz has no drift
+    std::vector<int64_t> times(8640000);
+    auto period = Time::SamplingPeriod::fromSamplingRate(100);
+    Time::SampleAxis::generate(START_TIME, period, times);
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+        ASSERT_EQ(times[i], START_TIME + static_cast<int64_t> (i)*10000000);
+    }
+    EXPECT_EQ(Time::UTC {std::chrono::nanoseconds {times.back()}}.getSecond(),
+              59);
+    // Rational periods and short outputs
+    for (const auto &[numerator, denominator] :
+         std::vector<std::pair<int64_t, int64_t>> {{1000000000, 3},
+                                                   {1000000000, 7},
+                                                   {5, 2},
+                                                   {1000000000, 13},
+                                                   {123456789, 1}})
+    {
+        Time::SamplingPeriod rational{numerator, denominator};
+        for (size_t n : std::vector<size_t> {0, 1, 5, 8, 9, 100, 1001})
+        {
+            std::vector<int64_t> result(n);
+            Time::SampleAxis::generate(-7, rational, result);
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_EQ(result[i],
+                          -7 + rational.getOffset(static_cast<int64_t> (i)));
+            }
+        }
+    }
+}
+
+TEST(SampleAxis, Indices)
+{
+    std::mt19937 generator(6102);
+    std::uniform_int_distribution<int64_t> distribution(-86400000000000,
+                                                        86400000000000);
+    std::vector<int64_t> times(1003);
+    for (auto &time : times){time = START_TIME + distribution(generator);}
+    // Exact hits and midpoints
+    times[0] = START_TIME;
+    times[1] = START_TIME + 5000000;
+    times[2] = START_TIME - 5000000;
+    times[3] = START_TIME + 4999999;
+    std::vector<int64_t> floorIndices(times.size());
+    std::vector<int64_t> nearestIndices(times.size());
+    for (const auto &period : std::vector<Time::SamplingPeriod>
+                              {Time::SamplingPeriod::fromSamplingRate(100),
+                               Time::SamplingPeriod::fromSamplingRate(3),
+                               Time::SamplingPeriod::fromSamplingRate(40),
+                               Time::SamplingPeriod {1}})
+    {
+        Time::SampleAxis::toFloorIndices(START_TIME, period, times,
+                                         floorIndices);
+        Time::SampleAxis::toNearestIndices(START_TIME, period, times,
+                                           nearestIndices);
+        for (size_t i = 0; i < times.size(); ++i)
+        {
+            auto d = times[i] - START_TIME;
+            auto floorIndex = referenceFloorIndex(period, d);
+            EXPECT_EQ(floorIndices[i], floorIndex);
+            EXPECT_EQ(Time::SampleAxis::toFloorIndex(START_TIME, period,
+                                                     times[i]),
+                      floorIndex);
+            auto lower = d - period.getOffset(floorIndex);
+            auto upper = period.getOffset(floorIndex + 1) - d;
+            auto nearestIndex = upper <= lower ? floorIndex + 1 : floorIndex;
+            EXPECT_EQ(nearestIndices[i], nearestIndex);
+            EXPECT_EQ(Time::SampleAxis::toNearestIndex(START_TIME, period,
+                                                       times[i]),
+                      nearestIndex);
+        }
+    }
+    // Ties go to the later sample
+    auto period = Time::SamplingPeriod::fromSamplingRate(100);
+    EXPECT_EQ(nearestIndices.size(), times.size());
+    Time::SampleAxis::toNearestIndices(START_TIME, period, times,
+                                       nearestIndices);
+    EXPECT_EQ(nearestIndices[1], 1);
+    EXPECT_EQ(nearestIndices[2], 0);
+    EXPECT_EQ(nearestIndices[3], 0);
+    // Quotients too large for the reciprocal
+    std::vector<int64_t> large{START_TIME, -START_TIME, START_TIME/3};
+    std::vector<int64_t> largeIndices(large.size());
+    Time::SampleAxis::toFloorIndices(0, Time::SamplingPeriod {1}, large,
+                                     largeIndices);
+    EXPECT_EQ(largeIndices, large);
+    // Offsets at the extremes of int64 in the vector lanes and the tail
+    constexpr auto maximum = std::numeric_limits<int64_t>::max();
+    constexpr auto minimum = std::numeric_limits<int64_t>::lowest();
+    std::vector<int64_t> extremes{maximum, maximum - 1, minimum, minimum + 1,
+                                  0, -1, maximum/2, minimum/2,
+                                  maximum, (int64_t {1} << 62) + 1, minimum};
+    std::vector<int64_t> extremeIndices(extremes.size());
+    for (int64_t numerator : {int64_t {1}, int64_t {3}, maximum})
+    {
+        Time::SampleAxis::toFloorIndices(0, Time::SamplingPeriod {numerator},
+                                         extremes, extremeIndices);
+        for (size_t i = 0; i < extremes.size(); ++i)
+        {
+            EXPECT_EQ(extremeIndices[i],
+                      Time::Calendar::floorDivide(extremes[i], numerator));
+        }
+    }
+    std::vector<int64_t> tooSmall(1);
+    EXPECT_THROW(Time::SampleAxis::toFloorIndices(START_TIME, period, times,
+                                                  tooSmall),
+                 std::invalid_argument);
+}
+
+}
@@ -0,0 +1,69 @@
+#include <array>
+#include <string>
+#include <string_view>
+#include "time/boundaries.hpp"
+#include "time/calendar.hpp"
+#include "time/sds.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+TEST(SDS, FormatPath)
+{
+    std::array<char, Time::SDS::MAXIMUM_PATH_LENGTH> path;
+    auto length = Time::SDS::formatPath("UU", "CTU", "01", "HHZ", 2023, 7,
+                                        path);
+    EXPECT_EQ(std::string_view(path.data(), length),
+              "2023/UU/CTU/HHZ.D/UU.CTU.01.HHZ.D.2023.007");
+    // Empty location
+    length = Time::SDS::formatPath("UU", "CTU", "", "HHZ", 2024, 366, path);
+    EXPECT_EQ(std::string_view(path.data(), length),
+              "2024/UU/CTU/HHZ.D/UU.CTU..HHZ.D.2024.366");
+    // From a boundary
+    auto day = Time::getBoundary(Time::Calendar::toEpoch(2020, 3, 1,
+                                                         12, 0, 0, 0),
+                                 Time::BoundaryPeriod::Hour);
+    length = Time::SDS::formatPath("IU", "ANMO", "00", "BHZ", day, path);
+    EXPECT_EQ(std::string_view(path.data(), length),
+              "2020/IU/ANMO/BHZ.D/IU.ANMO.00.BHZ.D.2020.061");
+    // Longest codes
+    length = Time::SDS::formatPath("ABCDEFGH", "ABCDEFGH", "ABCDEFGH",
+                                   "ABCDEFGH", 2020, 1, path);
+    EXPECT_EQ(length, Time::SDS::MAXIMUM_PATH_LENGTH);
+    // Exactly large enough
+    std::array<char, 40> small;
+    length = Time::SDS::formatPath("UU", "CTU", "", "HHZ", 2023, 7, small);
+    EXPECT_EQ(length, small.size());
+}
+
+TEST(SDS, InvalidPath)
+{
+    std::array<char, Time::SDS::MAXIMUM_PATH_LENGTH> path;
+    auto check = [&](std::string_view network, std::string_view station,
+                     std::string_view location, std::string_view channel,
+                     int year, int dayOfYear)
+    {
+        EXPECT_THROW(static_cast<void> (Time::SDS::formatPath(network, station,
+                                                              location, channel,
+                                                              year, dayOfYear,
+                                                              path)),
+                     std::invalid_argument);
+    };
+    check("", "CTU", "01", "HHZ", 2023, 1);
+    check("UU", "", "01", "HHZ", 2023, 1);
+    check("UU", "CTU", "01", "", 2023, 1);
+    check("UU", "CT/U", "01", "HHZ", 2023, 1);
+    check("UU", "CTU", "0.", "HHZ", 2023, 1);
+    check("UU", "ABCDEFGHI", "01", "HHZ", 2023, 1);
+    check("UU", "CTU", "01", "HHZ", 1677, 1);
+    check("UU", "CTU", "01", "HHZ", 2262, 1);
+    check("UU", "CTU", "01", "HHZ", 2023, 0);
+    check("UU", "CTU", "01", "HHZ", 2023, 366);
+    std::array<char, 39> small;
+    EXPECT_THROW(static_cast<void> (Time::SDS::formatPath(
+                     "UU", "CTU", "", "HHZ", 2023, 7, small)),
+                 std::invalid_argument);
+}
+
+}
@@ -0,0 +1,203 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "time/calendar.hpp"
+#include "time/seed.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using ByteOrder = Time::SEED::ByteOrder;
+
+void putUInt16(std::byte *buffer, const uint16_t value,
+               const ByteOrder byteOrder)
+{
+    auto high = static_cast<std::byte> (value >> 8);
+    auto low = static_cast<std::byte> (value & 0xFF);
+    buffer[0] = byteOrder == ByteOrder::BigEndian ? high : low;
+    buffer[1] = byteOrder == ByteOrder::BigEndian ? low : high;
+}
+
+void putInt32(std::byte *buffer, const int32_t value,
+              const ByteOrder byteOrder)
+{
+    auto bits = static_cast<uint32_t> (value);
+    for (int i = 0; i < 4; ++i)
+    {
+        auto shift = byteOrder == ByteOrder::BigEndian ? 24 - 8*i : 8*i;
+        buffer[i] = static_cast<std::byte> ((bits >> shift) & 0xFF);
+    }
+}
+
+void putBTIME(std::byte *buffer,
+              const int year, const int dayOfYear,
+              const int hour, const int minute, const int second,
+              const int ticks, const ByteOrder byteOrder)
+{
+    putUInt16(buffer, static_cast<uint16_t> (year), byteOrder);
+    putUInt16(buffer + 2, static_cast<uint16_t> (dayOfYear), byteOrder);
+    buffer[4] = static_cast<std::byte> (hour);
+    buffer[5] = static_cast<std::byte> (minute);
+    buffer[6] = static_cast<std::byte> (second);
+    buffer[7] = std::byte {0};
+    putUInt16(buffer + 8, static_cast<uint16_t> (ticks), byteOrder);
+}
+
+int64_t toEpoch(const int year, const int dayOfYear,
+                const int hour, const int minute, const int second,
+                const int ticks)
+{
+    Time::UTC time;
+    time.setYear(year);
+    time.setDayOfYear(dayOfYear);
+    time.setHour(hour);
+    time.setMinute(minute);
+    time.setSecond(second);
+    time.setMicroSecond(ticks*100);
+    return time.getEpochInNanoSeconds().count();
+}
+
+TEST(SEED, BTIME)
+{
+    for (auto byteOrder : {ByteOrder::BigEndian, ByteOrder::LittleEndian})
+    {
+        std::array<std::byte, Time::SEED::BTIME_LENGTH> btime;
+        putBTIME(btime.data(), 2024, 366, 23, 59, 59, 9999, byteOrder);
+        EXPECT_EQ(Time::SEED::fromBTIME(btime, byteOrder),
+                  toEpoch(2024, 366, 23, 59, 59, 9999));
+        putBTIME(btime.data(), 1970, 1, 0, 0, 0, 0, byteOrder);
+        EXPECT_EQ(Time::SEED::fromBTIME(btime, byteOrder), 0);
+        putBTIME(btime.data(), 1969, 365, 23, 59, 59, 1, byteOrder);
+        EXPECT_EQ(Time::SEED::fromBTIME(btime, byteOrder),
+                  -1000000000 + 100000);
+        // A leap second carries into the next day
+        putBTIME(btime.data(), 2016, 366, 23, 59, 60, 5000, byteOrder);
+        EXPECT_EQ(Time::SEED::fromBTIME(btime, byteOrder),
+                  toEpoch(2017, 1, 0, 0, 0, 5000));
+    }
+    std::mt19937 generator(8675);
+    std::uniform_int_distribution<int> years(1678, 2261);
+    std::uniform_int_distribution<int> hours(0, 23);
+    std::uniform_int_distribution<int> minutes(0, 59);
+    std::uniform_int_distribution<int> ticks(0, 9999);
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto year = years(generator);
+        auto nDays = Time::Calendar::isLeapYear(year) ? 366 : 365;
+        auto dayOfYear = std::uniform_int_distribution<int> (1, nDays)(generator);
+        auto hour = hours(generator);
+        auto minute = minutes(generator);
+        auto second = minutes(generator);
+        auto tick = ticks(generator);
+        std::array<std::byte, Time::SEED::BTIME_LENGTH> btime;
+        putBTIME(btime.data(), year, dayOfYear, hour, minute, second, tick,
+                 ByteOrder::BigEndian);
+        EXPECT_EQ(Time::SEED::fromBTIME(btime),
+                  toEpoch(year, dayOfYear, hour, minute, second, tick));
+    }
+}
+
+TEST(SEED, InvalidBTIME)
+{
+    std::array<std::byte, Time::SEED::BTIME_LENGTH> btime;
+    EXPECT_THROW(static_cast<void> (Time::SEED::fromBTIME(
+                     std::span<const std::byte> (btime.data(), 9))),
+                 std::invalid_argument);
+    auto check = [&](const int year, const int dayOfYear,
+                     const int hour, const int minute, const int second,
+                     const int ticks)
+    {
+        putBTIME(btime.data(), year, dayOfYear, hour, minute, second, ticks,
+                 ByteOrder::BigEndian);
+        EXPECT_THROW(static_cast<void> (Time::SEED::fromBTIME(btime)),
+                     std::invalid_argument);
+    };
+    check(1677, 1, 0, 0, 0, 0);
+    check(2262, 1, 0, 0, 0, 0);
+    check(2023, 0, 0, 0, 0, 0);
+    check(2023, 366, 0, 0, 0, 0);
+    check(2024, 367, 0, 0, 0, 0);
+    check(2024, 1, 24, 0, 0, 0);
+    check(2024, 1, 0, 60, 0, 0);
+    check(2024, 1, 0, 0, 61, 0);
+    check(2024, 1, 0, 0, 0, 10000);
+}
+
+TEST(SEED, RecordStartTimes)
+{
+    constexpr size_t recordLength{512};
+    for (auto byteOrder : {ByteOrder::BigEndian, ByteOrder::LittleEndian})
+    {
+        constexpr size_t nRecords{5};
+        std::vector<std::byte> records(nRecords*recordLength, std::byte {0});
+        auto *record = records.data();
+        // No correction
+        putBTIME(record + 20, 2023, 45, 12, 30, 15, 1234, byteOrder);
+        // Correction not yet applied
+        record = record + recordLength;
+        putBTIME(record + 20, 2023, 45, 12, 30, 15, 1234, byteOrder);
+        putInt32(record + 40, -2345, byteOrder);
+        // Correction already applied
+        record = record + recordLength;
+        putBTIME(record + 20, 2023, 45, 12, 30, 15, 1234, byteOrder);
+        putInt32(record + 40, -2345, byteOrder);
+        record[36] = std::byte {0x02};
+        // Invalid
+        record = record + recordLength;
+        putBTIME(record + 20, 2023, 45, 25, 30, 15, 1234, byteOrder);
+        record = record + recordLength;
+        putBTIME(record + 20, 2000, 60, 0, 0, 0, 0, byteOrder);
+
+        auto reference = toEpoch(2023, 45, 12, 30, 15, 1234);
+        std::vector<int64_t> startTimes(nRecords, -1);
+        std::vector<uint8_t> invalid(nRecords, 2);
+        auto nInvalid
+            = Time::SEED::getRecordStartTimes(records, recordLength,
+                                              startTimes, invalid, byteOrder);
+        EXPECT_EQ(nInvalid, 1);
+        EXPECT_EQ(startTimes[0], reference);
+        EXPECT_EQ(startTimes[1], reference - 234500000);
+        EXPECT_EQ(startTimes[2], reference);
+        EXPECT_EQ(startTimes[3], 0);
+        EXPECT_EQ(startTimes[4], toEpoch(2000, 60, 0, 0, 0, 0));
+        EXPECT_EQ(invalid, (std::vector<uint8_t> {0, 0, 0, 1, 0}));
+        for (size_t i = 0; i < nRecords; ++i)
+        {
+            std::span<const std::byte> view(records.data() + i*recordLength,
+                                            recordLength);
+            if (invalid[i] == 0)
+            {
+                EXPECT_EQ(Time::SEED::getRecordStartTime(view, byteOrder),
+                          startTimes[i]);
+            }
+            else
+            {
+                EXPECT_THROW(static_cast<void> (
+                    Time::SEED::getRecordStartTime(view, byteOrder)),
+                    std::invalid_argument);
+            }
+        }
+    }
+    std::vector<std::byte> records(2*recordLength);
+    std::vector<int64_t> startTimes(2);
+    std::vector<uint8_t> invalid(2);
+    EXPECT_THROW(Time::SEED::getRecordStartTimes(records, 47,
+                                                 startTimes, invalid),
+                 std::invalid_argument);
+    EXPECT_THROW(Time::SEED::getRecordStartTimes(records, 500,
+                                                 startTimes, invalid),
+                 std::invalid_argument);
+    EXPECT_THROW(Time::SEED::getRecordStartTimes(
+                     records, recordLength,
+                     std::span<int64_t> (startTimes.data(), 1), invalid),
+                 std::invalid_argument);
+    EXPECT_THROW(static_cast<void> (Time::SEED::getRecordStartTime(
+                     std::span<const std::byte> (records.data(), 47))),
+                 std::invalid_argument);
+}
+
+}
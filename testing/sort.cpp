@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include "time/sort.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+/// Random times with many duplicates and both signs.
+std::vector<int64_t> createTimes(const size_t n, const int64_t range)
+{
+    std::mt19937_64 generator{3828};
+    std::uniform_int_distribution<int64_t> distribution{-range, range};
+    std::vector<int64_t> times(n);
+    for (auto &time : times){time = distribution(generator);}
+    return times;
+}
+
+TEST(Sort, NanoSeconds)
+{
+    for (const auto n : std::vector<size_t> {0, 1, 10, 511, 512, 100000})
+    {
+        for (const int64_t range : std::vector<int64_t>
+                                   {100, 86400000000000,
+                                    std::numeric_limits<int64_t>::max()})
+        {
+            auto times = createTimes(n, range);
+            auto reference = times;
+            std::sort(reference.begin(), reference.end());
+            Time::Sort::sort(times);
+            EXPECT_EQ(times, reference);
+        }
+    }
+    // Extremes
+    std::vector<int64_t> times(1000, 0);
+    times[3] = std::numeric_limits<int64_t>::max();
+    times[700] = std::numeric_limits<int64_t>::min();
+    times[800] = -1;
+    Time::Sort::sort(times);
+    EXPECT_EQ(times.front(), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(times[1], -1);
+    EXPECT_EQ(times[2], 0);
+    EXPECT_EQ(times.back(), std::numeric_limits<int64_t>::max());
+}
+
+TEST(Sort, UTC)
+{
+    auto epochs = createTimes(10000, 100LL*365*86400000000000);
+    std::vector<Time::UTC> times;
+    for (const auto &epoch : epochs)
+    {
+        times.push_back(Time::UTC{std::chrono::nanoseconds {epoch}});
+    }
+    // Cached calendar fields move with the time
+    static_cast<void> (times[17].getYear());
+    auto reference = times;
+    std::sort(reference.begin(), reference.end());
+    Time::Sort::sort(times);
+    EXPECT_EQ(times, reference);
+    for (const auto &time : times)
+    {
+        EXPECT_EQ(time.getYear(), Time::UTC{time.getEpochInNanoSeconds()}.getYear());
+    }
+}
+
+TEST(Sort, Pairs)
+{
+    // Coarse times so the stability is tested
+    auto epochs = createTimes(50000, 1000);
+    std::vector<std::pair<Time::UTC, std::string>> picks;
+    std::vector<std::pair<int64_t, size_t>> rows;
+    for (size_t i = 0; i < epochs.size(); ++i)
+    {
+        picks.emplace_back(Time::UTC{std::chrono::nanoseconds {epochs[i]}},
+                           "P" + std::to_string(i));
+        rows.emplace_back(epochs[i], i);
+    }
+    auto pickReference = picks;
+    std::stable_sort(pickReference.begin(), pickReference.end(),
+                     [](const auto &lhs, const auto &rhs)
+                     {
+                         return lhs.first < rhs.first;
+                     });
+    auto rowReference = rows;
+    std::stable_sort(rowReference.begin(), rowReference.end(),
+                     [](const auto &lhs, const auto &rhs)
+                     {
+                         return lhs.first < rhs.first;
+                     });
+    Time::Sort::sort(std::span {picks});
+    Time::Sort::sort(std::span {rows});
+    EXPECT_EQ(picks, pickReference);
+    EXPECT_EQ(rows, rowReference);
+}
+
+TEST(Sort, Key)
+{
+    struct Pick
+    {
+        int64_t identifier{0};
+        Time::UTC time;
+    };
+    auto epochs = createTimes(2000, 50);
+    std::vector<Pick> picks;
+    for (size_t i = 0; i < epochs.size(); ++i)
+    {
+        picks.push_back(Pick{static_cast<int64_t> (i),
+                             Time::UTC{std::chrono::nanoseconds {epochs[i]}}});
+    }
+    Time::Sort::sort(std::span {picks},
+                     [](const Pick &pick){return pick.time;});
+    for (size_t i = 1; i < picks.size(); ++i)
+    {
+        ASSERT_TRUE(picks[i - 1].time <= picks[i].time);
+        if (picks[i - 1].time == picks[i].time)
+        {
+            EXPECT_LT(picks[i - 1].identifier, picks[i].identifier);
+        }
+    }
+}
+
+}
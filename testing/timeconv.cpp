@@ -0,0 +1,82 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include "converter.hpp"
+#include "time/utc.hpp"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::string formatEpoch(const int64_t nanoSeconds)
+{
+    char buffer[TimeConv::EPOCH_LENGTH];
+    auto end = TimeConv::formatEpoch(nanoSeconds, buffer);
+    return std::string(buffer, end);
+}
+
+TEST(TimeConv, Epoch)
+{
+    int64_t nanoSeconds{0};
+    EXPECT_TRUE(TimeConv::parseEpoch("1577836800", nanoSeconds));
+    EXPECT_EQ(nanoSeconds, 1577836800000000000);
+    EXPECT_TRUE(TimeConv::parseEpoch("1577836800.123456789", nanoSeconds));
+    EXPECT_EQ(nanoSeconds, 1577836800123456789);
+    EXPECT_TRUE(TimeConv::parseEpoch("-1.5", nanoSeconds));
+    EXPECT_EQ(nanoSeconds, -1500000000);
+    EXPECT_TRUE(TimeConv::parseEpoch("+2.", nanoSeconds));
+    EXPECT_EQ(nanoSeconds, 2000000000);
+    EXPECT_FALSE(TimeConv::parseEpoch("", nanoSeconds));
+    EXPECT_FALSE(TimeConv::parseEpoch("-", nanoSeconds));
+    EXPECT_FALSE(TimeConv::parseEpoch(".5", nanoSeconds));
+    EXPECT_FALSE(TimeConv::parseEpoch("1.0000000001", nanoSeconds));
+    EXPECT_FALSE(TimeConv::parseEpoch("12a", nanoSeconds));
+    EXPECT_FALSE(TimeConv::parseEpoch("99999999999999999999", nanoSeconds));
+
+    EXPECT_EQ(formatEpoch(0), "0.000000");
+    EXPECT_EQ(formatEpoch(1577836800123456789), "1577836800.123456");
+    EXPECT_EQ(formatEpoch(-1500000000), "-1.500000");
+    EXPECT_EQ(formatEpoch(-1), "-0.000001");
+    // Round trip
+    std::mt19937_64 generator(321);
+    std::uniform_int_distribution<int64_t> microSeconds(-9000000000000000,
+                                                         9000000000000000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto reference = microSeconds(generator)*1000;
+        ASSERT_TRUE(TimeConv::parseEpoch(formatEpoch(reference), nanoSeconds));
+        EXPECT_EQ(nanoSeconds, reference);
+    }
+}
+
+TEST(TimeConv, Convert)
+{
+    std::string_view input{"1577836800.5 UU.CTU P\n"
+                           "  2020-01-01T00:00:00.25Z\tUU.SRU S\r\n"
+                           "\n"
+                           "# comment\n"
+                           "-1"};
+    std::string output;
+    auto summary = TimeConv::convert(input, TimeConv::Mode::Automatic, output);
+    EXPECT_EQ(output, "2020-01-01T00:00:00.500000 UU.CTU P\n"
+                      "  1577836800.250000\tUU.SRU S\r\n"
+                      "\n"
+                      "# comment\n"
+                      "1969-12-31T23:59:59.000000");
+    EXPECT_EQ(summary.lines, 5);
+    EXPECT_EQ(summary.failures, 1);
+
+    output.clear();
+    summary = TimeConv::convert(input, TimeConv::Mode::ToEpoch, output);
+    EXPECT_EQ(summary.failures, 3);
+    output.clear();
+    summary = TimeConv::convert(input, TimeConv::Mode::ToISO8601, output);
+    EXPECT_EQ(summary.failures, 2);
+    // The output appends
+    summary = TimeConv::convert("0\n", TimeConv::Mode::ToISO8601, output);
+    EXPECT_TRUE(output.ends_with("1970-01-01T00:00:00.000000\n"));
+    EXPECT_EQ(summary.lines, 1);
+}
+
+}
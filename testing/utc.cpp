@@ -1,6 +1,19 @@
 #include <iostream>
 #include <cmath>
 #include <string>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+#include <sstream>
+#include <iomanip>
+#include <version>
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
 #include "time/utc.hpp"
 #include <gtest/gtest.h>
 
@@ -134,6 +147,102 @@ TEST(UTC, CalendarToEpoch)
     EXPECT_TRUE(copyTime.isLeapYear());
 }
 
+TEST(UTC, ValueSemantics)
+{
+    static_assert(std::is_nothrow_copy_constructible_v<Time::UTC>);
+    static_assert(std::is_nothrow_move_constructible_v<Time::UTC>);
+    static_assert(sizeof(Time::UTC) <= 32);
+    Time::UTC time(1408117832.844000);
+    Time::UTC moveTime(std::move(time));
+    // Moved-from object is still valid
+    EXPECT_EQ(time.getYear(), 2014);
+    EXPECT_NEAR(time.getEpoch(), 1408117832.844000, 1.e-6);
+    EXPECT_TRUE(time == moveTime);
+    time.setMicroSecond(0);
+    EXPECT_NEAR(time.getEpoch(), 1408117832.0, 1.e-6);
+    EXPECT_NEAR(moveTime.getEpoch(), 1408117832.844000, 1.e-6);
+}
+
+TEST(UTC, NanoSecondPrecision)
+{
+    // A miniSEED3 time with nanosecond precision
+    std::chrono::nanoseconds epoch{1408117832123456789};
+    Time::UTC time(epoch);
+    EXPECT_EQ(time.getEpochInNanoSeconds(), epoch);
+    EXPECT_EQ(time.getYear(), 2014);
+    EXPECT_EQ(time.getDayOfYear(), 227);
+    EXPECT_EQ(time.getSecond(), 32);
+    EXPECT_EQ(time.getMicroSecond(), 123456);
+    EXPECT_EQ(time.getNanoSecond(), 123456789);
+    EXPECT_EQ(time.getEpochInMicroSeconds().count(), 1408117832123456);
+    // Changing the calendar does not disturb the sub-second
+    time.setHour(3);
+    EXPECT_EQ(time.getNanoSecond(), 123456789);
+    EXPECT_EQ(time.getEpochInNanoSeconds().count(), 1408074632123456789);
+    time.setNanoSecond(1);
+    EXPECT_EQ(time.getEpochInNanoSeconds().count(), 1408074632000000001);
+    EXPECT_EQ(time.getMicroSecond(), 0);
+    EXPECT_THROW(time.setNanoSecond(1000000000), std::invalid_argument);
+    // Fractions that round up carry into the next second
+    Time::UTC carry(1408117832.9999997);
+    EXPECT_EQ(carry.getSecond(), 33);
+    EXPECT_EQ(carry.getMicroSecond(), 0);
+    // Times before the epoch
+    Time::UTC before(-0.25);
+    EXPECT_EQ(before.getYear(), 1969);
+    EXPECT_EQ(before.getMonth(), 12);
+    EXPECT_EQ(before.getDayOfMonth(), 31);
+    EXPECT_EQ(before.getHour(), 23);
+    EXPECT_EQ(before.getMinute(), 59);
+    EXPECT_EQ(before.getSecond(), 59);
+    EXPECT_EQ(before.getMicroSecond(), 750000);
+    EXPECT_NEAR(before.getEpoch(), -0.25, 1.e-10);
+    // Day of month is validated against the month
+    Time::UTC february(1330000000.0); // 2012-02-23
+    EXPECT_THROW(february.setMonthAndDay(std::pair(2, 30)),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(february.setMonthAndDay(std::pair(2, 29)));
+    EXPECT_EQ(february.getDayOfYear(), 60);
+}
+
+TEST(UTC, SecondsAsDouble)
+{
+    // Every double API rounds the seconds to the nearest microsecond
+    Time::UTC origin{std::chrono::nanoseconds {0}};
+    EXPECT_EQ((origin + 1.e-7).getEpochInNanoSeconds().count(), 0);
+    EXPECT_EQ(Time::UTC{origin.getEpoch() + 1.e-7}, origin + 1.e-7);
+    EXPECT_EQ((origin + 1.6e-6).getEpochInNanoSeconds().count(), 2000);
+    EXPECT_EQ(Time::UTC{1.6e-6}.getEpochInNanoSeconds().count(), 2000);
+    EXPECT_EQ((origin - 1.6e-6).getEpochInNanoSeconds().count(), -2000);
+    // The nanoseconds of the time are kept
+    Time::UTC time{std::chrono::nanoseconds {1408117832123456789}};
+    EXPECT_EQ((time + 0.5).getEpochInNanoSeconds().count(),
+              1408117832623456789);
+    EXPECT_EQ((time - 0.5).getEpochInNanoSeconds().count(),
+              1408117831623456789);
+    // Seconds that are not finite or out of range are rejected
+    const auto reference = time;
+    for (auto seconds : {std::nan(""), HUGE_VAL, -HUGE_VAL, 1.e300, -1.e300,
+                         -9214560000.000001, 9214646400.0})
+    {
+        EXPECT_EQ(time.trySetEpoch(seconds).error(),
+                  Time::Error::EpochOutOfRange);
+        EXPECT_THROW(time.setEpoch(seconds), std::invalid_argument);
+        EXPECT_THROW(Time::UTC{seconds}, std::invalid_argument);
+        EXPECT_THROW(static_cast<void> (time + seconds),
+                     std::invalid_argument);
+        EXPECT_THROW(static_cast<void> (time - seconds),
+                     std::invalid_argument);
+    }
+    EXPECT_EQ(time, reference);
+    // The first and last supported years
+    EXPECT_TRUE(time.trySetEpoch(-9214560000.0));
+    EXPECT_EQ(time.getYear(), 1678);
+    EXPECT_TRUE(time.trySetEpoch(9214646399.5));
+    EXPECT_EQ(time.getYear(), 2261);
+    EXPECT_EQ(time.getMicroSecond(), 500000);
+}
+
 TEST(UTC, clear)
 {
     Time::UTC time(1408117832.844000);
@@ -158,6 +267,25 @@ TEST(UTC, CompareTime)
     EXPECT_TRUE(time2 > time1);
     EXPECT_TRUE(time1 == time1);
     EXPECT_TRUE(time1 != time2);
+    EXPECT_TRUE(time1 <= time2);
+    EXPECT_TRUE(time2 >= time1);
+    EXPECT_EQ(time1 <=> time2, std::strong_ordering::less);
+    EXPECT_EQ(time1 <=> time1, std::strong_ordering::equal);
+    // Times that differ by a nanosecond are distinct
+    Time::UTC time3{std::chrono::nanoseconds {1460402025255000001}};
+    EXPECT_TRUE(time1 < time3);
+    EXPECT_FALSE(time1 == time3);
+    // Hashing
+    std::hash<Time::UTC> hash;
+    EXPECT_EQ(hash(time1), hash(Time::UTC{time1.getEpochInNanoSeconds()}));
+    EXPECT_NE(hash(time1), hash(time3));
+    std::unordered_map<Time::UTC, int> counts;
+    for (int i = 0; i < 1000; ++i)
+    {
+        counts[Time::UTC{std::chrono::milliseconds {10*(i % 100)}}] += 1;
+    }
+    EXPECT_EQ(counts.size(), 100);
+    EXPECT_EQ(counts[Time::UTC{std::chrono::milliseconds {990}}], 10);
 }
 
 
@@ -189,6 +317,65 @@ TEST(Time, TimeOperators)
     EXPECT_NEAR(time4.getEpoch(), 1578513045.372 + 86400, 1.e-4);
 }
 
+TEST(Time, Duration)
+{
+    using namespace std::chrono_literals;
+    Time::UTC start{"2020-01-08T23:59:59.995"};
+    auto time = start;
+    // Warm the calendar cache so the in-place updates are exercised
+    EXPECT_EQ(time.getHour(), 23);
+    time += 3ms;
+    EXPECT_EQ(time, Time::UTC{"2020-01-08T23:59:59.998"});
+    EXPECT_EQ(time.getSecond(), 59);
+    time += 10ms;
+    EXPECT_EQ(time.getDayOfMonth(), 9);
+    EXPECT_EQ(time.getHour(), 0);
+    EXPECT_EQ(time.getNanoSecond(), 8000000);
+    time -= 1h;
+    EXPECT_EQ(time, Time::UTC{"2020-01-08T23:00:00.008"});
+    EXPECT_EQ(time.getMonthAndDay(), std::pair(1, 8));
+    EXPECT_EQ(Time::difference(time, start), -(59min + 59s + 987ms));
+    EXPECT_EQ(start + 5ms - 5ms, start);
+    EXPECT_EQ(start + 0.005, start + 5ms);
+    EXPECT_EQ(start - 0.005, start - 5ms);
+    // Random walks agree with a fresh decomposition
+    std::mt19937_64 generator(7);
+    std::uniform_int_distribution<int64_t> steps(-4000000000000,
+                                                  4000000000000);
+    time = Time::UTC{"1969-12-31T12:00:00"};
+    for (int i = 0; i < 100000; ++i)
+    {
+        auto step = Time::Duration {steps(generator)/(1 + i % 1000)};
+        if (i % 2 == 0){time += step;} else {time -= -step;}
+        Time::UTC reference{time.getEpochInNanoSeconds()};
+        ASSERT_EQ(time.getYear(), reference.getYear());
+        ASSERT_EQ(time.getDayOfYear(), reference.getDayOfYear());
+        ASSERT_EQ(time.getMonthAndDay(), reference.getMonthAndDay());
+        ASSERT_EQ(time.getHour(), reference.getHour());
+        ASSERT_EQ(time.getMinute(), reference.getMinute());
+        ASSERT_EQ(time.getSecond(), reference.getSecond());
+    }
+}
+
+TEST(Time, Format)
+{
+    Time::UTC time("2020-03-17T08:01:33.009000");
+    char buffer[Time::UTC::ISO8601_LENGTH];
+    auto end = time.toChars(buffer);
+    EXPECT_EQ(end, buffer + Time::UTC::ISO8601_LENGTH);
+    EXPECT_EQ(std::string(buffer, end), "2020-03-17T08:01:33.009000");
+    std::ostringstream stream;
+    stream << std::setw(28) << Time::UTC(1230784385.5);
+    EXPECT_EQ(stream.str(), "  2009-01-01T04:33:05.500000");
+    Time::UTC before(-0.000001);
+    EXPECT_EQ(std::string(buffer, before.toChars(buffer)),
+              "1969-12-31T23:59:59.999999");
+#if defined(__cpp_lib_format)
+    EXPECT_EQ(std::format("{}", time), "2020-03-17T08:01:33.009000");
+    EXPECT_EQ(std::format("[{:>27}]", time), "[ 2020-03-17T08:01:33.009000]");
+#endif
+}
+
 TEST(Time, StringConstructor)
 {
     // Test the string constructor
@@ -211,6 +398,171 @@ TEST(Time, StringConstructor)
     EXPECT_EQ(strTime2.getMinute(), 1); 
     EXPECT_EQ(strTime2.getSecond(), 33);
     EXPECT_EQ(strTime2.getMicroSecond(), 0); 
+
+    // Variable fractional digits, a space separator, and a Z suffix
+    Time::UTC nanoTime("2020-03-17 08:01:33.123456789Z");
+    EXPECT_EQ(nanoTime.getEpochInNanoSeconds().count(), 1584432093123456789);
+    Time::UTC milliTime("2020-03-17T08:01:33.5");
+    EXPECT_EQ(milliTime.getNanoSecond(), 500000000);
+    Time::UTC zuluTime("2020-03-17T08:01:33Z");
+    EXPECT_EQ(zuluTime, strTime2);
+    Time::UTC leapDay("2020-02-29T23:59:59.999");
+    EXPECT_EQ(leapDay.getDayOfYear(), 60);
+    EXPECT_EQ(leapDay.getMicroSecond(), 999000);
+
+    // Malformed or out of range time stamps
+    EXPECT_THROW(Time::UTC("2020-03-17"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-17T08:01:33."), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-17T08:01:33.1234567890"),
+                 std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-17T08:01:33ZZ"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020/03/17T08:01:33"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-17X08:01:33"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-1a08:01:33"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-17T08:0a:33"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2019-02-29T08:01:33"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-13-17T08:01:33"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-17T24:01:33"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-17T08:60:33"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("2020-03-17T08:01:60"), std::invalid_argument);
+    EXPECT_THROW(Time::UTC("1492-03-17T08:01:33"), std::invalid_argument);
+}
+
+TEST(Time, ConstantExpression)
+{
+    using namespace Time::Literals;
+    constexpr auto gpsEpoch = "1980-01-06T00:00:00"_utc;
+    static_assert(gpsEpoch.getEpochInNanoSeconds().count()
+               == 315964800LL*1000000000);
+    static_assert("2020-03-17 08:01:33.123456789Z"_utc
+               == Time::UTC{std::chrono::nanoseconds {1584432093123456789}});
+    static_assert("1969-12-31T23:59:59.999999"_utc
+                     .getEpochInMicroSeconds().count() == -1);
+    static_assert("2020-02-29T00:00:00"_utc - "2020-02-28T00:00:00"_utc
+               == Time::UTC{std::chrono::seconds {86400}});
+    static_assert("1678-01-01T00:00:00"_utc < "2261-12-31T23:59:59.999999999"_utc);
+    // The calendar works on a compile-time constant
+    EXPECT_EQ(gpsEpoch.getYear(), 1980);
+    EXPECT_EQ(gpsEpoch.getDayOfYear(), 6);
+    // The compile-time and run-time parsers agree
+    const std::vector<std::string> stamps{"2020-03-17T08:01:33.009000",
+                                          "2020-03-17T08:01:33",
+                                          "2020-03-17 08:01:33.123456789Z",
+                                          "2020-03-17T08:01:33.5",
+                                          "2020-02-29T23:59:59.999",
+                                          "1678-01-01T00:00:00",
+                                          "1969-12-31T23:59:59.000000001"};
+    constexpr std::array<Time::UTC, 7> constants{
+        "2020-03-17T08:01:33.009000"_utc,
+        "2020-03-17T08:01:33"_utc,
+        "2020-03-17 08:01:33.123456789Z"_utc,
+        "2020-03-17T08:01:33.5"_utc,
+        "2020-02-29T23:59:59.999"_utc,
+        "1678-01-01T00:00:00"_utc,
+        "1969-12-31T23:59:59.000000001"_utc};
+    for (size_t i = 0; i < stamps.size(); ++i)
+    {
+        EXPECT_EQ(constants[i], Time::UTC{stamps[i]});
+    }
+}
+
+TEST(UTC, NonThrowing)
+{
+    auto time = Time::UTC::tryParse("2022-03-17T08:01:33.009Z");
+    ASSERT_TRUE(time.has_value());
+    EXPECT_EQ(*time, Time::UTC{"2022-03-17T08:01:33.009"});
+    time = Time::UTC::tryParse("2022-02-29T08:01:33");
+    ASSERT_FALSE(time);
+    EXPECT_EQ(time.error(), Time::Error::InvalidTimeStamp);
+    EXPECT_THROW(auto value = time.value(), std::invalid_argument);
+    EXPECT_EQ(time.value_or(Time::UTC{}), Time::UTC{});
+    EXPECT_FALSE(Time::UTC::tryParse("2022-03-17 08:01"));
+
+    auto components = Time::UTC::fromComponents(2024, 2, 29, 23, 59, 58,
+                                                 123456789);
+    ASSERT_TRUE(components);
+    EXPECT_EQ(components->getEpochInNanoSeconds().count(),
+              1709251198123456789);
+    EXPECT_EQ(Time::UTC::fromComponents(1677, 1, 1).error(),
+              Time::Error::YearOutOfRange);
+    EXPECT_EQ(Time::UTC::fromComponents(2023, 13, 1).error(),
+              Time::Error::MonthOutOfRange);
+    EXPECT_EQ(Time::UTC::fromComponents(2023, 2, 29).error(),
+              Time::Error::DayOfMonthOutOfRange);
+    EXPECT_EQ(Time::UTC::fromComponents(2023, 2, 28, 24).error(),
+              Time::Error::HourOutOfRange);
+    EXPECT_EQ(Time::UTC::fromComponents(2023, 2, 28, 0, 60).error(),
+              Time::Error::MinuteOutOfRange);
+    EXPECT_EQ(Time::UTC::fromComponents(2023, 2, 28, 0, 0, 60).error(),
+              Time::Error::SecondOutOfRange);
+    EXPECT_EQ(Time::UTC::fromComponents(2023, 2, 28, 0, 0, 0, -1).error(),
+              Time::Error::NanoSecondOutOfRange);
+
+    // A failed set leaves the time unchanged
+    Time::UTC utc{"2023-06-15T12:30:45.5"};
+    const auto reference = utc;
+    EXPECT_EQ(utc.trySetYear(2262).error(), Time::Error::YearOutOfRange);
+    EXPECT_EQ(utc.trySetMonthAndDay({0, 1}).error(),
+              Time::Error::MonthOutOfRange);
+    EXPECT_EQ(utc.trySetMonthAndDay({6, 31}).error(),
+              Time::Error::DayOfMonthOutOfRange);
+    EXPECT_EQ(utc.trySetDayOfYear(366).error(),
+              Time::Error::DayOfYearOutOfRange);
+    EXPECT_EQ(utc.trySetHour(-1).error(), Time::Error::HourOutOfRange);
+    EXPECT_EQ(utc.trySetMinute(60).error(), Time::Error::MinuteOutOfRange);
+    EXPECT_EQ(utc.trySetSecond(60).error(), Time::Error::SecondOutOfRange);
+    EXPECT_EQ(utc.trySetMicroSecond(1000000).error(),
+              Time::Error::MicroSecondOutOfRange);
+    EXPECT_EQ(utc.trySetNanoSecond(1000000000).error(),
+              Time::Error::NanoSecondOutOfRange);
+    EXPECT_EQ(utc, reference);
+    EXPECT_EQ(utc.getMonth(), 6);
+
+    EXPECT_TRUE(utc.trySetYear(2024));
+    EXPECT_TRUE(utc.trySetDayOfYear(366));
+    EXPECT_TRUE(utc.trySetHour(1));
+    EXPECT_TRUE(utc.trySetMinute(2));
+    EXPECT_TRUE(utc.trySetSecond(3));
+    EXPECT_TRUE(utc.trySetMicroSecond(4));
+    EXPECT_EQ(utc, Time::UTC{"2024-12-31T01:02:03.000004"});
+    EXPECT_TRUE(utc.trySetMonthAndDay({2, 29}));
+    EXPECT_TRUE(utc.trySetNanoSecond(5));
+    EXPECT_EQ(utc, Time::UTC{"2024-02-29T01:02:03.000000005"});
+}
+
+TEST(UTC, ConcurrentConstReaders)
+{
+    // Shared reference times whose calendar caches are empty
+    const std::vector<Time::UTC> windowStarts{
+        Time::UTC{std::chrono::nanoseconds {1584432093123456789}},
+        Time::UTC{std::chrono::nanoseconds {-1}},
+        Time::UTC{std::chrono::nanoseconds {951868799999999999}}};
+    const std::array<std::array<int, 3>, 3> expected{{{2020, 77, 8},
+                                                      {1969, 365, 23},
+                                                      {2000, 60, 23}}};
+    std::vector<std::thread> threads;
+    std::atomic<int> nFailures{0};
+    for (int i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&, i]()
+        {
+            for (int j = 0; j < 1000; ++j)
+            {
+                auto k = static_cast<size_t> ((i + j) % 3);
+                const auto &time = windowStarts[k];
+                Time::UTC copy{time};
+                if (time.getYear() != expected[k][0] ||
+                    time.getDayOfYear() != expected[k][1] ||
+                    copy.getHour() != expected[k][2] ||
+                    copy != time)
+                {
+                    nFailures.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads){thread.join();}
+    EXPECT_EQ(nFailures.load(), 0);
 }
 
 }
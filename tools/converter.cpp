@@ -0,0 +1,146 @@
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include "converter.hpp"
+#include "time/calendar.hpp"
+#include "time/utc.hpp"
+
+using namespace TimeConv;
+
+namespace
+{
+
+[[nodiscard]] bool isSpace(const char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// Converts a field.
+/// @result A pointer to one past the last written character or nullptr
+///         if the field could not be converted.
+char *convertField(const std::string_view field, const Mode mode,
+                   char *buffer) noexcept
+{
+    if (mode != Mode::ToISO8601)
+    {
+        auto time = Time::UTC::tryParse(field);
+        if (time){return formatEpoch(time->getEpochInNanoSeconds().count(),
+                                     buffer);}
+        if (mode == Mode::ToEpoch){return nullptr;}
+    }
+    int64_t nanoSeconds{0};
+    if (!parseEpoch(field, nanoSeconds)){return nullptr;}
+    return Time::UTC{std::chrono::nanoseconds {nanoSeconds}}.toChars(buffer);
+}
+
+}
+
+/// Parses the seconds since the epoch
+bool TimeConv::parseEpoch(const std::string_view field,
+                          int64_t &nanoSeconds) noexcept
+{
+    const char *first = field.data();
+    const char *last = field.data() + field.size();
+    bool negative{false};
+    if (first != last && (*first == '-' || *first == '+'))
+    {
+        negative = *first == '-';
+        first = first + 1;
+    }
+    if (first == last || *first < '0' || *first > '9'){return false;}
+    int64_t seconds{0};
+    auto [pointer, error] = std::from_chars(first, last, seconds);
+    if (error != std::errc{}){return false;}
+    int64_t fraction{0};
+    if (pointer != last && *pointer == '.')
+    {
+        pointer = pointer + 1;
+        int64_t scale{Time::Calendar::NANOSECONDS_PER_SECOND};
+        for (int i = 0; pointer != last && *pointer >= '0' && *pointer <= '9';
+             ++i, ++pointer)
+        {
+            if (i == 9){return false;}
+            scale = scale/10;
+            fraction = fraction + (*pointer - '0')*scale;
+        }
+    }
+    if (pointer != last){return false;}
+    // Keep the result representable
+    constexpr int64_t maximumSeconds
+        = std::numeric_limits<int64_t>::max()
+         /Time::Calendar::NANOSECONDS_PER_SECOND - 1;
+    if (seconds > maximumSeconds){return false;}
+    auto result = seconds*Time::Calendar::NANOSECONDS_PER_SECOND + fraction;
+    nanoSeconds = negative ? -result : result;
+    return true;
+}
+
+/// Formats the seconds since the epoch
+char *TimeConv::formatEpoch(const int64_t nanoSeconds, char *buffer) noexcept
+{
+    auto microSeconds
+        = Time::Calendar::floorDivide(nanoSeconds,
+                                      Time::Calendar::NANOSECONDS_PER_MICROSECOND);
+    if (microSeconds < 0)
+    {
+        *buffer = '-';
+        buffer = buffer + 1;
+        microSeconds = -microSeconds;
+    }
+    auto [pointer, error] = std::to_chars(buffer, buffer + 20,
+                                          microSeconds/1000000);
+    *pointer = '.';
+    auto fraction = static_cast<int> (microSeconds%1000000);
+    for (int i = 6; i > 0; --i)
+    {
+        pointer[i] = static_cast<char> ('0' + fraction%10);
+        fraction = fraction/10;
+    }
+    return pointer + 7;
+}
+
+/// Converts lines
+Summary TimeConv::convert(const std::string_view input, const Mode mode,
+                          std::string &output)
+{
+    Summary summary;
+    output.reserve(output.size() + input.size() + input.size()/4);
+    char buffer[EPOCH_LENGTH + Time::UTC::ISO8601_LENGTH];
+    size_t position{0};
+    while (position < input.size())
+    {
+        auto end = input.find('\n', position);
+        if (end == std::string_view::npos){end = input.size();}
+        auto line = input.substr(position, end - position);
+        summary.lines = summary.lines + 1;
+        // Leading whitespace then the field
+        size_t fieldStart{0};
+        while (fieldStart < line.size() && isSpace(line[fieldStart]))
+        {
+            fieldStart = fieldStart + 1;
+        }
+        auto fieldEnd = fieldStart;
+        while (fieldEnd < line.size() && !isSpace(line[fieldEnd]))
+        {
+            fieldEnd = fieldEnd + 1;
+        }
+        auto field = line.substr(fieldStart, fieldEnd - fieldStart);
+        char *converted = field.empty() ?
+                          nullptr : ::convertField(field, mode, buffer);
+        if (converted != nullptr)
+        {
+            output.append(line.data(), fieldStart);
+            output.append(buffer, static_cast<size_t> (converted - buffer));
+            output.append(line.substr(fieldEnd));
+        }
+        else
+        {
+            if (!field.empty()){summary.failures = summary.failures + 1;}
+            output.append(line);
+        }
+        if (end < input.size()){output.push_back('\n');}
+        position = end + 1;
+    }
+    return summary;
+}
@@ -0,0 +1,54 @@
+#ifndef TIME_TOOLS_CONVERTER_HPP
+#define TIME_TOOLS_CONVERTER_HPP
+#include <cstdint>
+#include <string>
+#include <string_view>
+/// The line conversions performed by timeconv.  The first whitespace
+/// delimited field of each line is converted and the rest of the line is
+/// copied verbatim, e.g., a pick dump's station and phase columns.
+namespace TimeConv
+{
+/// @brief The direction of the conversion.
+enum class Mode
+{
+    Automatic, /*!< ISO-8601 time stamps become epochs and epochs become
+                    time stamps. */
+    ToISO8601, /*!< Epochs become time stamps. */
+    ToEpoch    /*!< Time stamps become epochs. */
+};
+
+/// @brief The lines processed and the lines whose field was not converted.
+struct Summary
+{
+    uint64_t lines{0};    ///< The number of lines.
+    uint64_t failures{0}; ///< The number of lines copied unconverted.
+};
+
+/// The maximum number of characters written by formatEpoch().
+constexpr size_t EPOCH_LENGTH{32};
+
+/// @brief Parses seconds since the epoch, e.g., -12.5 or 1577836800.000001,
+///        exactly, i.e., without going through a double.
+/// @param[in] field         The decimal seconds with at most 9 fractional
+///                          digits.
+/// @param[out] nanoSeconds  The nanoseconds since the epoch.
+/// @result True indicates the field was parsed.
+[[nodiscard]] bool parseEpoch(std::string_view field,
+                              int64_t &nanoSeconds) noexcept;
+/// @brief Writes seconds since the epoch with six decimals.  The time is
+///        rounded down to the microsecond as is done for time stamps.
+/// @param[in] nanoSeconds  The nanoseconds since the epoch.
+/// @param[out] buffer      Room for at least \c EPOCH_LENGTH characters.
+/// @result A pointer to one past the last written character.
+char *formatEpoch(int64_t nanoSeconds, char *buffer) noexcept;
+
+/// @brief Converts lines of text.
+/// @param[in] input    Whole lines.  The last line need not end with a
+///                     newline.
+/// @param[in] mode     The conversion.
+/// @param[in,out] output  The converted lines are appended to this.
+/// @result The number of lines and failed conversions.  A line that
+///         cannot be converted is copied unchanged.
+Summary convert(std::string_view input, Mode mode, std::string &output);
+}
+#endif
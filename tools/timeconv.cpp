@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "converter.hpp"
+
+/// Converts time stamps and epochs in large files line by line.  The input
+/// is read in chunks that end on a line boundary, the chunks are converted
+/// on worker threads, and the results are written in input order.
+
+namespace
+{
+
+struct Options
+{
+    TimeConv::Mode mode{TimeConv::Mode::Automatic};
+    std::string inputFile;
+    std::string outputFile;
+    size_t chunkSize{8*1024*1024};
+    unsigned int nThreads{std::max(1U, std::thread::hardware_concurrency())};
+    bool quiet{false};
+};
+
+/// The result of converting a chunk.
+struct Chunk
+{
+    std::string output;
+    TimeConv::Summary summary;
+};
+
+/// A fixed number of threads that convert the queued chunks.
+class WorkerPool
+{
+public:
+    explicit WorkerPool(const unsigned int nThreads)
+    {
+        mThreads.reserve(nThreads);
+        for (unsigned int i = 0; i < nThreads; ++i)
+        {
+            mThreads.emplace_back([this]() {work();});
+        }
+    }
+    /// Converts the remaining chunks then joins the threads.
+    ~WorkerPool()
+    {
+        {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = true;
+        }
+        mCondition.notify_all();
+        for (auto &thread : mThreads){thread.join();}
+    }
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    /// @result The converted chunk once a worker is done with it.
+    std::future<Chunk> submit(std::string text, const TimeConv::Mode mode)
+    {
+        std::packaged_task<Chunk()> task(
+            [mode, text = std::move(text)]()
+            {
+                Chunk chunk;
+                chunk.summary = TimeConv::convert(text, mode, chunk.output);
+                return chunk;
+            });
+        auto result = task.get_future();
+        {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTasks.push_back(std::move(task));
+        }
+        mCondition.notify_one();
+        return result;
+    }
+private:
+    void work()
+    {
+        while (true)
+        {
+            std::packaged_task<Chunk()> task;
+            {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() {return mClosed || !mTasks.empty();});
+            if (mTasks.empty()){return;}
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+            }
+            task();
+        }
+    }
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::packaged_task<Chunk()>> mTasks;
+    std::vector<std::thread> mThreads;
+    bool mClosed{false};
+};
+
+void printUsage()
+{
+    std::cerr << "Usage: timeconv [options] [file]\n"
+              << "Converts the first field of each line between epoch seconds\n"
+              << "and ISO-8601 time stamps.  The input is read from the file\n"
+              << "or, if no file is given, from standard input.\n\n"
+              << "Options:\n"
+              << "  --to-iso          Convert epochs to time stamps\n"
+              << "  --to-epoch        Convert time stamps to epochs\n"
+              << "                    (the default converts both ways)\n"
+              << "  --threads N       The number of conversion threads\n"
+              << "                    (default the number of cores)\n"
+              << "  --chunk-size MB   The size of a chunk in MB (default 8)\n"
+              << "  --output FILE     Write to FILE instead of standard output\n"
+              << "  --quiet           Do not report the throughput\n"
+              << "  --help            Show this message\n";
+}
+
+Options parseCommandLine(int argc, char *argv[])
+{
+    Options options;
+    auto getValue = [&](int &i) -> std::string
+    {
+        if (i + 1 >= argc)
+        {
+            throw std::invalid_argument(std::string {argv[i]}
+                                      + " requires a value");
+        }
+        i = i + 1;
+        return argv[i];
+    };
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view argument{argv[i]};
+        if (argument == "--to-iso")
+        {
+            options.mode = TimeConv::Mode::ToISO8601;
+        }
+        else if (argument == "--to-epoch")
+        {
+            options.mode = TimeConv::Mode::ToEpoch;
+        }
+        else if (argument == "--threads")
+        {
+            auto nThreads = std::stoi(getValue(i));
+            if (nThreads < 1)
+            {
+                throw std::invalid_argument("Threads must be positive");
+            }
+            options.nThreads = static_cast<unsigned int> (nThreads);
+        }
+        else if (argument == "--chunk-size")
+        {
+            auto megaBytes = std::stod(getValue(i));
+            if (megaBytes <= 0)
+            {
+                throw std::invalid_argument("Chunk size must be positive");
+            }
+            options.chunkSize
+                = std::max<size_t> (1, static_cast<size_t> (megaBytes*1024*1024));
+        }
+        else if (argument == "--output")
+        {
+            options.outputFile = getValue(i);
+        }
+        else if (argument == "--quiet")
+        {
+            options.quiet = true;
+        }
+        else if (argument == "--help" || argument == "-h")
+        {
+            printUsage();
+            std::exit(EXIT_SUCCESS);
+        }
+        else if (!argument.empty() && argument.front() == '-' &&
+                 argument != "-")
+        {
+            throw std::invalid_argument("Unknown option "
+                                      + std::string {argument});
+        }
+        else if (options.inputFile.empty())
+        {
+            options.inputFile = argument;
+        }
+        else
+        {
+            throw std::invalid_argument("Only one input file is allowed");
+        }
+    }
+    return options;
+}
+
+/// Reads the next chunk.  The chunk ends on a line boundary unless it is
+/// the end of the input.
+/// @param[in,out] carry  On input the partial line left by the previous
+///                       chunk.  On output the partial line that follows
+///                       this chunk.
+/// @result False indicates the input is exhausted.
+bool readChunk(std::FILE *file, const size_t chunkSize,
+               std::string &carry, std::string &chunk)
+{
+    chunk = std::move(carry);
+    carry.clear();
+    auto offset = chunk.size();
+    chunk.resize(std::max(offset + chunkSize, 2*offset));
+    bool endOfFile{false};
+    while (true)
+    {
+        auto nRead = std::fread(chunk.data() + offset, 1,
+                                chunk.size() - offset, file);
+        offset = offset + nRead;
+        if (offset < chunk.size())
+        {
+            if (std::ferror(file))
+            {
+                throw std::runtime_error("Failed to read input");
+            }
+            endOfFile = true;
+            break;
+        }
+        // Ensure a full line is in the chunk
+        if (std::memchr(chunk.data(), '\n', offset) != nullptr){break;}
+        chunk.resize(2*chunk.size());
+    }
+    chunk.resize(offset);
+    if (!endOfFile)
+    {
+        auto lastNewLine = chunk.rfind('\n');
+        carry.assign(chunk, lastNewLine + 1);
+        chunk.resize(lastNewLine + 1);
+    }
+    return !chunk.empty();
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    try
+    {
+        options = parseCommandLine(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "timeconv: " << e.what() << "\n";
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    std::FILE *input = stdin;
+    if (!options.inputFile.empty() && options.inputFile != "-")
+    {
+        input = std::fopen(options.inputFile.c_str(), "rb");
+        if (input == nullptr)
+        {
+            std::cerr << "timeconv: Could not open " << options.inputFile
+                      << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::FILE *output = stdout;
+    if (!options.outputFile.empty())
+    {
+        output = std::fopen(options.outputFile.c_str(), "wb");
+        if (output == nullptr)
+        {
+            std::cerr << "timeconv: Could not create " << options.outputFile
+                      << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    // Keep a few chunks per thread in flight so reading, converting, and
+    // writing overlap while the memory stays bounded
+    auto maximumInFlight = 2*static_cast<size_t> (options.nThreads);
+    std::deque<std::future<Chunk>> inFlight;
+    WorkerPool workers(options.nThreads);
+    TimeConv::Summary summary;
+    uint64_t nBytes{0};
+    bool writeFailed{false};
+    auto writeNext = [&]()
+    {
+        auto chunk = inFlight.front().get();
+        inFlight.pop_front();
+        summary.lines = summary.lines + chunk.summary.lines;
+        summary.failures = summary.failures + chunk.summary.failures;
+        if (std::fwrite(chunk.output.data(), 1, chunk.output.size(), output)
+            != chunk.output.size())
+        {
+            writeFailed = true;
+        }
+    };
+    auto start = std::chrono::steady_clock::now();
+    try
+    {
+        std::string carry;
+        std::string text;
+        while (!writeFailed &&
+               readChunk(input, options.chunkSize, carry, text))
+        {
+            nBytes = nBytes + text.size();
+            inFlight.push_back(workers.submit(std::move(text), options.mode));
+            text = std::string {};
+            if (inFlight.size() >= maximumInFlight){writeNext();}
+        }
+        while (!inFlight.empty()){writeNext();}
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "timeconv: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    if (std::fflush(output) != 0){writeFailed = true;}
+    if (input != stdin){std::fclose(input);}
+    if (output != stdout){std::fclose(output);}
+    if (writeFailed)
+    {
+        std::cerr << "timeconv: Failed to write output\n";
+        return EXIT_FAILURE;
+    }
+    if (!options.quiet)
+    {
+        auto seconds = std::chrono::duration<double>
+                       (std::chrono::steady_clock::now() - start).count();
+        seconds = std::max(seconds, 1.e-9);
+        auto megaBytes = static_cast<double> (nBytes)/(1024.*1024.);
+        char report[256];
+        std::snprintf(report, sizeof(report),
+                      "timeconv: %llu lines (%llu unconverted), %.1f MB in "
+                      "%.3f s: %.1f MB/s, %.0f lines/s\n",
+                      static_cast<unsigned long long> (summary.lines),
+                      static_cast<unsigned long long> (summary.failures),
+                      megaBytes, seconds, megaBytes/seconds,
+                      static_cast<double> (summary.lines)/seconds);
+        std::cerr << report;
+    }
+    return EXIT_SUCCESS;
+}